@@ -14,10 +14,17 @@
 // limitations under the License.
 //*****************************************************************************
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "ngraph/check.hpp"
 #include "ngraph/distributed.hpp"
 #include "ngraph/distributed/mlsl.hpp"
 #include "ngraph/distributed/null.hpp"
 #include "ngraph/distributed/open_mpi.hpp"
+#include "ngraph/distributed/shared_memory.hpp"
+#include "ngraph/env_util.hpp"
 #include "ngraph/log.hpp"
 #include "ngraph/type.hpp"
 
@@ -44,6 +51,26 @@ std::ostream& reduction::operator<<(std::ostream& out, const reduction::Type& ob
     return out << as_string(obj);
 }
 
+namespace
+{
+    class CompletedRequest : public DistributedInterface::Request
+    {
+    public:
+        void wait() override {}
+    };
+}
+
+std::shared_ptr<DistributedInterface::Request>
+    DistributedInterface::all_reduce_start(void* in,
+                                           void* out,
+                                           element::Type_t element_type,
+                                           reduction::Type reduce_type,
+                                           size_t count)
+{
+    all_reduce(in, out, element_type, reduce_type, count);
+    return std::make_shared<CompletedRequest>();
+}
+
 static std::unique_ptr<DistributedInterface> s_distributed_interface;
 
 void ngraph::set_distributed_interface(std::unique_ptr<DistributedInterface> distributed_interface)
@@ -56,6 +83,28 @@ DistributedInterface* ngraph::get_distributed_interface()
 {
     if (nullptr == s_distributed_interface)
     {
+#ifndef _WIN32
+        // Ranks on one host can use shared memory, whichever library is built in
+        int shm_size = getenv_int("NGRAPH_DISTRIBUTED_SHM_SIZE", 0);
+        if (shm_size > 0)
+        {
+            // Every rank would otherwise claim rank 0 and wait for the others forever
+            int shm_rank = getenv_int("NGRAPH_DISTRIBUTED_SHM_RANK", -1);
+            NGRAPH_CHECK(shm_rank >= 0,
+                         "NGRAPH_DISTRIBUTED_SHM_RANK must be set when "
+                         "NGRAPH_DISTRIBUTED_SHM_SIZE is set");
+            // Ranks started by the same launcher share its process id
+            std::string name = getenv_string("NGRAPH_DISTRIBUTED_SHM_NAME");
+            if (name.empty())
+            {
+                name = "ngraph-" + std::to_string(getppid());
+            }
+            set_distributed_interface(std::unique_ptr<DistributedInterface>(
+                new ngraph::distributed::SharedMemoryDistributedInterface(
+                    name, shm_rank, shm_size)));
+            return s_distributed_interface.get();
+        }
+#endif
 #ifdef NGRAPH_DISTRIBUTED_OMPI_ENABLE
         set_distributed_interface(std::unique_ptr<DistributedInterface>(
             new ngraph::distributed::OpenMPIDistributedInterface()));
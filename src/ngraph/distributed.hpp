@@ -53,9 +53,18 @@ namespace ngraph
         const DiscreteTypeInfo& get_type_info() const override { return type_info; }
     };
 
-    class DistributedInterface
+    class NGRAPH_API DistributedInterface
     {
     public:
+        /// \brief A collective that may still be running in the background
+        class Request
+        {
+        public:
+            virtual ~Request() {}
+            /// \brief Block until the collective has completed
+            virtual void wait() = 0;
+        };
+
         virtual ~DistributedInterface() {}
         virtual const std::string& get_name() const = 0;
         virtual int get_size() = 0;
@@ -67,6 +76,15 @@ namespace ngraph
                                 element::Type_t element_type,
                                 reduction::Type reduce_type,
                                 size_t count) = 0;
+        /// \brief Start an all_reduce that may run while the caller goes on with other work.
+        ///        `in` and `out` must stay valid until the request has been waited for, and
+        ///        all ranks must start their collectives in the same order. The default
+        ///        implementation runs the all_reduce before returning.
+        virtual std::shared_ptr<Request> all_reduce_start(void* in,
+                                                          void* out,
+                                                          element::Type_t element_type,
+                                                          reduction::Type reduce_type,
+                                                          size_t count);
         virtual void
             broadcast(void* in, element::Type_t element_type, size_t count, int root_id) = 0;
         virtual void recv(void* in, element::Type_t element_type, size_t count, int src_id) = 0;
@@ -0,0 +1,573 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#ifndef _WIN32
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#include "ngraph/check.hpp"
+#include "ngraph/distributed/shared_memory.hpp"
+#include "ngraph/except.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+static const size_t s_cache_line = 64;
+
+struct alignas(s_cache_line) distributed::SharedMemoryDistributedInterface::Header
+{
+    /// set by rank 0 once the segment is initialized
+    atomic<uint32_t> m_ready;
+    /// set by the rank 0 of a later job that replaces this segment
+    atomic<uint32_t> m_stale;
+    atomic<uint32_t> m_attached;
+    /// set by rank 0 once every rank has attached and the name is removed
+    atomic<uint32_t> m_started;
+    atomic<uint32_t> m_barrier_count;
+    atomic<uint32_t> m_barrier_generation;
+};
+
+/// \brief Point to point messages from a rank go through its slot, one chunk at a time
+struct alignas(s_cache_line) distributed::SharedMemoryDistributedInterface::RankState
+{
+    atomic<uint64_t> m_sent;
+    atomic<uint64_t> m_received;
+    atomic<int32_t> m_dest;
+};
+
+static size_t round_up(size_t size, size_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+template <typename T>
+static void reduce(T* __restrict acc, const T* __restrict arg, size_t count, reduction::Type type)
+{
+    // Plain loops over restrict pointers, which the compiler vectorizes
+    switch (type)
+    {
+    case reduction::Type::SUM:
+        for (size_t i = 0; i < count; ++i)
+        {
+            acc[i] += arg[i];
+        }
+        break;
+    case reduction::Type::PROD:
+        for (size_t i = 0; i < count; ++i)
+        {
+            acc[i] *= arg[i];
+        }
+        break;
+    case reduction::Type::MIN:
+        for (size_t i = 0; i < count; ++i)
+        {
+            acc[i] = arg[i] < acc[i] ? arg[i] : acc[i];
+        }
+        break;
+    case reduction::Type::MAX:
+        for (size_t i = 0; i < count; ++i)
+        {
+            acc[i] = arg[i] > acc[i] ? arg[i] : acc[i];
+        }
+        break;
+    }
+}
+
+distributed::SharedMemoryDistributedInterface::SharedMemoryDistributedInterface(
+    const string& name, int rank, int size, size_t slot_bytes, chrono::milliseconds attach_timeout)
+    : m_segment_name(name.empty() || name[0] != '/' ? "/" + name : name)
+    , m_rank(rank)
+    , m_size(size)
+    , m_slot_bytes(round_up(slot_bytes, s_cache_line))
+    , m_segment(nullptr)
+    , m_unlinked(false)
+{
+    NGRAPH_CHECK(size > 0 && rank >= 0 && rank < size,
+                 "Invalid rank ",
+                 rank,
+                 " of ",
+                 size,
+                 " for shared memory segment ",
+                 m_segment_name);
+    NGRAPH_CHECK(m_slot_bytes > 0, "Shared memory slots must not be empty");
+    m_segment_bytes = sizeof(Header) + size * (sizeof(RankState) + m_slot_bytes);
+
+    auto deadline = chrono::steady_clock::now() + attach_timeout;
+    try
+    {
+        if (rank == 0)
+        {
+            create_segment(deadline);
+        }
+        else
+        {
+            attach_segment(deadline);
+        }
+    }
+    catch (...)
+    {
+        if (m_segment)
+        {
+            munmap(m_segment, m_segment_bytes);
+        }
+        if (rank == 0 && !m_unlinked)
+        {
+            shm_unlink(m_segment_name.c_str());
+        }
+        throw;
+    }
+}
+
+static void check_deadline(chrono::steady_clock::time_point deadline,
+                           const string& segment_name,
+                           const char* waiting_for)
+{
+    if (chrono::steady_clock::now() > deadline)
+    {
+        throw ngraph_error("Timed out waiting for " + string(waiting_for) +
+                           " of shared memory segment " + segment_name);
+    }
+}
+
+void distributed::SharedMemoryDistributedInterface::create_segment(
+    chrono::steady_clock::time_point deadline)
+{
+    // A previous job that didn't start up completely may have left a segment behind, which
+    // ranks of this job may already have attached to. They start over once it is stale.
+    int fd = shm_open(m_segment_name.c_str(), O_RDWR, 0600);
+    if (fd >= 0)
+    {
+        struct stat segment_stat;
+        if (fstat(fd, &segment_stat) == 0 &&
+            static_cast<size_t>(segment_stat.st_size) >= sizeof(Header))
+        {
+            void* stale =
+                mmap(nullptr, sizeof(Header), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (stale != MAP_FAILED)
+            {
+                static_cast<Header*>(stale)->m_stale.store(1, memory_order_release);
+                munmap(stale, sizeof(Header));
+            }
+        }
+        close(fd);
+    }
+    shm_unlink(m_segment_name.c_str());
+
+    fd = shm_open(m_segment_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0 || ftruncate(fd, m_segment_bytes) != 0)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        throw ngraph_error("Failed to create shared memory segment " + m_segment_name + ": " +
+                           strerror(errno));
+    }
+    void* segment = mmap(nullptr, m_segment_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (segment == MAP_FAILED)
+    {
+        throw ngraph_error("Failed to map shared memory segment " + m_segment_name + ": " +
+                           strerror(errno));
+    }
+    m_segment = static_cast<char*>(segment);
+
+    Header& header = get_header();
+    new (&header) Header();
+    for (int i = 0; i < m_size; ++i)
+    {
+        new (&get_rank_state(i)) RankState();
+    }
+    header.m_ready.store(1, memory_order_release);
+    header.m_attached.fetch_add(1, memory_order_acq_rel);
+    while (header.m_attached.load(memory_order_acquire) != static_cast<uint32_t>(m_size))
+    {
+        check_deadline(deadline, m_segment_name, "the other ranks to attach");
+        this_thread::yield();
+    }
+    // Everybody has attached, the segment goes away with the last mapping
+    shm_unlink(m_segment_name.c_str());
+    m_unlinked = true;
+    header.m_started.store(1, memory_order_release);
+}
+
+void distributed::SharedMemoryDistributedInterface::attach_segment(
+    chrono::steady_clock::time_point deadline)
+{
+    while (true)
+    {
+        // Wait for rank 0 to create the segment
+        int fd = shm_open(m_segment_name.c_str(), O_RDWR, 0600);
+        if (fd >= 0)
+        {
+            struct stat segment_stat;
+            if (fstat(fd, &segment_stat) != 0 ||
+                static_cast<size_t>(segment_stat.st_size) != m_segment_bytes)
+            {
+                close(fd);
+                fd = -1;
+            }
+        }
+        if (fd < 0)
+        {
+            check_deadline(deadline, m_segment_name, "rank 0 to create it");
+            this_thread::yield();
+            continue;
+        }
+        void* segment =
+            mmap(nullptr, m_segment_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (segment == MAP_FAILED)
+        {
+            throw ngraph_error("Failed to map shared memory segment " + m_segment_name + ": " +
+                               strerror(errno));
+        }
+        m_segment = static_cast<char*>(segment);
+
+        Header& header = get_header();
+        while (header.m_ready.load(memory_order_acquire) == 0 &&
+               header.m_stale.load(memory_order_acquire) == 0)
+        {
+            check_deadline(deadline, m_segment_name, "rank 0 to initialize it");
+            this_thread::yield();
+        }
+        if (header.m_stale.load(memory_order_acquire) == 0)
+        {
+            header.m_attached.fetch_add(1, memory_order_acq_rel);
+            // Only rank 0 of this job starts the segment, a stale one may never start
+            while (header.m_started.load(memory_order_acquire) == 0 &&
+                   header.m_stale.load(memory_order_acquire) == 0)
+            {
+                check_deadline(deadline, m_segment_name, "the other ranks to attach");
+                this_thread::yield();
+            }
+            if (header.m_started.load(memory_order_acquire) != 0)
+            {
+                return;
+            }
+        }
+        munmap(m_segment, m_segment_bytes);
+        m_segment = nullptr;
+    }
+}
+
+distributed::SharedMemoryDistributedInterface::~SharedMemoryDistributedInterface()
+{
+    if (m_communication_thread.joinable())
+    {
+        {
+            lock_guard<mutex> lock(m_queue_mutex);
+            m_stopping = true;
+        }
+        m_queue_changed.notify_all();
+        m_communication_thread.join();
+    }
+    munmap(m_segment, m_segment_bytes);
+    if (m_rank == 0 && !m_unlinked)
+    {
+        shm_unlink(m_segment_name.c_str());
+    }
+}
+
+distributed::SharedMemoryDistributedInterface::Header&
+    distributed::SharedMemoryDistributedInterface::get_header() const
+{
+    return *reinterpret_cast<Header*>(m_segment);
+}
+
+distributed::SharedMemoryDistributedInterface::RankState&
+    distributed::SharedMemoryDistributedInterface::get_rank_state(int rank) const
+{
+    return reinterpret_cast<RankState*>(m_segment + sizeof(Header))[rank];
+}
+
+char* distributed::SharedMemoryDistributedInterface::get_slot(int rank) const
+{
+    return m_segment + sizeof(Header) + m_size * sizeof(RankState) + rank * m_slot_bytes;
+}
+
+void distributed::SharedMemoryDistributedInterface::log_print(const string& timestamp,
+                                                              const vector<char>& buf)
+{
+    printf("%s [SHM RANK: %d]: %s\n", timestamp.c_str(), m_rank, buf.data());
+}
+
+void distributed::SharedMemoryDistributedInterface::barrier()
+{
+    Header& header = get_header();
+    uint32_t generation = header.m_barrier_generation.load(memory_order_acquire);
+    if (header.m_barrier_count.fetch_add(1, memory_order_acq_rel) + 1 ==
+        static_cast<uint32_t>(m_size))
+    {
+        header.m_barrier_count.store(0, memory_order_relaxed);
+        header.m_barrier_generation.fetch_add(1, memory_order_acq_rel);
+    }
+    else
+    {
+        while (header.m_barrier_generation.load(memory_order_acquire) == generation)
+        {
+            this_thread::yield();
+        }
+    }
+}
+
+template <typename T>
+void distributed::SharedMemoryDistributedInterface::all_reduce(const T* in,
+                                                               T* out,
+                                                               reduction::Type reduce_type,
+                                                               size_t count)
+{
+    size_t chunk = m_slot_bytes / sizeof(T);
+    for (size_t offset = 0; offset < count; offset += chunk)
+    {
+        size_t chunk_count = min(chunk, count - offset);
+        T* slot = reinterpret_cast<T*>(get_slot(m_rank));
+        memcpy(slot, in + offset, chunk_count * sizeof(T));
+        barrier();
+
+        // Reduce-scatter: each rank reduces its share of the chunk over all slots
+        size_t share = (chunk_count + m_size - 1) / m_size;
+        size_t first = min(chunk_count, m_rank * share);
+        size_t last = min(chunk_count, first + share);
+        for (int rank = 0; rank < m_size; ++rank)
+        {
+            if (rank != m_rank)
+            {
+                const T* other = reinterpret_cast<const T*>(get_slot(rank));
+                reduce(slot + first, other + first, last - first, reduce_type);
+            }
+        }
+        barrier();
+
+        // All-gather the reduced shares
+        for (int rank = 0; rank < m_size; ++rank)
+        {
+            size_t rank_first = min(chunk_count, rank * share);
+            size_t rank_last = min(chunk_count, rank_first + share);
+            memcpy(out + offset + rank_first,
+                   reinterpret_cast<const T*>(get_slot(rank)) + rank_first,
+                   (rank_last - rank_first) * sizeof(T));
+        }
+        // The slots are reused by the next chunk
+        barrier();
+    }
+}
+
+void distributed::SharedMemoryDistributedInterface::all_reduce(void* in,
+                                                               void* out,
+                                                               element::Type_t element_type,
+                                                               reduction::Type reduce_type,
+                                                               size_t count)
+{
+    drain();
+    run_all_reduce(in, out, element_type, reduce_type, count);
+}
+
+namespace
+{
+    class FutureRequest : public DistributedInterface::Request
+    {
+    public:
+        FutureRequest(future<void>&& done)
+            : m_done(move(done))
+        {
+        }
+        void wait() override
+        {
+            if (m_done.valid())
+            {
+                m_done.get();
+            }
+        }
+
+    private:
+        future<void> m_done;
+    };
+}
+
+shared_ptr<DistributedInterface::Request>
+    distributed::SharedMemoryDistributedInterface::all_reduce_start(void* in,
+                                                                    void* out,
+                                                                    element::Type_t element_type,
+                                                                    reduction::Type reduce_type,
+                                                                    size_t count)
+{
+    packaged_task<void()> task([this, in, out, element_type, reduce_type, count]() {
+        run_all_reduce(in, out, element_type, reduce_type, count);
+    });
+    auto request = make_shared<FutureRequest>(task.get_future());
+    {
+        lock_guard<mutex> lock(m_queue_mutex);
+        if (!m_communication_thread.joinable())
+        {
+            m_communication_thread = thread(&SharedMemoryDistributedInterface::run_communication,
+                                            this);
+        }
+        m_queue.push_back(move(task));
+        m_pending++;
+    }
+    m_queue_changed.notify_all();
+    return request;
+}
+
+void distributed::SharedMemoryDistributedInterface::run_communication()
+{
+    unique_lock<mutex> lock(m_queue_mutex);
+    while (true)
+    {
+        m_queue_changed.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+        if (m_queue.empty())
+        {
+            return;
+        }
+        packaged_task<void()> task = move(m_queue.front());
+        m_queue.pop_front();
+        lock.unlock();
+        // An exception is passed on to the request's wait
+        task();
+        lock.lock();
+        m_pending--;
+        m_queue_changed.notify_all();
+    }
+}
+
+void distributed::SharedMemoryDistributedInterface::drain()
+{
+    unique_lock<mutex> lock(m_queue_mutex);
+    m_queue_changed.wait(lock, [this]() { return m_pending == 0; });
+}
+
+void distributed::SharedMemoryDistributedInterface::run_all_reduce(void* in,
+                                                                   void* out,
+                                                                   element::Type_t element_type,
+                                                                   reduction::Type reduce_type,
+                                                                   size_t count)
+{
+    switch (element_type)
+    {
+    case element::Type_t::f32:
+        all_reduce(static_cast<float*>(in), static_cast<float*>(out), reduce_type, count);
+        break;
+    case element::Type_t::f64:
+        all_reduce(static_cast<double*>(in), static_cast<double*>(out), reduce_type, count);
+        break;
+    case element::Type_t::i32:
+        all_reduce(static_cast<int32_t*>(in), static_cast<int32_t*>(out), reduce_type, count);
+        break;
+    case element::Type_t::i64:
+        all_reduce(static_cast<int64_t*>(in), static_cast<int64_t*>(out), reduce_type, count);
+        break;
+    default: throw ngraph_error("AllReduce op supports only f32, f64, i32 and i64 types");
+    }
+}
+
+void distributed::SharedMemoryDistributedInterface::broadcast(void* in,
+                                                              element::Type_t element_type,
+                                                              size_t count,
+                                                              int root_id)
+{
+    NGRAPH_CHECK(root_id >= 0 && root_id < m_size, "Invalid broadcast root ", root_id);
+    drain();
+    size_t element_size = element::Type(element_type).size();
+    size_t bytes = count * element_size;
+    size_t chunk = m_slot_bytes / element_size * element_size;
+    char* data = static_cast<char*>(in);
+    for (size_t offset = 0; offset < bytes; offset += chunk)
+    {
+        size_t chunk_bytes = min(chunk, bytes - offset);
+        if (m_rank == root_id)
+        {
+            memcpy(get_slot(root_id), data + offset, chunk_bytes);
+        }
+        barrier();
+        if (m_rank != root_id)
+        {
+            memcpy(data + offset, get_slot(root_id), chunk_bytes);
+        }
+        barrier();
+    }
+}
+
+void distributed::SharedMemoryDistributedInterface::send(const void* in,
+                                                         element::Type_t element_type,
+                                                         size_t count,
+                                                         int dest_id)
+{
+    NGRAPH_CHECK(dest_id >= 0 && dest_id < m_size && dest_id != m_rank,
+                 "Invalid destination ",
+                 dest_id,
+                 " for a send from rank ",
+                 m_rank);
+    drain();
+    RankState& state = get_rank_state(m_rank);
+    size_t bytes = count * element::Type(element_type).size();
+    const char* data = static_cast<const char*>(in);
+    for (size_t offset = 0; offset < bytes; offset += m_slot_bytes)
+    {
+        // Wait until the destination has taken the previous chunk
+        while (state.m_received.load(memory_order_acquire) !=
+               state.m_sent.load(memory_order_relaxed))
+        {
+            this_thread::yield();
+        }
+        memcpy(get_slot(m_rank), data + offset, min(m_slot_bytes, bytes - offset));
+        state.m_dest.store(dest_id, memory_order_relaxed);
+        state.m_sent.fetch_add(1, memory_order_release);
+    }
+    // The slot is free again once the last chunk has been taken
+    while (state.m_received.load(memory_order_acquire) != state.m_sent.load(memory_order_relaxed))
+    {
+        this_thread::yield();
+    }
+}
+
+void distributed::SharedMemoryDistributedInterface::recv(void* in,
+                                                         element::Type_t element_type,
+                                                         size_t count,
+                                                         int src_id)
+{
+    NGRAPH_CHECK(src_id >= 0 && src_id < m_size && src_id != m_rank,
+                 "Invalid source ",
+                 src_id,
+                 " for a receive on rank ",
+                 m_rank);
+    drain();
+    RankState& state = get_rank_state(src_id);
+    size_t bytes = count * element::Type(element_type).size();
+    char* data = static_cast<char*>(in);
+    for (size_t offset = 0; offset < bytes; offset += m_slot_bytes)
+    {
+        while (state.m_sent.load(memory_order_acquire) ==
+                   state.m_received.load(memory_order_relaxed) ||
+               state.m_dest.load(memory_order_relaxed) != m_rank)
+        {
+            this_thread::yield();
+        }
+        memcpy(data + offset, get_slot(src_id), min(m_slot_bytes, bytes - offset));
+        state.m_received.fetch_add(1, memory_order_release);
+    }
+}
+
+#endif
@@ -0,0 +1,136 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "ngraph/distributed.hpp"
+
+#ifndef _WIN32
+
+namespace ngraph
+{
+    namespace distributed
+    {
+        class SharedMemoryDistributedInterface;
+    }
+}
+
+/// \brief Collectives between the ranks of one host, which exchange data through a POSIX
+/// shared memory segment instead of a network library.
+///
+/// Every rank attaches to the segment with the same name; the ranks can be processes or
+/// threads of one process, each with its own interface object. Each rank owns a slot of the
+/// segment. all_reduce copies the input into the slot, reduces one 1/size share of every
+/// slot (reduce-scatter) and then gathers the reduced shares; larger tensors go through the
+/// slots in chunks. Started all_reduces run one after another on a communication thread, the
+/// blocking collectives first wait for them to finish.
+///
+/// Rank 0 creates the segment and removes its name once every rank has attached. A segment of
+/// the same name that an earlier job left behind is marked stale by rank 0 before it is
+/// replaced, and ranks that attached to it start over with the new one.
+class NGRAPH_API ngraph::distributed::SharedMemoryDistributedInterface
+    : public DistributedInterface
+{
+public:
+    /// \param name Name of the shared memory segment, the same for all ranks.
+    /// \param rank This rank, from 0 to size - 1.
+    /// \param size Number of ranks.
+    /// \param slot_bytes Bytes of the segment owned by each rank.
+    /// \param attach_timeout How long to wait for all ranks to attach before throwing
+    ///        ngraph_error.
+    SharedMemoryDistributedInterface(
+        const std::string& name,
+        int rank,
+        int size,
+        size_t slot_bytes = 4 << 20,
+        std::chrono::milliseconds attach_timeout = std::chrono::minutes(1));
+    ~SharedMemoryDistributedInterface() override;
+
+    const std::string& get_name() const override { return m_name; }
+    int get_size() override { return m_size; }
+    int get_rank() override { return m_rank; }
+    void log_print(const std::string& timestamp, const std::vector<char>& buf) override;
+
+    void all_reduce(void* in,
+                    void* out,
+                    element::Type_t element_type,
+                    reduction::Type reduce_type,
+                    size_t count) override;
+    std::shared_ptr<Request> all_reduce_start(void* in,
+                                              void* out,
+                                              element::Type_t element_type,
+                                              reduction::Type reduce_type,
+                                              size_t count) override;
+    void broadcast(void* in, element::Type_t element_type, size_t count, int root_id) override;
+    void recv(void* in, element::Type_t element_type, size_t count, int src_id) override;
+    void send(const void* in, element::Type_t element_type, size_t count, int dest_id) override;
+
+private:
+    struct Header;
+    struct RankState;
+
+    SharedMemoryDistributedInterface(const SharedMemoryDistributedInterface&) = delete;
+    SharedMemoryDistributedInterface& operator=(const SharedMemoryDistributedInterface&) =
+        delete;
+
+    Header& get_header() const;
+    RankState& get_rank_state(int rank) const;
+    /// \brief Create and initialize the segment, and wait for the other ranks to attach
+    void create_segment(std::chrono::steady_clock::time_point deadline);
+    /// \brief Attach to the segment rank 0 created for this job
+    void attach_segment(std::chrono::steady_clock::time_point deadline);
+    char* get_slot(int rank) const;
+    template <typename T>
+    void all_reduce(const T* in, T* out, reduction::Type reduce_type, size_t count);
+    void run_all_reduce(void* in,
+                        void* out,
+                        element::Type_t element_type,
+                        reduction::Type reduce_type,
+                        size_t count);
+    /// \brief Wait until all ranks have reached the barrier.
+    void barrier();
+    /// \brief Wait until the communication thread has run all started collectives
+    void drain();
+    void run_communication();
+
+    std::string m_name{"SharedMemory"};
+    std::string m_segment_name;
+    int m_rank;
+    int m_size;
+    size_t m_slot_bytes;
+    size_t m_segment_bytes;
+    char* m_segment;
+    bool m_unlinked;
+
+    std::thread m_communication_thread;
+    std::mutex m_queue_mutex;
+    std::condition_variable m_queue_changed;
+    std::deque<std::packaged_task<void()>> m_queue;
+    /// collectives queued or running on the communication thread
+    size_t m_pending{0};
+    bool m_stopping{false};
+};
+
+#endif
@@ -20,6 +20,7 @@
 #include <dirent.h>
 #include <ftw.h>
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/time.h>
 #include <unistd.h>
 #endif
@@ -36,6 +37,7 @@
 #include "ngraph/env_util.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/log.hpp"
+#include "ngraph/runtime/aligned_buffer.hpp"
 
 #ifdef _WIN32
 #define RMDIR(a) RemoveDirectoryA(a)
@@ -379,3 +381,32 @@ bool file_util::exists(const string& filename)
     struct stat buffer;
     return (stat(filename.c_str(), &buffer) == 0);
 }
+
+shared_ptr<runtime::AlignedBuffer> file_util::map_file(const string& path)
+{
+    size_t file_size = get_file_size(path);
+    if (file_size == 0)
+    {
+        return make_shared<runtime::AlignedBuffer>();
+    }
+#ifdef _WIN32
+    auto buffer = make_shared<runtime::AlignedBuffer>(file_size, 4096);
+    vector<char> data = read_file_contents(path);
+    memcpy(buffer->get_ptr(), data.data(), file_size);
+    return buffer;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw runtime_error("error opening file '" + path + "'");
+    }
+    void* data = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        throw runtime_error("error mapping file '" + path + "'");
+    }
+    shared_ptr<void> mapping(data, [file_size](void* p) { munmap(p, file_size); });
+    return make_shared<runtime::AlignedBuffer>(data, file_size, mapping);
+#endif
+}
@@ -17,11 +17,17 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace ngraph
 {
+    namespace runtime
+    {
+        class AlignedBuffer;
+    }
+
     namespace file_util
     {
         /// \brief Returns the name with extension for a given path
@@ -95,5 +101,13 @@ namespace ngraph
         /// \param path The path to test
         /// \return true if the path exists, false otherwise
         bool exists(const std::string& path);
+
+        /// \brief Maps a whole file into memory, copy-on-write: writes to the buffer are
+        ///        private and never reach the file. Pages are read in on first access, so only
+        ///        the parts that are used occupy memory. Where mapping is not available the
+        ///        file is read into an allocated buffer instead.
+        /// \param path The file to map
+        /// \return A page-aligned buffer; the file stays mapped until it is destroyed.
+        std::shared_ptr<runtime::AlignedBuffer> map_file(const std::string& path);
     }
 }
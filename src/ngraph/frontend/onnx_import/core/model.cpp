@@ -17,6 +17,7 @@
 #include <onnx/onnx_pb.h>
 
 #include "model.hpp"
+#include "ngraph/file_util.hpp"
 #include "ngraph/log.hpp"
 #include "ops_bridge.hpp"
 
@@ -24,8 +25,9 @@ namespace ngraph
 {
     namespace onnx_import
     {
-        Model::Model(const onnx::ModelProto& model_proto)
+        Model::Model(const onnx::ModelProto& model_proto, const std::string& model_dir)
             : m_model_proto{&model_proto}
+            , m_model_dir{model_dir}
         {
             // Walk through the elements of opset_import field and register operator sets
             // for each domain. An exception UnknownDomain() will raise if the domain is
@@ -92,6 +94,23 @@ namespace ngraph
             }
         }
 
+        std::shared_ptr<runtime::AlignedBuffer>
+            Model::map_external_data_file(const std::string& location)
+        {
+            auto it = m_external_data_files.find(location);
+            if (it == std::end(m_external_data_files))
+            {
+                std::string path =
+                    m_model_dir.empty() ? location : file_util::path_join(m_model_dir, location);
+                if (!file_util::exists(path))
+                {
+                    throw ngraph_error{"external data file not found: " + path};
+                }
+                it = m_external_data_files.emplace(location, file_util::map_file(path)).first;
+            }
+            return it->second;
+        }
+
     } // namespace onnx_import
 
 } // namespace ngraph
@@ -16,11 +16,14 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
 #include <onnx/onnx_pb.h>
 #include <ostream>
 #include <string>
 #include <unordered_map>
 
+#include "ngraph/runtime/aligned_buffer.hpp"
 #include "operator_set.hpp"
 
 namespace ngraph
@@ -31,7 +34,9 @@ namespace ngraph
         {
         public:
             Model() = delete;
-            explicit Model(const onnx::ModelProto& model_proto);
+            /// \param model_proto The model.
+            /// \param model_dir   Directory that external tensor data locations are relative to.
+            explicit Model(const onnx::ModelProto& model_proto, const std::string& model_dir = "");
 
             Model(const Model&) = default;
             Model(Model&&) = default;
@@ -72,9 +77,23 @@ namespace ngraph
             ///
             void enable_opset_domain(const std::string& domain);
 
+            /// \brief      Map a file holding external tensor data into memory.
+            ///
+            /// \note       Each file is mapped once, the tensors stored in it refer to the
+            ///             mapping and keep it alive.
+            ///
+            /// \param[in]  location  The path of the file, relative to the model's directory.
+            ///
+            /// \return     The contents of the file.
+            ///
+            std::shared_ptr<runtime::AlignedBuffer>
+                map_external_data_file(const std::string& location);
+
         private:
             const onnx::ModelProto* m_model_proto;
             std::unordered_map<std::string, OperatorSet> m_opset;
+            std::string m_model_dir;
+            std::map<std::string, std::shared_ptr<runtime::AlignedBuffer>> m_external_data_files;
         };
 
         inline std::ostream& operator<<(std::ostream& outs, const Model& model)
@@ -16,10 +16,13 @@
 
 #pragma once
 
+#include <cstdint>
+#include <cstring>
 #include <onnx/onnx_pb.h>
 #include <utility>
 #include <vector>
 
+#include "model.hpp"
 #include "ngraph/op/constant.hpp"
 #include "ngraph/shape.hpp"
 #include "ngraph/type/element_type.hpp"
@@ -90,6 +93,14 @@ namespace ngraph
                     {
                     }
                 };
+
+                struct invalid_external_data : ngraph_error
+                {
+                    explicit invalid_external_data(const std::string& reason)
+                        : ngraph_error{"invalid external data: " + reason}
+                    {
+                    }
+                };
             }
         }
 
@@ -361,8 +372,11 @@ namespace ngraph
             };
 
             Tensor() = delete;
-            explicit Tensor(const onnx::TensorProto& tensor)
+            /// \param tensor The tensor.
+            /// \param model  The model the tensor belongs to, needed to load external data.
+            explicit Tensor(const onnx::TensorProto& tensor, Model* model = nullptr)
                 : m_tensor_proto{&tensor}
+                , m_model{model}
                 , m_shape{std::begin(tensor.dims()), std::end(tensor.dims())}
             {
                 if (m_shape == Shape{0})
@@ -388,9 +402,23 @@ namespace ngraph
                 {
                     throw error::tensor::segments_unsupported{};
                 }
+                if (has_external_data())
+                {
+                    // External data is stored in the tensor's own type, like raw_data
+                    auto data = get_external_data();
+                    std::vector<T> values(data->size() / sizeof(T));
+                    std::memcpy(values.data(), data->get_ptr(), values.size() * sizeof(T));
+                    return values;
+                }
                 return detail::tensor::get_data<T>(*m_tensor_proto);
             }
 
+            bool has_external_data() const
+            {
+                return m_tensor_proto->data_location() ==
+                       onnx::TensorProto_DataLocation::TensorProto_DataLocation_EXTERNAL;
+            }
+
             const std::string& get_name() const
             {
                 if (!m_tensor_proto->has_name())
@@ -438,6 +466,30 @@ namespace ngraph
             operator TensorProto_DataType() const { return m_tensor_proto->data_type(); }
             std::shared_ptr<ngraph::op::Constant> get_ng_constant() const
             {
+                if (m_tensor_proto->has_segment())
+                {
+                    throw error::tensor::segments_unsupported{};
+                }
+                if (has_external_data())
+                {
+                    const element::Type& type = get_ng_type();
+                    auto data = get_external_data();
+                    if (reinterpret_cast<std::uintptr_t>(data->get_ptr()) % type.size() == 0)
+                    {
+                        // The constant refers to the mapped file, nothing is copied
+                        return std::make_shared<ngraph::op::Constant>(type, m_shape, data);
+                    }
+                    return std::make_shared<ngraph::op::Constant>(
+                        type, m_shape, static_cast<const void*>(data->get_ptr()));
+                }
+                if (m_tensor_proto->has_raw_data() &&
+                    m_tensor_proto->raw_data().size() ==
+                        shape_size(m_shape) * get_ng_type().size())
+                {
+                    // Copy the bytes straight into the constant instead of through a vector
+                    return std::make_shared<ngraph::op::Constant>(
+                        get_ng_type(), m_shape, m_tensor_proto->raw_data().data());
+                }
                 switch (m_tensor_proto->data_type())
                 {
                 case onnx::TensorProto_DataType::TensorProto_DataType_BOOL:
@@ -475,7 +527,52 @@ namespace ngraph
                 return std::make_shared<ngraph::op::Constant>(type, m_shape, get_data<T>());
             }
 
+            /// \brief The bytes of a tensor with external data, referring to the mapped file
+            ///        that holds them.
+            std::shared_ptr<runtime::AlignedBuffer> get_external_data() const
+            {
+                if (m_model == nullptr)
+                {
+                    throw error::tensor::invalid_external_data{
+                        "tensor is not an initializer of a model"};
+                }
+                std::string location;
+                std::size_t offset = 0;
+                std::size_t length = shape_size(m_shape) * get_ng_type().size();
+                for (const auto& entry : m_tensor_proto->external_data())
+                {
+                    if (entry.key() == "location")
+                    {
+                        location = entry.value();
+                    }
+                    else if (entry.key() == "offset")
+                    {
+                        offset = std::stoull(entry.value());
+                    }
+                    else if (entry.key() == "length" &&
+                             std::stoull(entry.value()) != length)
+                    {
+                        throw error::tensor::invalid_external_data{
+                            "length of '" + get_name() + "' doesn't match its shape"};
+                    }
+                }
+                if (location.empty())
+                {
+                    throw error::tensor::invalid_external_data{"no location for '" + get_name() +
+                                                               "'"};
+                }
+                auto file = m_model->map_external_data_file(location);
+                if (offset > file->size() || length > file->size() - offset)
+                {
+                    throw error::tensor::invalid_external_data{
+                        "data of '" + get_name() + "' is past the end of " + location};
+                }
+                return std::make_shared<runtime::AlignedBuffer>(
+                    file->get_ptr(offset), length, file);
+            }
+
             const onnx::TensorProto* m_tensor_proto;
+            Model* m_model;
             Shape m_shape;
         };
 
@@ -14,7 +14,7 @@
 // limitations under the License.
 //*****************************************************************************
 
-#include <fstream>
+#include <climits>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/text_format.h>
 #include <memory>
@@ -22,6 +22,7 @@
 #include "core/graph.hpp"
 #include "core/model.hpp"
 #include "ngraph/except.hpp"
+#include "ngraph/file_util.hpp"
 #include "onnx.hpp"
 #include "ops_bridge.hpp"
 
@@ -49,8 +50,31 @@ namespace ngraph
                     }
                 };
 
+                struct file_parse : ngraph_error
+                {
+                    explicit file_parse(const std::string& path)
+                        : ngraph_error{"Failure parsing data from file: " + path}
+                    {
+                    }
+                };
+
             } // namespace error
-        }     // namespace detail
+
+            std::shared_ptr<Function> convert_to_ng_function(const onnx::ModelProto& model_proto,
+                                                             const std::string& model_dir)
+            {
+                Model model{model_proto, model_dir};
+                Graph graph{model_proto.graph(), model};
+                auto function = std::make_shared<Function>(
+                    graph.get_ng_outputs(), graph.get_ng_parameters(), graph.get_name());
+                for (std::size_t i{0}; i < function->get_output_size(); ++i)
+                {
+                    function->get_output_op(i)->set_friendly_name(
+                        graph.get_outputs().at(i).get_name());
+                }
+                return function;
+            }
+        } // namespace detail
 
         std::shared_ptr<Function> import_onnx_model(std::istream& sin)
         {
@@ -69,25 +93,38 @@ namespace ngraph
                 }
             }
 
-            Model model{model_proto};
-            Graph graph{model_proto.graph(), model};
-            auto function = std::make_shared<Function>(
-                graph.get_ng_outputs(), graph.get_ng_parameters(), graph.get_name());
-            for (std::size_t i{0}; i < function->get_output_size(); ++i)
-            {
-                function->get_output_op(i)->set_friendly_name(graph.get_outputs().at(i).get_name());
-            }
-            return function;
+            return detail::convert_to_ng_function(model_proto, "");
         }
 
         std::shared_ptr<Function> import_onnx_model(const std::string& path)
         {
-            std::ifstream ifs{path, std::ios::in | std::ios::binary};
-            if (!ifs.is_open())
+            if (!file_util::exists(path))
             {
                 throw detail::error::file_open{path};
             }
-            return import_onnx_model(ifs);
+            // Parse straight from the mapped file instead of reading it through a stream
+            auto file = file_util::map_file(path);
+            if (file->size() > INT_MAX)
+            {
+                throw ngraph_error{"Model file " + path +
+                                   " is over 2GB, its weights must be stored as external data"};
+            }
+            int size = static_cast<int>(file->size());
+            onnx::ModelProto model_proto;
+            // Try parsing input as a binary protobuf message
+            if (!model_proto.ParseFromArray(file->get_ptr(), size))
+            {
+                // Try parsing input as a prototxt message
+                google::protobuf::io::ArrayInputStream array_stream(file->get_ptr(), size);
+                if (!google::protobuf::TextFormat::Parse(&array_stream, &model_proto))
+                {
+                    throw detail::error::file_parse{path};
+                }
+            }
+            // External data locations are relative to the directory of the model file
+            std::string model_dir =
+                path.find_last_of('/') == std::string::npos ? "" : file_util::get_directory(path);
+            return detail::convert_to_ng_function(model_proto, model_dir);
         }
 
         void register_operator(const std::string& name,
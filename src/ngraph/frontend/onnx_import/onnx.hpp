@@ -69,6 +69,7 @@ namespace ngraph
         /// \brief Convert an ONNX model to nGraph function
         /// The function translated serialized ONNX model to nGraph function. The serialized
         /// ONNX model is read from input stream.
+        /// External tensor data is looked up relative to the current working directory.
         /// \param sin       input stream (e.g. file stream, memory stream, etc)
         /// \return The function returns a nGraph function representing single output from graph.
         NGRAPH_API
@@ -76,7 +77,8 @@ namespace ngraph
 
         /// \brief Convert an ONNX model to nGraph functions
         /// The function translated serialized ONNX model to nGraph functions. The ONNX model
-        /// is read from ONNX file.
+        /// is read from ONNX file. Initializers stored as external data are mapped from their
+        /// files relative to the model's directory and the constants refer to the mapped bytes.
         /// \param filename  file name (relative or absolute path name)
         /// \return The function returns a nGraph function representing single output from graph.
         NGRAPH_API
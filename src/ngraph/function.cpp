@@ -101,6 +101,20 @@ void Function::init()
 
 std::vector<shared_ptr<Node>> Function::get_ordered_ops(bool include_control_deps) const
 {
+    size_t graph_version = get_graph_version();
+    lock_guard<mutex> guard(m_ordered_ops_mutex);
+    OrderedOps& cached = m_ordered_ops[include_control_deps ? 1 : 0];
+    if (cached.m_valid && cached.m_graph_version == graph_version)
+    {
+        vector<shared_ptr<Node>> result;
+        result.reserve(cached.m_nodes.size());
+        for (Node* node : cached.m_nodes)
+        {
+            result.push_back(node->shared_from_this());
+        }
+        return result;
+    }
+
     vector<shared_ptr<Node>> nodes;
     for (auto& r : get_results())
     {
@@ -111,7 +125,20 @@ std::vector<shared_ptr<Node>> Function::get_ordered_ops(bool include_control_dep
         nodes.push_back(param);
     }
 
-    return m_topological_sorter(nodes, include_control_deps);
+    vector<shared_ptr<Node>> result = m_topological_sorter(nodes, include_control_deps);
+    cached.m_nodes.clear();
+    for (auto& node : result)
+    {
+        cached.m_nodes.push_back(node.get());
+    }
+    cached.m_graph_version = graph_version;
+    cached.m_valid = true;
+    return result;
+}
+
+size_t Function::get_graph_version() const
+{
+    return Node::get_graph_version() + m_version.load();
 }
 
 void Function::map_unordered_ops(std::function<void(Node*)> f) const
@@ -297,9 +324,11 @@ void Function::replace_parameter(size_t parameter_index, const shared_ptr<op::Pa
                  " parameters.");
     replace_node(m_parameters[parameter_index], parameter);
     m_parameters[parameter_index] = parameter;
+    m_version++;
 }
 
 void Function::set_topological_sort(topological_sort_t sorter)
 {
     m_topological_sorter = sorter;
+    m_version++;
 }
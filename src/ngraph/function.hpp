@@ -20,6 +20,7 @@
 #include <initializer_list>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -93,7 +94,13 @@ namespace ngraph
         const std::string& get_friendly_name() const;
 
         std::vector<std::shared_ptr<Node>> get_ops(bool include_control_deps = true) const;
+        /// \brief Returns the nodes of the function in topological order.
+        ///
+        /// The order is computed once and reused until get_graph_version() changes.
         std::vector<std::shared_ptr<Node>> get_ordered_ops(bool include_control_deps = true) const;
+        /// \brief A number that changes whenever the result of get_ordered_ops() may change,
+        ///        i.e. when an edge of any graph or the parameters of this function change.
+        size_t get_graph_version() const;
         void map_unordered_ops(std::function<void(Node*)> f) const;
 
         friend std::ostream& operator<<(std::ostream&, const Function&);
@@ -144,5 +151,18 @@ namespace ngraph
         const std::string m_unique_name;
         size_t m_placement{0};
         topological_sort_t m_topological_sorter;
+
+        // Changes to this function that do not change the edges of its graph.
+        std::atomic<size_t> m_version{0};
+        struct OrderedOps
+        {
+            bool m_valid = false;
+            size_t m_graph_version = 0;
+            // The nodes are kept alive by the graph for as long as the graph version is unchanged.
+            std::vector<Node*> m_nodes;
+        };
+        mutable std::mutex m_ordered_ops_mutex;
+        // Without and with control dependencies.
+        mutable OrderedOps m_ordered_ops[2];
     };
 }
@@ -34,6 +34,7 @@ using namespace std;
 using namespace ngraph;
 
 atomic<size_t> Node::m_next_instance_id(0);
+atomic<size_t> Node::m_graph_version(0);
 
 Node::Node(size_t output_size)
     : Node()
@@ -193,6 +194,14 @@ void Node::set_arguments(const NodeVector& arguments)
 
 void Node::set_arguments(const OutputVector& arguments)
 {
+    // A node under construction is not part of any function yet, so building nodes leaves the
+    // cached orders alone.
+    bool connected = !m_inputs.empty();
+    for (const descriptor::Output& output : m_outputs)
+    {
+        connected = connected || !output.get_inputs().empty();
+    }
+
     // Add this node as a user of each argument.
     size_t i = 0;
     for (auto& output : arguments)
@@ -201,6 +210,10 @@ void Node::set_arguments(const OutputVector& arguments)
         auto& output_descriptor = output_node->get_outputs().at(output.get_index());
         m_inputs.emplace_back(this, i++, output_descriptor);
     }
+    if (connected)
+    {
+        graph_changed();
+    }
 }
 
 descriptor::Input& Node::get_input_descriptor(size_t position)
@@ -540,6 +553,11 @@ NodeVector Node::get_arguments() const
     return result;
 }
 
+size_t Node::get_graph_version()
+{
+    return m_graph_version.load();
+}
+
 const std::vector<std::shared_ptr<Node>>& Node::get_control_dependencies() const
 {
     return m_control_dependencies;
@@ -556,6 +574,7 @@ void Node::add_control_dependency(std::shared_ptr<Node> node)
         m_control_dependencies.end())
     {
         m_control_dependencies.push_back(node);
+        graph_changed();
         if (find(node->m_control_dependents.begin(), node->m_control_dependents.end(), this) ==
             node->m_control_dependents.end())
         {
@@ -593,6 +612,7 @@ void Node::remove_control_dependency(std::shared_ptr<Node> node)
         if (it != m_control_dependencies.end())
         {
             m_control_dependencies.erase(it);
+            graph_changed();
         }
     }
     {
@@ -615,6 +635,7 @@ void Node::clear_control_dependencies()
         }
     }
     m_control_dependencies.clear();
+    graph_changed();
 }
 
 void Node::clear_control_dependents()
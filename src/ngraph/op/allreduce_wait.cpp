@@ -0,0 +1,46 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include "ngraph/op/allreduce_wait.hpp"
+#include "ngraph/op/allreduce_start.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+constexpr NodeTypeInfo op::AllReduceWait::type_info;
+
+op::AllReduceWait::AllReduceWait(const Output<Node>& start)
+    : Op({start})
+{
+    constructor_validate_and_infer_types();
+}
+
+void op::AllReduceWait::validate_and_infer_types()
+{
+    NODE_VALIDATION_CHECK(this,
+                          is_type<op::AllReduceStart>(input_value(0).get_node()),
+                          "Argument must be the output of an AllReduceStart (got ",
+                          input_value(0).get_node()->description(),
+                          ").");
+
+    set_output_type(0, get_input_element_type(0), get_input_partial_shape(0));
+}
+
+shared_ptr<Node> op::AllReduceWait::copy_with_new_args(const NodeVector& new_args) const
+{
+    check_new_args_count(this, new_args);
+    return make_shared<AllReduceWait>(new_args.at(0));
+}
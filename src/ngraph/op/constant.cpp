@@ -299,6 +299,19 @@ op::Constant::Constant(const element::Type& type, const Shape& shape, const void
     m_all_elements_bitwise_identical = are_all_data_elements_bitwise_identical();
 }
 
+op::Constant::Constant(const element::Type& type,
+                       const Shape& shape,
+                       shared_ptr<runtime::AlignedBuffer> data)
+    : m_element_type(type)
+    , m_shape(shape)
+    , m_data(move(data))
+{
+    NGRAPH_CHECK(m_data && m_data->size() >= shape_size(m_shape) * m_element_type.size(),
+                 "Constant buffer is smaller than its shape requires");
+    constructor_validate_and_infer_types();
+    m_all_elements_bitwise_identical = are_all_data_elements_bitwise_identical();
+}
+
 op::Constant::Constant(const Constant& other)
     : m_element_type(other.m_element_type)
     , m_shape(other.m_shape)
@@ -93,6 +93,17 @@ namespace ngraph
                 /// \param data A void* to constant data.
                 Constant(const element::Type& type, const Shape& shape, const void* data);
 
+                /// \brief Constructs a tensor constant that uses the supplied buffer as its
+                ///        data, without copying it.
+                ///
+                /// \param type The element type of the tensor constant.
+                /// \param shape The shape of the tensor constant.
+                /// \param data A buffer of at least shape_size(shape) * type.size() bytes,
+                ///        which must not be modified while the constant exists.
+                Constant(const element::Type& type,
+                         const Shape& shape,
+                         std::shared_ptr<runtime::AlignedBuffer> data);
+
                 Constant(const Constant& other);
 
                 virtual ~Constant() override;
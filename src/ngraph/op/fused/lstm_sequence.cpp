@@ -18,6 +18,7 @@
 #include "ngraph/builder/reshape.hpp"
 #include "ngraph/builder/split.hpp"
 #include "ngraph/frontend/onnx_import/utils/reshape.hpp"
+#include "ngraph/op/broadcast.hpp"
 #include "ngraph/op/concat.hpp"
 #include "ngraph/op/constant.hpp"
 #include "ngraph/op/fused/lstm_cell.hpp"
@@ -25,6 +26,7 @@
 #include "ngraph/op/greater.hpp"
 #include "ngraph/op/reverse_sequence.hpp"
 #include "ngraph/op/select.hpp"
+#include "ngraph/op/tensor_iterator.hpp"
 #include "ngraph/op/util/broadcasting.hpp"
 
 using namespace ngraph;
@@ -32,16 +34,27 @@ using namespace std;
 
 constexpr NodeTypeInfo op::LSTMSequence::type_info;
 NodeVector op::LSTMSequence::decompose_op() const
+{
+    return decompose(false);
+}
+
+NodeVector op::LSTMSequence::decompose_to_tensor_iterator() const
+{
+    return decompose(true);
+}
+
+NodeVector op::LSTMSequence::decompose(bool as_loop) const
 {
     NodeVector results;
     if (m_direction == direction::FORWARD || m_direction == direction::REVERSE)
     {
-        results = lstm_pass(m_direction == direction::REVERSE);
+        bool is_reverse = m_direction == direction::REVERSE;
+        results = as_loop ? lstm_loop(is_reverse) : lstm_pass(is_reverse);
     }
     if (m_direction == direction::BIDIRECTIONAL)
     {
-        NodeVector fwd_results{lstm_pass()};
-        NodeVector rev_results{lstm_pass(true)};
+        NodeVector fwd_results{as_loop ? lstm_loop() : lstm_pass()};
+        NodeVector rev_results{as_loop ? lstm_loop(true) : lstm_pass(true)};
 
         // Stack together respective outputs from both forward and reverse passess.
         shared_ptr<Node> Y{
@@ -235,6 +248,103 @@ NodeVector op::LSTMSequence::lstm_pass(bool is_reverse) const
     return {Y, Y_h, Y_c};
 }
 
+NodeVector op::LSTMSequence::lstm_loop(bool is_reverse) const
+{
+    // Variable names follow lstm_pass. The body runs one LSTMCell step on X_i, the slice of X
+    // at the current time step.
+    shared_ptr<Node> X = input_value(0).get_node_shared_ptr();
+    shared_ptr<Node> H_t = prepare_input(input_value(1), is_reverse);
+    shared_ptr<Node> C_t = prepare_input(input_value(2), is_reverse);
+    shared_ptr<Node> seq_lengths = input_value(3).get_node_shared_ptr();
+    shared_ptr<Node> W = prepare_input(input_value(4), is_reverse);
+    shared_ptr<Node> R = prepare_input(input_value(5), is_reverse);
+    shared_ptr<Node> B = prepare_input(input_value(6), is_reverse);
+    shared_ptr<Node> P = prepare_input(input_value(7), is_reverse);
+
+    if (is_reverse)
+    {
+        X = make_shared<op::ReverseSequence>(X, seq_lengths, 1 /*batch_axis*/, 0 /*seq_axis*/);
+    }
+
+    const Shape& x_shape = X->get_shape();
+    size_t seq_length = x_shape.at(0);
+    size_t batch_size = x_shape.at(1);
+    const Shape& state_shape = H_t->get_shape();
+
+    // Batches whose sequence is shorter than the time step are masked like in lstm_pass. The
+    // condition is computed for all time steps up front and sliced along with X.
+    vector<int64_t> time_steps;
+    for (size_t time_step = 1; time_step <= seq_length; ++time_step)
+    {
+        time_steps.insert(time_steps.end(), batch_size, static_cast<int64_t>(time_step));
+    }
+    Shape mask_shape{seq_length, batch_size};
+    shared_ptr<Node> mask = make_shared<op::Greater>(
+        op::Constant::create(seq_lengths->get_element_type(), mask_shape, time_steps),
+        make_shared<op::Broadcast>(seq_lengths, mask_shape, AxisSet{0}));
+
+    auto X_i = make_shared<op::Parameter>(X->get_element_type(),
+                                          Shape{1, batch_size, x_shape.at(2)});
+    auto mask_i = make_shared<op::Parameter>(element::boolean, Shape{1, batch_size});
+    auto H_i = make_shared<op::Parameter>(H_t->get_element_type(), state_shape);
+    auto C_i = make_shared<op::Parameter>(C_t->get_element_type(), state_shape);
+    auto W_i = make_shared<op::Parameter>(W->get_element_type(), W->get_shape());
+    auto R_i = make_shared<op::Parameter>(R->get_element_type(), R->get_shape());
+    auto B_i = make_shared<op::Parameter>(B->get_element_type(), B->get_shape());
+    auto P_i = make_shared<op::Parameter>(P->get_element_type(), P->get_shape());
+
+    shared_ptr<Node> lstm_cell = make_shared<op::LSTMCell>(builder::squeeze(X_i),
+                                                           H_i,
+                                                           C_i,
+                                                           W_i,
+                                                           R_i,
+                                                           B_i,
+                                                           P_i,
+                                                           m_hidden_size,
+                                                           m_weights_format,
+                                                           m_activations,
+                                                           m_activations_alpha,
+                                                           m_activations_beta,
+                                                           m_clip_threshold,
+                                                           m_input_forget);
+    shared_ptr<Node> step_mask =
+        make_shared<op::Broadcast>(builder::squeeze(mask_i), state_shape, AxisSet{1});
+    shared_ptr<Node> zero = op::Constant::create(
+        H_t->get_element_type(), state_shape, vector<float>(shape_size(state_shape), 0.f));
+    // Masked batches output zeros and keep their previous state
+    shared_ptr<Node> H_o = make_shared<op::Select>(step_mask, H_i, lstm_cell->output(0));
+    shared_ptr<Node> C_o = make_shared<op::Select>(step_mask, C_i, lstm_cell->output(1));
+    shared_ptr<Node> Y_o =
+        builder::expand_dims(make_shared<op::Select>(step_mask, zero, lstm_cell->output(0)));
+
+    auto body = make_shared<op::TensorIterator::BodyLambda>(
+        OutputVector{H_o, C_o, Y_o}, ParameterVector{X_i, mask_i, H_i, C_i, W_i, R_i, B_i, P_i});
+    auto tensor_iterator = make_shared<op::TensorIterator>();
+    tensor_iterator->set_body(body);
+    // start=0, stride=1, part_size=1, end=-1, axis=0
+    tensor_iterator->set_sliced_input(X_i, X, 0, 1, 1, -1, 0);
+    tensor_iterator->set_sliced_input(mask_i, mask, 0, 1, 1, -1, 0);
+    tensor_iterator->set_merged_input(H_i, H_t, H_o);
+    tensor_iterator->set_merged_input(C_i, C_t, C_o);
+    tensor_iterator->set_invariant_input(W_i, W);
+    tensor_iterator->set_invariant_input(R_i, R);
+    tensor_iterator->set_invariant_input(B_i, B);
+    tensor_iterator->set_invariant_input(P_i, P);
+    // [seq_length, batch_size, hidden_size]
+    Output<Node> Y = tensor_iterator->get_concatenated_slices(Y_o, 0, 1, 1, -1, 0);
+    Output<Node> Y_h = tensor_iterator->get_iter_value(H_o, -1);
+    Output<Node> Y_c = tensor_iterator->get_iter_value(C_o, -1);
+    tensor_iterator->revalidate_and_infer_types();
+
+    if (is_reverse)
+    {
+        Y = make_shared<op::ReverseSequence>(Y, seq_lengths, 1 /*batch_axis*/, 0 /*seq_axis*/);
+    }
+
+    // Same output shapes as lstm_pass
+    return {builder::expand_dims(Y, 1), builder::expand_dims(Y_h), builder::expand_dims(Y_c)};
+}
+
 shared_ptr<Node> op::LSTMSequence::prepare_input(Output<Node> node, bool is_reverse) const
 {
     // In bidirectional mode inputs are stacked together, so we must split them.
@@ -137,6 +137,16 @@ namespace ngraph
 
                 virtual NodeVector decompose_op() const override;
 
+                ///
+                /// \brief      Decomposes the sequence like decompose_op, but runs the
+                ///             recurrence in a TensorIterator over an LSTMCell body instead of
+                ///             unrolling it, so the graph size doesn't grow with the sequence
+                ///             length.
+                ///
+                /// \return     The Y, Y_h and Y_c values.
+                ///
+                NodeVector decompose_to_tensor_iterator() const;
+
                 virtual std::shared_ptr<Node>
                     copy_with_new_args(const NodeVector& new_args) const override;
 
@@ -168,8 +178,12 @@ namespace ngraph
                                     std::size_t batch_axis = 0,
                                     const Output<Node>& default_value = Output<Node>()) const;
 
+                NodeVector decompose(bool as_loop) const;
+
                 NodeVector lstm_pass(bool is_reverse = false) const;
 
+                NodeVector lstm_loop(bool is_reverse = false) const;
+
                 // Split(bi-directional) and squeeze input data to remove 'num_direction' dimension.
                 std::shared_ptr<Node> prepare_input(Output<Node> node, bool is_reverse) const;
 
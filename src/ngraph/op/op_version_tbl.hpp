@@ -32,6 +32,8 @@ NGRAPH_OP(Add, ngraph::op::v0, 0)
 NGRAPH_OP(Add, ngraph::op::v1, 1)
 NGRAPH_OP(All, ngraph::op::v0, 0)
 NGRAPH_OP(AllReduce, ngraph::op::v0, 0)
+NGRAPH_OP(AllReduceStart, ngraph::op::v0, 0)
+NGRAPH_OP(AllReduceWait, ngraph::op::v0, 0)
 NGRAPH_OP(And, ngraph::op::v0, 0)
 NGRAPH_OP(Any, ngraph::op, 0)
 NGRAPH_OP(ArgMax, ngraph::op::v0, 0)
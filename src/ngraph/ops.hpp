@@ -23,6 +23,8 @@
 #include "ngraph/op/add.hpp"
 #include "ngraph/op/all.hpp"
 #include "ngraph/op/allreduce.hpp"
+#include "ngraph/op/allreduce_start.hpp"
+#include "ngraph/op/allreduce_wait.hpp"
 #include "ngraph/op/and.hpp"
 #include "ngraph/op/any.hpp"
 #include "ngraph/op/argmax.hpp"
@@ -55,6 +55,8 @@ NGRAPH_OP(Acos, ngraph::op)
 NGRAPH_OP(Add, ngraph::op)
 NGRAPH_OP(All, ngraph::op)
 NGRAPH_OP(AllReduce, ngraph::op)
+NGRAPH_OP(AllReduceStart, ngraph::op)
+NGRAPH_OP(AllReduceWait, ngraph::op)
 NGRAPH_OP(And, ngraph::op)
 NGRAPH_OP(Any, ngraph::op)
 NGRAPH_OP(ArgMax, ngraph::op)
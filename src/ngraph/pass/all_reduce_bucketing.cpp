@@ -0,0 +1,199 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <map>
+#include <unordered_set>
+
+#include "ngraph/graph_util.hpp"
+#include "ngraph/op/allreduce.hpp"
+#include "ngraph/op/allreduce_start.hpp"
+#include "ngraph/op/allreduce_wait.hpp"
+#include "ngraph/op/concat.hpp"
+#include "ngraph/op/reshape.hpp"
+#include "ngraph/op/slice.hpp"
+#include "ngraph/pass/all_reduce_bucketing.hpp"
+#include "ngraph/util.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace
+{
+    struct Bucket
+    {
+        vector<shared_ptr<op::AllReduce>> members;
+        size_t bytes{0};
+        size_t last_index{0};
+    };
+
+    bool depends_on(Node* node, const Node* target)
+    {
+        unordered_set<Node*> visited;
+        vector<Node*> stack{node};
+        while (!stack.empty())
+        {
+            Node* current = stack.back();
+            stack.pop_back();
+            if (current == target)
+            {
+                return true;
+            }
+            if (!visited.insert(current).second)
+            {
+                continue;
+            }
+            for (size_t i = 0; i < current->get_input_size(); ++i)
+            {
+                stack.push_back(current->get_input_node_ptr(i));
+            }
+            for (auto& dependency : current->get_control_dependencies())
+            {
+                stack.push_back(dependency.get());
+            }
+        }
+        return false;
+    }
+
+    shared_ptr<Node> flatten(const Output<Node>& value)
+    {
+        const Shape& shape = value.get_shape();
+        return make_shared<op::Reshape>(
+            value, get_default_order(shape), Shape{shape_size(shape)});
+    }
+}
+
+bool pass::AllReduceBucketing::run_on_function(shared_ptr<Function> f)
+{
+    // Buckets are closed when an AllReduce depends on one already bucketed, which keeps every
+    // bucket free of dependencies between its members and between the open buckets
+    map<pair<element::Type_t, reduction::Type>, Bucket> open_buckets;
+    vector<Bucket> buckets;
+    unordered_set<Node*> dependents;
+    auto close_all = [&]() {
+        for (auto& open_bucket : open_buckets)
+        {
+            buckets.push_back(move(open_bucket.second));
+        }
+        open_buckets.clear();
+        dependents.clear();
+    };
+
+    size_t index = 0;
+    for (auto node : f->get_ordered_ops())
+    {
+        ++index;
+        bool dependent = false;
+        for (size_t i = 0; i < node->get_input_size() && !dependent; ++i)
+        {
+            dependent = dependents.count(node->get_input_node_ptr(i)) != 0;
+        }
+        for (auto& dependency : node->get_control_dependencies())
+        {
+            dependent = dependent || dependents.count(dependency.get()) != 0;
+        }
+
+        auto all_reduce = as_type_ptr<op::AllReduce>(node);
+        if (!all_reduce || node->get_input_partial_shape(0).is_dynamic() ||
+            node->get_input_element_type(0).is_dynamic())
+        {
+            if (dependent)
+            {
+                dependents.insert(node.get());
+            }
+            continue;
+        }
+
+        if (dependent)
+        {
+            close_all();
+        }
+        element::Type type = node->get_input_element_type(0);
+        size_t bytes = shape_size(node->get_input_shape(0)) * type.size();
+        auto key = make_pair(static_cast<element::Type_t>(type), all_reduce->get_reduce_type());
+        auto it = open_buckets.find(key);
+        if (it != open_buckets.end() && it->second.bytes + bytes > m_bucket_size)
+        {
+            buckets.push_back(move(it->second));
+            open_buckets.erase(it);
+            it = open_buckets.end();
+        }
+        Bucket& bucket = open_buckets[key];
+        bucket.members.push_back(all_reduce);
+        bucket.bytes += bytes;
+        bucket.last_index = index;
+        dependents.insert(node.get());
+    }
+    close_all();
+
+    if (buckets.empty())
+    {
+        return false;
+    }
+    // Start each bucket where its last AllReduce would have run
+    stable_sort(buckets.begin(), buckets.end(), [](const Bucket& a, const Bucket& b) {
+        return a.last_index < b.last_index;
+    });
+
+    vector<shared_ptr<Node>> starts;
+    vector<shared_ptr<Node>> waits;
+    for (const Bucket& bucket : buckets)
+    {
+        reduction::Type reduce_type = bucket.members.front()->get_reduce_type();
+        if (bucket.members.size() == 1)
+        {
+            auto& member = bucket.members.front();
+            auto start = make_shared<op::AllReduceStart>(member->input_value(0), reduce_type);
+            auto wait = make_shared<op::AllReduceWait>(start);
+            replace_node(member, wait);
+            starts.push_back(start);
+            waits.push_back(wait);
+            continue;
+        }
+
+        OutputVector flat_members;
+        for (auto& member : bucket.members)
+        {
+            flat_members.push_back(flatten(member->input_value(0)));
+        }
+        auto start = make_shared<op::AllReduceStart>(make_shared<op::Concat>(flat_members, 0),
+                                                     reduce_type);
+        auto wait = make_shared<op::AllReduceWait>(start);
+        size_t offset = 0;
+        for (auto& member : bucket.members)
+        {
+            const Shape& shape = member->get_input_shape(0);
+            size_t size = shape_size(shape);
+            auto slice =
+                make_shared<op::Slice>(wait, Coordinate{offset}, Coordinate{offset + size});
+            replace_node(member, make_shared<op::Reshape>(slice, AxisVector{0}, shape));
+            offset += size;
+        }
+        starts.push_back(start);
+        waits.push_back(wait);
+    }
+
+    // Waiting only after the next bucket has started lets a bucket's communication overlap the
+    // computation of the next one
+    for (size_t i = 0; i + 1 < buckets.size(); ++i)
+    {
+        if (!depends_on(starts[i + 1].get(), waits[i].get()))
+        {
+            waits[i]->add_control_dependency(starts[i + 1]);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,48 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include "ngraph/pass/pass.hpp"
+
+namespace ngraph
+{
+    namespace pass
+    {
+        class AllReduceBucketing;
+    }
+}
+
+/// \brief Fuses AllReduce ops into a few large asynchronous all-reduces.
+///
+/// AllReduce ops with the same element type and reduction are gathered, in execution order,
+/// into buckets of at most `bucket_size` bytes. Each bucket is flattened and concatenated into
+/// one AllReduceStart, whose AllReduceWait is sliced back into the original tensors. A bucket
+/// is only waited for once the next bucket has been started, so its communication overlaps
+/// the computation that produces the next bucket's gradients.
+class NGRAPH_API ngraph::pass::AllReduceBucketing : public FunctionPass
+{
+public:
+    AllReduceBucketing(size_t bucket_size = 25 * 1024 * 1024)
+        : m_bucket_size(bucket_size)
+    {
+    }
+
+    bool run_on_function(std::shared_ptr<Function> f) override;
+
+private:
+    size_t m_bucket_size;
+};
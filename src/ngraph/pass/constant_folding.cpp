@@ -14,7 +14,15 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <unordered_map>
+
 #include "constant_folding.hpp"
+#include "ngraph/env_util.hpp"
+#include "ngraph/op/constant.hpp"
+#include "ngraph/op/result.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -31,3 +39,267 @@ bool ngraph::pass::revalidate_and_ensure_static(shared_ptr<Node> n)
     }
     return true;
 }
+
+void pass::ConstantFolding::configure_from_environment()
+{
+    m_num_threads =
+        static_cast<size_t>(max(getenv_int("NGRAPH_CONSTANT_FOLDING_THREADS", 1), 0));
+    m_max_folded_bytes =
+        static_cast<size_t>(max(getenv_int("NGRAPH_CONSTANT_FOLDING_MAX_BYTES", 0), 0));
+}
+
+void pass::ConstantFolding::add_matcher(const shared_ptr<pattern::Matcher>& m,
+                                        const graph_rewrite_callback& callback,
+                                        const PassPropertyMask& property)
+{
+    auto limited_callback = [this, callback](pattern::Matcher& matcher) {
+        if (exceeds_max_folded_bytes(*matcher.get_match_root()))
+        {
+            NGRAPH_DEBUG << "Not folding " << matcher.get_match_root()->get_name()
+                         << ", its outputs exceed " << m_max_folded_bytes << " bytes";
+            return false;
+        }
+        return callback(matcher);
+    };
+    GraphRewrite::add_matcher(m, limited_callback, property);
+}
+
+void pass::ConstantFolding::add_matcher(const shared_ptr<pattern::Matcher>& m,
+                                        const graph_rewrite_callback& callback)
+{
+    add_matcher(m, callback, {PassProperty::REQUIRE_STATIC_SHAPE});
+}
+
+bool pass::ConstantFolding::exceeds_max_folded_bytes(const Node& node) const
+{
+    if (m_max_folded_bytes == 0)
+    {
+        return false;
+    }
+    size_t bytes = 0;
+    for (auto& output : node.outputs())
+    {
+        // Outputs whose size is only known after folding are not limited
+        if (output.get_partial_shape().is_static() && output.get_element_type().is_static())
+        {
+            bytes += shape_size(output.get_shape()) * output.get_element_type().size();
+        }
+    }
+    return bytes > m_max_folded_bytes;
+}
+
+shared_ptr<pass::ConstantFolding> pass::ConstantFolding::make_sequential_copy() const
+{
+    auto copy = m_all_transformations ? make_shared<ConstantFolding>(m_cfmap)
+                                      : make_shared<ConstantFolding>(m_transformations, m_cfmap);
+    copy->set_num_threads(1);
+    copy->set_max_folded_bytes(m_max_folded_bytes);
+    return copy;
+}
+
+bool pass::ConstantFolding::run_on_function(shared_ptr<Function> f)
+{
+    bool folded = false;
+    if (m_num_threads != 1)
+    {
+        folded = fold_constant_subgraphs(f);
+    }
+    // Also catches what the subgraphs miss, such as ShapeOf of a non-constant with a static
+    // shape, and anything that can only be folded once its neighbours are.
+    return GraphRewrite::run_on_function(f) || folded;
+}
+
+// A node can be computed from constants alone if all of its arguments are constants or can be.
+// Such nodes are grouped into the connected components they form without the constants, the
+// components are spread over the threads, and every thread folds a private copy of its nodes
+// with a sequential ConstantFolding. Constants are shared between the copies without copying
+// their data, and the graph itself is only modified on the calling thread.
+bool pass::ConstantFolding::fold_constant_subgraphs(const shared_ptr<Function>& f)
+{
+    vector<Node*> nodes;
+    unordered_map<Node*, size_t> node_index;
+    vector<size_t> parent;
+    auto find_root = [&parent](size_t i) {
+        while (parent[i] != i)
+        {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    for (auto& node : f->get_ordered_ops())
+    {
+        if (is_type<op::Constant>(node) || node->is_parameter() || node->is_output() ||
+            node->has_state() || node->get_output_size() == 0 || node->get_input_size() == 0 ||
+            !node->get_control_dependencies().empty() || !node->get_control_dependents().empty())
+        {
+            continue;
+        }
+        vector<size_t> arguments;
+        bool computable = true;
+        for (auto& input : node->inputs())
+        {
+            Node* source = input.get_source_output().get_node();
+            auto it = node_index.find(source);
+            if (it != node_index.end())
+            {
+                arguments.push_back(it->second);
+            }
+            else if (!is_type<op::Constant>(source))
+            {
+                computable = false;
+                break;
+            }
+        }
+        if (!computable)
+        {
+            continue;
+        }
+        size_t index = nodes.size();
+        nodes.push_back(node.get());
+        node_index[node.get()] = index;
+        parent.push_back(index);
+        for (size_t argument : arguments)
+        {
+            parent[find_root(argument)] = find_root(index);
+        }
+    }
+    if (nodes.empty())
+    {
+        return false;
+    }
+
+    // Largest components first, each to the thread with the fewest nodes so far
+    unordered_map<size_t, size_t> component_size;
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+        component_size[find_root(i)]++;
+    }
+    vector<pair<size_t, size_t>> components(component_size.begin(), component_size.end());
+    sort(components.begin(),
+         components.end(),
+         [](const pair<size_t, size_t>& a, const pair<size_t, size_t>& b) {
+             return a.second > b.second || (a.second == b.second && a.first < b.first);
+         });
+    size_t thread_count = m_num_threads == 0 ? max(thread::hardware_concurrency(), 1u)
+                                             : m_num_threads;
+    thread_count = min(thread_count, components.size());
+    vector<size_t> load(thread_count, 0);
+    unordered_map<size_t, size_t> component_thread;
+    for (auto& component : components)
+    {
+        size_t thread_index = min_element(load.begin(), load.end()) - load.begin();
+        load[thread_index] += component.second;
+        component_thread[component.first] = thread_index;
+    }
+    vector<vector<Node*>> work(thread_count);
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+        work[component_thread[find_root(i)]].push_back(nodes[i]);
+    }
+
+    // For every thread, pairs of an output of the graph and the constant that replaces it
+    vector<vector<pair<Output<Node>, Output<Node>>>> replacements(thread_count);
+    vector<exception_ptr> errors(thread_count);
+    auto fold = [this, &work, &node_index, &replacements, &errors](size_t thread_index) {
+        try
+        {
+            unordered_map<Node*, shared_ptr<Node>> copies;
+            unordered_map<Node*, shared_ptr<Node>> originals;
+            OutputVector copied_outputs;
+            vector<Output<Node>> original_outputs;
+            for (Node* node : work[thread_index])
+            {
+                OutputVector arguments;
+                for (auto& input : node->inputs())
+                {
+                    Output<Node> source = input.get_source_output();
+                    auto& copy = copies[source.get_node()];
+                    if (!copy)
+                    {
+                        // The copy shares the buffer of the constant
+                        copy = make_shared<op::Constant>(
+                            *static_cast<op::Constant*>(source.get_node()));
+                        originals[copy.get()] = source.get_node_shared_ptr();
+                    }
+                    arguments.push_back(copy->output(source.get_index()));
+                }
+                auto copy = node->copy_with_new_inputs(arguments, NodeVector{});
+                copies[node] = copy;
+                // Only the values used outside the component are kept until the end; the
+                // intermediate ones are freed as soon as the values after them are folded.
+                for (size_t i = 0; i < node->get_output_size(); i++)
+                {
+                    for (auto& target : node->output(i).get_target_inputs())
+                    {
+                        if (node_index.count(target.get_node()) == 0)
+                        {
+                            copied_outputs.push_back(copy->output(i));
+                            original_outputs.push_back(node->output(i));
+                            break;
+                        }
+                    }
+                }
+            }
+            if (copied_outputs.empty())
+            {
+                return;
+            }
+
+            auto copied_function = make_shared<Function>(copied_outputs, ParameterVector{});
+            make_sequential_copy()->run_on_function(copied_function);
+
+            auto& results = copied_function->get_results();
+            for (size_t i = 0; i < results.size(); i++)
+            {
+                Output<Node> value = results[i]->input_value(0);
+                if (!is_type<op::Constant>(value.get_node()))
+                {
+                    continue;
+                }
+                auto original = originals.find(value.get_node());
+                if (original != originals.end())
+                {
+                    value = original->second->output(value.get_index());
+                }
+                replacements[thread_index].push_back({original_outputs[i], value});
+            }
+        }
+        catch (...)
+        {
+            errors[thread_index] = current_exception();
+        }
+    };
+
+    vector<thread> threads;
+    for (size_t i = 1; i < thread_count; i++)
+    {
+        threads.emplace_back(fold, i);
+    }
+    fold(0);
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    for (auto& error : errors)
+    {
+        if (error)
+        {
+            rethrow_exception(error);
+        }
+    }
+
+    bool folded = false;
+    for (auto& thread_replacements : replacements)
+    {
+        for (auto& replacement : thread_replacements)
+        {
+            for (auto& input : replacement.first.get_target_inputs())
+            {
+                input.replace_source_output(replacement.second);
+                folded = true;
+            }
+        }
+    }
+    return folded;
+}
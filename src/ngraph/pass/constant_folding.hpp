@@ -69,6 +69,8 @@ public:
     {
         m_cfmap = cfmap;
         m_enable_shape_inference = true;
+        m_all_transformations = true;
+        configure_from_environment();
 
         construct_constant_split();
         construct_constant_variadic_split();
@@ -106,6 +108,8 @@ public:
         : GraphRewrite()
     {
         m_cfmap = cfmap;
+        m_transformations = transformations;
+        configure_from_environment();
         for (auto cft : transformations)
         {
             switch (cft)
@@ -145,7 +149,33 @@ public:
         }
     }
 
+    /// \brief Sets the number of threads used to fold independent constant subgraphs.
+    ///
+    /// With more than one thread, every maximal subgraph computed only from constants is
+    /// folded on a private copy of its nodes, the copies are folded concurrently and the
+    /// results are spliced back into the graph before the usual pass over the whole graph.
+    /// Handlers in the folding map are then called from several threads. 0 uses one thread
+    /// per hardware thread. Defaults to NGRAPH_CONSTANT_FOLDING_THREADS, or 1.
+    void set_num_threads(size_t num_threads) { m_num_threads = num_threads; }
+    /// \brief Leaves a node unfolded when its outputs would take more than `max_bytes` bytes,
+    /// so that e.g. broadcasts of small constants to huge shapes are not materialized. 0 means
+    /// no limit. Defaults to NGRAPH_CONSTANT_FOLDING_MAX_BYTES, or 0.
+    void set_max_folded_bytes(size_t max_bytes) { m_max_folded_bytes = max_bytes; }
+    virtual bool run_on_function(std::shared_ptr<ngraph::Function> f) override;
+
+    // Hide the GraphRewrite versions so that every folding callback honors the size limit
+    void add_matcher(const std::shared_ptr<pattern::Matcher>& m,
+                     const ngraph::graph_rewrite_callback& callback,
+                     const PassPropertyMask& property);
+    void add_matcher(const std::shared_ptr<pattern::Matcher>& m,
+                     const ngraph::graph_rewrite_callback& callback);
+
 private:
+    void configure_from_environment();
+    bool exceeds_max_folded_bytes(const Node& node) const;
+    bool fold_constant_subgraphs(const std::shared_ptr<Function>& f);
+    std::shared_ptr<ConstantFolding> make_sequential_copy() const;
+
     void construct_constant_reshape();
     void construct_constant_broadcast();
     void construct_constant_dyn_broadcast();
@@ -175,4 +205,8 @@ private:
     void construct_constant_one_hot();
 
     ngraph::BuildNodeExecutorMap m_cfmap;
+    bool m_all_transformations = false;
+    std::vector<CFTransformations> m_transformations;
+    size_t m_num_threads = 1;
+    size_t m_max_folded_bytes = 0;
 };
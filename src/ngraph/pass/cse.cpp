@@ -14,12 +14,15 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <cstring>
 #include <memory>
 #include <set>
+#include <sstream>
 #include <typeinfo>
 #include <unordered_map>
 
 #include "cse.hpp"
+#include "ngraph/attribute_visitor.hpp"
 #include "ngraph/axis_vector.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/log.hpp"
@@ -27,10 +30,14 @@
 #include "ngraph/op/abs.hpp"
 #include "ngraph/op/acos.hpp"
 #include "ngraph/op/add.hpp"
+#include "ngraph/op/allreduce.hpp"
+#include "ngraph/op/allreduce_start.hpp"
+#include "ngraph/op/allreduce_wait.hpp"
 #include "ngraph/op/asin.hpp"
 #include "ngraph/op/atan.hpp"
 #include "ngraph/op/atan2.hpp"
 #include "ngraph/op/broadcast.hpp"
+#include "ngraph/op/broadcast_distributed.hpp"
 #include "ngraph/op/ceiling.hpp"
 #include "ngraph/op/constant.hpp"
 #include "ngraph/op/cos.hpp"
@@ -210,6 +217,104 @@ static unordered_map<type_index, function<bool(shared_ptr<Node>, shared_ptr<Node
 static unordered_map<type_index, function<bool(shared_ptr<Node>, shared_ptr<Node>)>>
     ops_to_cse_handlers = initialize_ops_to_cse_handlers();
 
+namespace
+{
+    // Writes the attributes of a node to a string, so that the attributes of two nodes of the
+    // same type can be hashed and compared. Incomplete if the node does not visit its attributes
+    // or has an attribute of a type the fingerprint does not know.
+    class AttributeFingerprint : public AttributeVisitor
+    {
+    public:
+        AttributeFingerprint(Node& node)
+        {
+            m_complete = node.visit_attributes(*this) && m_complete;
+        }
+        bool is_complete() const { return m_complete; }
+        const string& get() const { return m_fingerprint; }
+        void on_attribute(const string& name, string& value) override { add(name, value); }
+        void on_attribute(const string& name, bool& value) override
+        {
+            add(name, value ? "true" : "false");
+        }
+        void on_adapter(const string& name, ValueAccessor<void>& adapter) override
+        {
+            stringstream value;
+            if (auto type = as_type<AttributeAdapter<element::Type>>(&adapter))
+            {
+                value << static_cast<element::Type&>(*type);
+            }
+            else if (auto shape = as_type<AttributeAdapter<PartialShape>>(&adapter))
+            {
+                value << static_cast<PartialShape&>(*shape);
+            }
+            else if (auto autob = as_type<AttributeAdapter<op::AutoBroadcastSpec>>(&adapter))
+            {
+                const op::AutoBroadcastSpec& spec = *autob;
+                value << static_cast<int>(spec.m_type) << "," << spec.m_axis;
+            }
+            else
+            {
+                m_complete = false;
+            }
+            add(name, value.str());
+        }
+        void on_adapter(const string& name, ValueAccessor<string>& adapter) override
+        {
+            add(name, adapter.get());
+        }
+        void on_adapter(const string& name, ValueAccessor<vector<int64_t>>& adapter) override
+        {
+            stringstream value;
+            for (int64_t v : adapter.get())
+            {
+                value << v << ",";
+            }
+            add(name, value.str());
+        }
+        void on_adapter(const string& name, ValueAccessor<int64_t>& adapter) override
+        {
+            add(name, to_string(adapter.get()));
+        }
+        void on_adapter(const string& name, ValueAccessor<double>& adapter) override
+        {
+            // Bitwise, so that -0.0 and 0.0 differ
+            double value = adapter.get();
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            add(name, to_string(bits));
+        }
+
+    private:
+        void add(const string& name, const string& value)
+        {
+            m_fingerprint.append(name).append("=").append(value).append(";");
+        }
+
+        string m_fingerprint;
+        bool m_complete = true;
+    };
+}
+
+static size_t hash_bytes(const void* data, size_t size)
+{
+    // FNV-1a over 64-bit words with a xorshift, as in runtime::CacheKey.
+    const char* bytes = static_cast<const char*>(data);
+    uint64_t hash = 0xcbf29ce484222325;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * 0x100000001b3;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; i++)
+    {
+        hash = (hash ^ static_cast<unsigned char>(bytes[i])) * 0x100000001b3;
+    }
+    return static_cast<size_t>(hash);
+}
+
 class NodeKey
 {
 public:
@@ -221,36 +326,120 @@ public:
         , m_ti(TI(m_node_ref))
         , m_backend_handlers(backend_handlers)
     {
+        AttributeFingerprint attributes(m_node_ref);
+        m_attributes = attributes.get();
+        m_has_attributes = attributes.is_complete();
+        // Nodes with state, ordering constraints or communication stay distinct unless a
+        // handler says otherwise.
+        m_generic = m_has_attributes && !n->has_state() && m_node_ref.get_output_size() > 0 &&
+                    n->get_control_dependencies().empty() &&
+                    n->get_control_dependents().empty() && !is_type<op::AllReduce>(n) &&
+                    !is_type<op::AllReduceStart>(n) && !is_type<op::AllReduceWait>(n) &&
+                    !is_type<op::BroadcastDistributed>(n);
+        m_hash = compute_hash();
     }
 
     shared_ptr<Node> get_node() const { return m_node; }
+    size_t get_hash() const { return m_hash; }
     bool operator==(const NodeKey& other) const
     {
-        if (m_ti == other.m_ti)
+        if (m_ti != other.m_ti || m_hash != other.m_hash)
         {
-            auto eh = ops_to_cse_handlers.find(m_ti);
-            if (eh != ops_to_cse_handlers.end())
-            {
-                return eh->second(m_node, other.m_node);
-            }
+            return false;
+        }
+        // Handlers written before attributes could be visited do not compare all of them.
+        bool same_attributes = !m_has_attributes || !other.m_has_attributes ||
+                               m_attributes == other.m_attributes;
+
+        auto eh = ops_to_cse_handlers.find(m_ti);
+        if (eh != ops_to_cse_handlers.end())
+        {
+            return same_attributes && eh->second(m_node, other.m_node);
+        }
+
+        eh = m_backend_handlers.find(m_ti);
+        if (eh != m_backend_handlers.end())
+        {
+            return same_attributes && eh->second(m_node, other.m_node);
+        }
+
+        return m_generic && other.m_generic && same_attributes && same_values(other);
+    }
 
-            eh = m_backend_handlers.find(m_ti);
-            if (eh != m_backend_handlers.end())
+private:
+    // The generic comparison: same arguments and same output types.
+    bool same_values(const NodeKey& other) const
+    {
+        Node& a = m_node_ref;
+        Node& b = *other.m_node;
+        if (a.get_output_size() != b.get_output_size() || get_args() != other.get_args())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.get_output_size(); i++)
+        {
+            if (a.get_output_element_type(i) != b.get_output_element_type(i) ||
+                !a.get_output_partial_shape(i).same_scheme(b.get_output_partial_shape(i)))
             {
-                return eh->second(m_node, other.m_node);
+                return false;
             }
         }
+        return true;
+    }
 
-        return false;
+    vector<Output<Node>> get_args() const
+    {
+        vector<Output<Node>> args;
+        for (auto input : m_node->inputs())
+        {
+            args.push_back(input.get_source_output());
+        }
+        // TODO: Do we need another map, so we could
+        // specify how to compute hash for each op?
+        if (m_node->is_commutative())
+        {
+            sort(begin(args), end(args));
+        }
+        return args;
+    }
+
+    size_t compute_hash() const
+    {
+        vector<size_t> arg_ids;
+        arg_ids.push_back(hash<type_index>()(m_ti));
+        for (auto arg : get_args())
+        {
+            arg_ids.push_back(arg.get_node_shared_ptr()->get_instance_id());
+            arg_ids.push_back(arg.get_index());
+        }
+        if (m_has_attributes)
+        {
+            arg_ids.push_back(hash<string>()(m_attributes));
+        }
+        if (auto constant = as_type_ptr<op::Constant>(m_node))
+        {
+            arg_ids.push_back(hash<string>()(constant->get_element_type().c_type_string()));
+            arg_ids.push_back(hash_combine(constant->get_shape()));
+            size_t size = constant->get_all_data_elements_bitwise_identical()
+                              ? constant->get_element_type().size()
+                              : shape_size(constant->get_shape()) *
+                                    constant->get_element_type().size();
+            arg_ids.push_back(hash_bytes(constant->get_data_ptr(), size));
+        }
+        return hash_combine(arg_ids);
     }
 
-private:
     shared_ptr<Node> m_node;
     // m_node_ref is only to allow getting the type_index in the ctor
     Node& m_node_ref;
     std::type_index m_ti;
     unordered_map<type_index, function<bool(shared_ptr<Node>, shared_ptr<Node>)>>&
         m_backend_handlers;
+    string m_attributes;
+    bool m_has_attributes;
+    // Whether the node may be merged with an equal node of a type without a handler.
+    bool m_generic;
+    size_t m_hash;
 };
 
 namespace std
@@ -258,40 +447,7 @@ namespace std
     template <>
     struct hash<NodeKey>
     {
-        size_t operator()(const NodeKey& k) const
-        {
-            Node& p_this = *k.get_node().get();
-            auto ti = TI(p_this);
-
-            hash<type_index> type_hash_compute{};
-            auto type_hash = type_hash_compute(ti);
-
-            vector<size_t> arg_ids;
-
-            arg_ids.push_back(type_hash);
-
-            std::vector<Output<Node>> cargs;
-            for (auto input : k.get_node()->inputs())
-            {
-                cargs.push_back(input.get_source_output());
-            }
-
-            // TODO: Do we need another map, so we could
-            // specify how to compute hash for each op?
-            if (p_this.is_commutative())
-            {
-                sort(begin(cargs), end(cargs));
-            }
-
-            for (auto arg : cargs)
-            {
-                arg_ids.push_back(arg.get_node_shared_ptr()->get_instance_id());
-                arg_ids.push_back(arg.get_index());
-            }
-
-            auto hashc = ngraph::hash_combine(arg_ids);
-            return hashc;
-        }
+        size_t operator()(const NodeKey& k) const { return k.get_hash(); }
     };
 }
 
@@ -0,0 +1,176 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "ngraph/graph_util.hpp"
+#include "ngraph/op/broadcast.hpp"
+#include "ngraph/op/convert.hpp"
+#include "ngraph/op/experimental/compiled_kernel.hpp"
+#include "ngraph/op/not.hpp"
+#include "ngraph/op/select.hpp"
+#include "ngraph/pass/elementwise_fusion.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+bool pass::ElementwiseFusion::is_fusible(const Node& node)
+{
+    if (node.get_output_size() != 1 || node.get_output_partial_shape(0).is_dynamic() ||
+        node.get_output_element_type(0).is_dynamic() ||
+        !node.get_control_dependencies().empty() || !node.get_control_dependents().empty())
+    {
+        return false;
+    }
+    if (is_type<op::v0::Broadcast>(&node))
+    {
+        // Fused broadcasts load elements of these sizes only
+        size_t element_size = node.get_output_element_type(0).size();
+        return node.get_input_partial_shape(0).is_static() &&
+               (element_size == 1 || element_size == 2 || element_size == 4 || element_size == 8);
+    }
+    if (!node.is_unary_elementwise_arithmetic() && !node.is_binary_elementwise_arithmetic() &&
+        !node.is_binary_elementwise_comparison() && !node.is_binary_elementwise_logical() &&
+        !is_type<op::v0::Convert>(&node) && !is_type<op::v0::Not>(&node) &&
+        !is_type<op::v0::Select>(&node))
+    {
+        return false;
+    }
+    // Implicitly broadcasting ops don't map elements one to one
+    const Shape& shape = node.get_output_shape(0);
+    for (const Input<const Node>& input : node.inputs())
+    {
+        if (input.get_partial_shape().is_dynamic() || input.get_shape() != shape)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool pass::ElementwiseFusion::run_on_function(shared_ptr<Function> f)
+{
+    struct Group
+    {
+        shared_ptr<Node> m_root;
+        NodeVector m_nodes;
+        NodeVector m_args;
+    };
+    vector<Group> groups;
+    // Group of each fused node
+    unordered_map<Node*, size_t> grouped;
+
+    NodeVector ordered_ops = f->get_ordered_ops();
+    // Visit consumers before their producers so each group grows from its last op
+    for (auto it = ordered_ops.rbegin(); it != ordered_ops.rend(); ++it)
+    {
+        const shared_ptr<Node>& root = *it;
+        if (grouped.count(root.get()) != 0 || !is_fusible(*root) ||
+            is_type<op::v0::Broadcast>(root))
+        {
+            continue;
+        }
+        const Shape& shape = root->get_output_shape(0);
+        unordered_set<Node*> members{root.get()};
+        vector<Node*> pending{root.get()};
+        while (!pending.empty())
+        {
+            Node* consumer = pending.back();
+            pending.pop_back();
+            if (is_type<op::v0::Broadcast>(consumer))
+            {
+                // Only the expansion is fused, its input is read from memory
+                continue;
+            }
+            for (const Output<Node>& value : consumer->input_values())
+            {
+                Node* producer = value.get_node();
+                if (members.count(producer) != 0 || grouped.count(producer) != 0 ||
+                    !is_fusible(*producer) || producer->get_output_shape(0) != shape)
+                {
+                    continue;
+                }
+                bool only_used_by_consumer = true;
+                for (const Input<Node>& input : value.get_target_inputs())
+                {
+                    only_used_by_consumer &= input.get_node() == consumer;
+                }
+                if (only_used_by_consumer)
+                {
+                    members.insert(producer);
+                    pending.push_back(producer);
+                }
+            }
+        }
+        if (members.size() < 2)
+        {
+            continue;
+        }
+
+        // op::CompiledKernel can only take whole nodes as arguments
+        bool single_output_args = true;
+        for (Node* member : members)
+        {
+            for (const Output<Node>& value : member->input_values())
+            {
+                Node* arg = value.get_node();
+                single_output_args &= members.count(arg) != 0 || arg->get_output_size() == 1;
+            }
+        }
+        if (!single_output_args)
+        {
+            continue;
+        }
+        for (Node* member : members)
+        {
+            grouped[member] = groups.size();
+        }
+        groups.push_back(Group{root, {}, {}});
+    }
+
+    // The nodes and arguments of every group, in the order they are computed
+    vector<unordered_set<Node*>> group_args(groups.size());
+    for (const shared_ptr<Node>& node : ordered_ops)
+    {
+        auto member = grouped.find(node.get());
+        if (member == grouped.end())
+        {
+            continue;
+        }
+        Group& group = groups[member->second];
+        group.m_nodes.push_back(node);
+        for (const Output<Node>& value : node->input_values())
+        {
+            auto producer = grouped.find(value.get_node());
+            if ((producer == grouped.end() || producer->second != member->second) &&
+                group_args[member->second].insert(value.get_node()).second)
+            {
+                group.m_args.push_back(value.get_node_shared_ptr());
+            }
+        }
+    }
+
+    // A group's root may be an argument of a group found before it, replacing the root later
+    // rewires that argument to the new kernel
+    for (const Group& group : groups)
+    {
+        auto kernel =
+            make_shared<op::CompiledKernel>(group.m_nodes, NodeVector{group.m_root}, group.m_args);
+        replace_node(group.m_root, kernel);
+    }
+    return !groups.empty();
+}
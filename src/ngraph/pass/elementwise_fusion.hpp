@@ -0,0 +1,49 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include "ngraph/pass/pass.hpp"
+
+namespace ngraph
+{
+    namespace pass
+    {
+        class ElementwiseFusion;
+    }
+}
+
+/// \brief Groups chains of elementwise ops into op::CompiledKernel nodes.
+///
+/// A group is a tree of elementwise ops of one shape rooted at an op whose result is used
+/// outside of the group. Every other member feeds exactly one op of the group, so its result
+/// never has to be materialized. v0 Broadcasts of values computed outside of the group are
+/// also pulled in, which lets a backend expand them block by block. The kernel's node list is
+/// in topological order and its only output is the root.
+class NGRAPH_API ngraph::pass::ElementwiseFusion : public FunctionPass
+{
+public:
+    ElementwiseFusion()
+        : FunctionPass()
+    {
+        set_property(PassProperty::REQUIRE_STATIC_SHAPE, true);
+    }
+
+    bool run_on_function(std::shared_ptr<Function> f) override;
+
+    /// \brief True if `node` may be a member of a fused group
+    static bool is_fusible(const Node& node);
+};
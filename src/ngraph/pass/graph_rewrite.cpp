@@ -16,12 +16,15 @@
 
 #include <algorithm>
 #include <iostream>
+#include <map>
 #include <regex>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "graph_rewrite.hpp"
 #include "ngraph/env_util.hpp"
+#include "ngraph/graph_util.hpp"
 #include "ngraph/log.hpp"
 
 using namespace std;
@@ -60,6 +63,142 @@ using namespace ngraph;
 // c) there's no linear order of fusions which will give
 //    the correct final fusion. i.e. the same fusion needs to occur before and after some other
 //    fusion
+// A pass that only reruns matchers already offered every node does not revisit the whole graph:
+// it visits the nodes created by the rewrites of the previous pass and the nodes downstream of the
+// rewritten ones that a pattern could reach. Registering a newly constructed matcher always gets
+// a full pass.
+// A node is only offered to matchers whose pattern root has the node's type, or is a pattern op
+// such as a `Label`; this does not change which matcher wins on a node.
+
+namespace
+{
+    // Indices of the matchers that can match a node of a given type, in registration order.
+    //
+    // A pattern rooted at an ordinary op only matches nodes of exactly that op type (see
+    // Node::match_value), so its matcher is only offered nodes of that type. Patterns rooted at a
+    // pattern op (Label, Any, Skip, ...) can match any node and are offered every node.
+    class MatcherDispatch
+    {
+    public:
+        explicit MatcherDispatch(const vector<shared_ptr<pattern::Matcher>>& matchers)
+        {
+            for (size_t i = 0; i < matchers.size(); i++)
+            {
+                Node* root = matchers[i]->get_pattern_value().get_node();
+                if (root == nullptr || root->is_pattern())
+                {
+                    m_any_type.push_back(i);
+                }
+                else
+                {
+                    m_by_type[root->get_type_info()].push_back(i);
+                }
+            }
+        }
+
+        const vector<size_t>& get_candidates(const Node& node)
+        {
+            const NodeTypeInfo& type = node.get_type_info();
+            auto it = m_candidates.find(type);
+            if (it == m_candidates.end())
+            {
+                vector<size_t> candidates;
+                auto typed = m_by_type.find(type);
+                if (typed == m_by_type.end())
+                {
+                    candidates = m_any_type;
+                }
+                else
+                {
+                    merge(typed->second.begin(),
+                          typed->second.end(),
+                          m_any_type.begin(),
+                          m_any_type.end(),
+                          back_inserter(candidates));
+                }
+                it = m_candidates.emplace(type, move(candidates)).first;
+            }
+            return it->second;
+        }
+
+    private:
+        vector<size_t> m_any_type;
+        map<NodeTypeInfo, vector<size_t>> m_by_type;
+        // Merged lists, built the first time a node of the type is seen.
+        map<NodeTypeInfo, vector<size_t>> m_candidates;
+    };
+}
+
+// Number of nodes on the longest path from `node` to a leaf of its pattern
+static size_t get_pattern_depth(Node* node, unordered_map<Node*, size_t>& depths)
+{
+    auto it = depths.find(node);
+    if (it != depths.end())
+    {
+        return it->second;
+    }
+    size_t depth = 0;
+    for (const Input<Node>& input : node->inputs())
+    {
+        depth = max(depth, get_pattern_depth(input.get_source_output().get_node(), depths));
+    }
+    depths[node] = depth + 1;
+    return depth + 1;
+}
+
+// The nodes whose match can have changed since a pass rewrote nodes with users
+// `rewritten_users`: the nodes up to `depth` - 1 uses downstream of the rewritten nodes, and the
+// nodes created by the rewrites, which have an instance id above `max_instance_id`.
+static vector<shared_ptr<Node>> get_revisited_nodes(const vector<shared_ptr<Node>>& rewritten_users,
+                                                    size_t depth,
+                                                    size_t max_instance_id)
+{
+    vector<shared_ptr<Node>> nodes;
+    unordered_set<Node*> visited;
+    vector<shared_ptr<Node>> level{rewritten_users};
+    for (size_t distance = 1; !level.empty() && (distance == 1 || distance < depth); distance++)
+    {
+        vector<shared_ptr<Node>> next_level;
+        for (auto& user : level)
+        {
+            vector<shared_ptr<Node>> stack{user};
+            while (!stack.empty())
+            {
+                shared_ptr<Node> node = stack.back();
+                stack.pop_back();
+                if (!visited.insert(node.get()).second)
+                {
+                    continue;
+                }
+                nodes.push_back(node);
+                for (auto& input : node->inputs())
+                {
+                    shared_ptr<Node> arg = input.get_source_output().get_node_shared_ptr();
+                    if (arg->get_instance_id() > max_instance_id)
+                    {
+                        stack.push_back(arg);
+                    }
+                }
+            }
+            for (auto& next : user->get_users())
+            {
+                next_level.push_back(next);
+            }
+        }
+        level = move(next_level);
+    }
+
+    // Drop nodes that have been replaced since.
+    vector<shared_ptr<Node>> live_nodes;
+    for (auto& node : nodes)
+    {
+        if (node->is_output() || !node->get_users().empty())
+        {
+            live_nodes.push_back(node);
+        }
+    }
+    return subgraph_topological_sort(live_nodes);
+}
 
 bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
 {
@@ -71,6 +210,23 @@ bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
     // it behind an environment variable for now. TODO: Find a less expensive way to handle this.
     static bool s_rerun_dynamic_check = getenv_bool("NGRAPH_GRAPH_REWRITE_RERUN_DYNAMIC_CHECK");
     bool is_dyn_func = s_rerun_dynamic_check && f->is_dynamic();
+
+    // Later passes only run matchers registered by callbacks. A matcher that has already been
+    // offered every node has seen every node that existed before those callbacks ran, after the
+    // rewrites of the nodes before it in topological order; the only nodes whose match can have
+    // changed are the ones created by later rewrites and the ones close enough downstream of a
+    // rewritten node for a pattern rooted there to reach it. So a later pass only visits those,
+    // unless it runs a matcher that has not been offered every node. Callbacks that construct a
+    // new matcher to request another pass get a full one.
+    vector<shared_ptr<Node>> nodes = f->get_ordered_ops();
+    bool visit_all_nodes = true;
+    unordered_set<shared_ptr<pattern::Matcher>> matchers_run_on_all_nodes;
+    // Nodes with a larger instance id were created by a rewrite.
+    size_t max_instance_id = 0;
+    for (auto& node : nodes)
+    {
+        max_instance_id = max(max_instance_id, node->get_instance_id());
+    }
     do
     {
         rewritten = false;
@@ -78,20 +234,32 @@ bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
         // that need multiple passes. See comments above.
         vector<MatchClosure> matchers_to_run{m_matchers};
         m_matchers.clear();
-        for (auto node : f->get_ordered_ops())
+        vector<shared_ptr<pattern::Matcher>> matchers;
+        for (auto& closure : matchers_to_run)
+        {
+            matchers.push_back(closure.matcher);
+        }
+        MatcherDispatch dispatch(matchers);
+        bool skipped_matchers = false;
+        // The users of the nodes rewritten in this pass, as they were before the rewrite.
+        vector<shared_ptr<Node>> rewritten_users;
+
+        for (auto node : nodes)
         {
             if (m_enable_shape_inference)
             {
                 node->revalidate_and_infer_types();
             }
-            for (auto& closure : matchers_to_run)
+            for (size_t index : dispatch.get_candidates(*node))
             {
+                auto& closure = matchers_to_run[index];
                 if (is_dyn_func && closure.property[PassProperty::REQUIRE_STATIC_SHAPE])
                 {
                     NGRAPH_DEBUG << "matcher callback requires static shape but the "
                                     "function is dynamic, skipping this "
                                     "optimization till the shapes are fully "
                                     "materialized";
+                    skipped_matchers = true;
                     continue;
                 }
                 NGRAPH_DEBUG << "Running matcher " << closure.matcher->get_name() << "("
@@ -101,9 +269,11 @@ bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
                 {
                     NGRAPH_DEBUG << "Matcher " << closure.matcher << closure.matcher->get_name()
                                  << " matched " << node->get_name();
+                    auto users = node->get_users();
                     if (closure.callback(*closure.matcher.get()))
                     {
                         rewritten = true;
+                        rewritten_users.insert(rewritten_users.end(), users.begin(), users.end());
                         // If call back may change function's is_dynamic state, we need to
                         // update the cached value.
                         if (closure.property.is_set(PassProperty::CHANGE_DYNAMIC_STATE))
@@ -116,6 +286,40 @@ bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
             }
         }
 
+        if (!rewritten || m_matchers.empty())
+        {
+            continue;
+        }
+        if (visit_all_nodes && !skipped_matchers)
+        {
+            for (auto& closure : matchers_to_run)
+            {
+                matchers_run_on_all_nodes.insert(closure.matcher);
+            }
+        }
+        visit_all_nodes = false;
+        size_t depth = 1;
+        unordered_map<Node*, size_t> depths;
+        for (auto& closure : m_matchers)
+        {
+            visit_all_nodes |= matchers_run_on_all_nodes.count(closure.matcher) == 0;
+            if (Node* root = closure.matcher->get_pattern_value().get_node())
+            {
+                depth = max(depth, get_pattern_depth(root, depths));
+            }
+        }
+        if (visit_all_nodes)
+        {
+            nodes = f->get_ordered_ops();
+        }
+        else
+        {
+            nodes = get_revisited_nodes(rewritten_users, depth, max_instance_id);
+        }
+        for (auto& node : nodes)
+        {
+            max_instance_id = max(max_instance_id, node->get_instance_id());
+        }
     } while (rewritten && m_matchers.size() > 0 && tries--);
 
     m_matchers.assign(original_matchers.begin(), original_matchers.end());
@@ -0,0 +1,58 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include "ngraph/pass/lstm_sequence_to_tensor_iterator.hpp"
+#include "ngraph/op/fused/lstm_sequence.hpp"
+#include "ngraph/op/get_output_element.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+bool pass::LSTMSequenceToTensorIterator::run_on_node(shared_ptr<Node> node)
+{
+    auto sequence = as_type_ptr<op::LSTMSequence>(node);
+    if (!sequence)
+    {
+        return false;
+    }
+    for (const Input<Node>& input : sequence->inputs())
+    {
+        if (input.get_partial_shape().is_dynamic())
+        {
+            return false;
+        }
+    }
+
+    NodeVector replacements = sequence->decompose_to_tensor_iterator();
+    for (size_t i = 0; i < replacements.size(); ++i)
+    {
+        for (Input<Node> input : sequence->output(i).get_target_inputs())
+        {
+            if (auto goe = as_type<op::GetOutputElement>(input.get_node()))
+            {
+                for (Input<Node> goe_input : goe->output(0).get_target_inputs())
+                {
+                    goe_input.replace_source_output(replacements[i]);
+                }
+            }
+            else
+            {
+                input.replace_source_output(replacements[i]);
+            }
+        }
+    }
+    return true;
+}
@@ -55,11 +55,21 @@ runtime::AlignedBuffer::AlignedBuffer(size_t byte_size, size_t alignment, Alloca
     }
 }
 
+runtime::AlignedBuffer::AlignedBuffer(void* data, size_t byte_size, shared_ptr<void> owner)
+    : m_allocator(nullptr)
+    , m_allocated_buffer(nullptr)
+    , m_aligned_buffer(static_cast<char*>(data))
+    , m_byte_size(byte_size)
+    , m_owner(move(owner))
+{
+}
+
 runtime::AlignedBuffer::AlignedBuffer(AlignedBuffer&& other)
     : m_allocator(other.m_allocator)
     , m_allocated_buffer(other.m_allocated_buffer)
     , m_aligned_buffer(other.m_aligned_buffer)
     , m_byte_size(other.m_byte_size)
+    , m_owner(move(other.m_owner))
 {
     other.m_allocator = nullptr;
     other.m_allocated_buffer = nullptr;
@@ -90,6 +100,7 @@ runtime::AlignedBuffer& runtime::AlignedBuffer::operator=(AlignedBuffer&& other)
         m_allocated_buffer = other.m_allocated_buffer;
         m_aligned_buffer = other.m_aligned_buffer;
         m_byte_size = other.m_byte_size;
+        m_owner = move(other.m_owner);
         other.m_allocator = nullptr;
         other.m_allocated_buffer = nullptr;
         other.m_aligned_buffer = nullptr;
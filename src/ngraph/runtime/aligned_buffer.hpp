@@ -17,6 +17,7 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
 
 #include "ngraph/runtime/allocator.hpp"
 
@@ -38,6 +39,9 @@ public:
     // creators of AlignedBuffers. They need to ensure that the lifetime of
     // allocator exceeds the lifetime of this AlignedBuffer.
     AlignedBuffer(size_t byte_size, size_t alignment = 64, Allocator* allocator = nullptr);
+    /// \brief Refers to byte_size bytes at data without copying them. The memory belongs to
+    ///        owner, which is kept alive as long as this buffer.
+    AlignedBuffer(void* data, size_t byte_size, std::shared_ptr<void> owner);
 
     AlignedBuffer();
     ~AlignedBuffer();
@@ -74,4 +78,6 @@ private:
     char* m_allocated_buffer;
     char* m_aligned_buffer;
     size_t m_byte_size;
+    // Set for buffers that refer to memory they do not allocate.
+    std::shared_ptr<void> m_owner;
 };
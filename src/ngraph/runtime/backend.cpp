@@ -25,6 +25,7 @@
 #include "ngraph/file_util.hpp"
 #include "ngraph/runtime/backend.hpp"
 #include "ngraph/runtime/backend_manager.hpp"
+#include "ngraph/runtime/cache.hpp"
 #include "ngraph/runtime/dynamic/dynamic_backend.hpp"
 #include "ngraph/util.hpp"
 
@@ -125,6 +126,30 @@ std::shared_ptr<runtime::Executable> runtime::Backend::load(istream& /* input_st
     throw runtime_error("load operation unimplemented.");
 }
 
+std::shared_ptr<runtime::Executable> runtime::Backend::compile_with_disk_cache(
+    const std::string& backend_name,
+    std::shared_ptr<Function> func,
+    const ngraph::pass::PassConfig* pass_config,
+    bool enable_performance_data,
+    const std::function<std::shared_ptr<Executable>()>& compile_function)
+{
+    std::shared_ptr<DiskCache> disk_cache =
+        enable_performance_data ? nullptr : DiskCache::get_default();
+    if (!disk_cache)
+    {
+        return compile_function();
+    }
+
+    std::string key = DiskCache::make_key(backend_name, func, pass_config);
+    std::shared_ptr<Executable> exec = disk_cache->load(key, *this);
+    if (!exec)
+    {
+        exec = compile_function();
+        disk_cache->store(key, *exec);
+    }
+    return exec;
+}
+
 bool runtime::Backend::is_device_memory(void* /* ptr */)
 {
     // override this method for each supported backend to determine if the passed pointer is in
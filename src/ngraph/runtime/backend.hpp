@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <mutex>
 
@@ -178,6 +179,23 @@ public:
     /// \brief Get the version of the backend
     /// The default value of 0.0.0 is chosen to be a parsable version number
     virtual std::string get_version() const { return "0.0.0"; }
+
+protected:
+    /// \brief Returns `compile_function()`, going through the executable disk cache (see
+    ///        runtime::DiskCache) when NGRAPH_EXECUTABLE_CACHE_DIR is set. Backends that
+    ///        implement `load` call this from `compile` so that caching is transparent.
+    ///
+    /// The cache is bypassed when performance data is collected.
+    /// \param backend_name The name the backend is registered under.
+    /// \param func The function about to be compiled; the key is computed before
+    ///        `compile_function` may modify it.
+    std::shared_ptr<Executable> compile_with_disk_cache(
+        const std::string& backend_name,
+        std::shared_ptr<Function> func,
+        const ngraph::pass::PassConfig* pass_config,
+        bool enable_performance_data,
+        const std::function<std::shared_ptr<Executable>()>& compile_function);
+
 private:
     // mutex to modify s_backend_shared_library_search_directory thread safe
     static std::mutex m_mtx;
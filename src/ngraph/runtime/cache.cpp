@@ -14,117 +14,359 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#include "ngraph/env_util.hpp"
+#include "ngraph/except.hpp"
+#include "ngraph/file_util.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/pass/pass_config.hpp"
+#include "ngraph/runtime/backend.hpp"
 #include "ngraph/runtime/cache.hpp"
+#include "ngraph/serializer.hpp"
 
 using namespace ngraph;
 using namespace std;
 
-// Constructor
-runtime::LRUCache::LRUCache()
+// Declared in ngraph.hpp, which is meant for users of the library.
+extern "C" const char* get_ngraph_version_string();
+
+constexpr size_t runtime::CacheKey::s_inline_capacity;
+
+runtime::CacheKey::CacheKey(initializer_list<int64_t> words)
 {
-    char* cache_size = getenv("NGRAPH_CACHE_SIZE");
-    if (cache_size == nullptr)
+    for (int64_t word : words)
     {
-        m_cache_size = 1024; // TODO(nbpatel): Figure out a default size for the cache
+        push_back(word);
+    }
+}
+
+void runtime::CacheKey::push_back(int64_t word)
+{
+    if (m_size < s_inline_capacity)
+    {
+        m_inline[m_size] = word;
     }
     else
     {
-        m_cache_size = atoi(cache_size);
+        m_overflow.push_back(word);
     }
+    m_size++;
 
-    m_map = {};
-    m_list = {};
+    // FNV-1a over whole words, followed by a multiply-xorshift so that small integers (the
+    // common case for dimensions) still spread over the high bits used to pick a shard.
+    m_hash = (m_hash ^ static_cast<uint64_t>(word)) * 0x100000001b3;
+    m_hash ^= m_hash >> 29;
 }
 
-// Destructor
-runtime::LRUCache::~LRUCache()
+bool runtime::CacheKey::operator==(const CacheKey& other) const
 {
-    m_list.clear();
-    m_map.clear();
-    m_clone_function_map.clear();
+    if (m_size != other.m_size || m_hash != other.m_hash)
+    {
+        return false;
+    }
+    size_t n = min(m_size, s_inline_capacity);
+    return equal(m_inline.begin(), m_inline.begin() + n, other.m_inline.begin()) &&
+           m_overflow == other.m_overflow;
 }
 
-void runtime::LRUCache::convert_shape_to_string(const vector<int>& shape, ostringstream& key)
+// Constructor
+runtime::LRUCache::LRUCache()
+    : LRUCache(static_cast<size_t>(max(getenv_int("NGRAPH_CACHE_SIZE", 1024), 0)))
+{
+}
+
+runtime::LRUCache::LRUCache(size_t capacity)
+    : m_capacity(capacity)
 {
-    if (!shape.empty())
+    // Small caches keep a single shard so that eviction stays exactly least-recently-used.
+    size_t shard_count = capacity < 64 ? 1 : 16;
+    m_shard_capacity = (capacity + shard_count - 1) / shard_count;
+    for (size_t i = 0; i < shard_count; i++)
     {
-        std::copy(shape.begin(), shape.end(), std::ostream_iterator<int>(key, ", "));
+        m_shards.emplace_back(new Shard());
     }
 }
 
-void runtime::LRUCache::add_entry(const vector<int>& shape,
+// Destructor
+runtime::LRUCache::~LRUCache()
+{
+}
+
+runtime::LRUCache::Shard& runtime::LRUCache::get_shard(const CacheKey& key)
+{
+    return *m_shards[(m_shards.size() - 1) & (key.get_hash() >> 7)];
+}
+
+void runtime::LRUCache::add_entry(const CacheKey& key,
                                   shared_ptr<runtime::Executable> exec,
                                   shared_ptr<Function> func)
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    ostringstream key;
-    // check if the list is empty
-    if (m_list.size() == m_cache_size)
+    if (m_capacity == 0)
+    {
+        return;
+    }
+
+    Shard& shard = get_shard(key);
+    std::lock_guard<std::mutex> guard(shard.m_mutex);
+    auto it = shard.m_map.find(key);
+    if (it != shard.m_map.end())
+    {
+        // Another caller compiled the same key concurrently; keep the newer entry.
+        it->second.m_executable = exec;
+        it->second.m_function = func;
+        shard.m_recency.splice(shard.m_recency.begin(), shard.m_recency, it->second.m_recency);
+        return;
+    }
+
+    if (shard.m_map.size() >= m_shard_capacity)
     {
-        ostringstream key;
-        convert_shape_to_string(m_list.back(), key);
-        m_list.pop_back();
-        m_map.erase(key.str());
+        shard.m_map.erase(shard.m_recency.back());
+        shard.m_recency.pop_back();
     }
 
-    convert_shape_to_string(shape, key);
-    m_map.insert({key.str(), exec});
-    m_list.push_front(shape);
-    m_clone_function_map.insert({key.str(), func});
+    shard.m_recency.push_front(key);
+    shard.m_map.insert({key, Entry{exec, func, shard.m_recency.begin()}});
 }
 
-bool runtime::LRUCache::is_cached(const vector<int>& shape)
+bool runtime::LRUCache::get_entry(const CacheKey& key,
+                                  shared_ptr<runtime::Executable>& exec,
+                                  shared_ptr<Function>& func)
 {
-    for (auto itr = m_list.begin(); itr != m_list.end(); itr++)
+    Shard& shard = get_shard(key);
+    std::lock_guard<std::mutex> guard(shard.m_mutex);
+    auto it = shard.m_map.find(key);
+    if (it == shard.m_map.end())
     {
-        if (*itr == shape)
-        {
-            return true;
-        }
+        return false;
     }
-    return false;
+    // update list to push this reference to the front
+    shard.m_recency.splice(shard.m_recency.begin(), shard.m_recency, it->second.m_recency);
+    exec = it->second.m_executable;
+    func = it->second.m_function;
+    return true;
 }
 
-shared_ptr<runtime::Executable> runtime::LRUCache::get_cached_entry(const vector<int>& shape)
+bool runtime::LRUCache::is_cached(const CacheKey& key)
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    ostringstream key;
-    convert_shape_to_string(shape, key);
+    Shard& shard = get_shard(key);
+    std::lock_guard<std::mutex> guard(shard.m_mutex);
+    return shard.m_map.count(key) != 0;
+}
 
-    // find the entry and return the function
-    auto it = m_map.find(key.str());
-    if (it == m_map.end())
+shared_ptr<runtime::Executable> runtime::LRUCache::get_cached_entry(const CacheKey& key)
+{
+    shared_ptr<runtime::Executable> exec;
+    shared_ptr<Function> func;
+    if (!get_entry(key, exec, func))
     {
         throw ngraph_error("Entry not found in cache");
     }
-    else
+    return exec;
+}
+
+// Need the clone function to get the output shape so that
+// storage can be allocated for output
+shared_ptr<Function> runtime::LRUCache::get_cloned_function(const CacheKey& key)
+{
+    Shard& shard = get_shard(key);
+    std::lock_guard<std::mutex> guard(shard.m_mutex);
+    auto it = shard.m_map.find(key);
+    if (it == shard.m_map.end())
+    {
+        throw ngraph_error("Cloned function not found");
+    }
+    return it->second.m_function;
+}
+
+size_t runtime::LRUCache::size()
+{
+    size_t total = 0;
+    for (auto& shard : m_shards)
+    {
+        std::lock_guard<std::mutex> guard(shard->m_mutex);
+        total += shard->m_map.size();
+    }
+    return total;
+}
+
+runtime::DiskCache::DiskCache(const string& directory)
+    : m_directory(directory)
+{
+    file_util::make_directory(m_directory);
+}
+
+shared_ptr<runtime::DiskCache> runtime::DiskCache::get_default()
+{
+#ifdef NGRAPH_JSON_DISABLE
+    return nullptr;
+#else
+    static mutex default_mutex;
+    static shared_ptr<DiskCache> default_cache;
+
+    string directory = getenv_string("NGRAPH_EXECUTABLE_CACHE_DIR");
+    if (directory.empty())
     {
-        // update list to push this reference to the front
-        for (auto itr = m_list.begin(); itr != m_list.end(); itr++)
+        return nullptr;
+    }
+    lock_guard<mutex> guard(default_mutex);
+    if (!default_cache || default_cache->get_directory() != directory)
+    {
+        default_cache = make_shared<DiskCache>(directory);
+    }
+    return default_cache;
+#endif
+}
+
+// The serialized function with the generated names of the function, its nodes and their
+// outputs replaced by names derived from the topological position of the node. Nodes of nested
+// functions keep their generated names, which only costs cache hits.
+static string canonical_model(const shared_ptr<Function>& function)
+{
+    unordered_map<string, string> names;
+    names[function->get_name()] = "function";
+    size_t node_index = 0;
+    for (const shared_ptr<Node>& node : function->get_ordered_ops(true))
+    {
+        string name = "node_" + to_string(node_index++);
+        for (size_t i = 0; i < node->get_output_size(); i++)
         {
-            if (*itr == shape)
-            {
-                m_list.remove(shape);
-                m_list.push_front(shape);
-                break;
-            }
+            names[node->get_output_tensor(i).get_name()] = name + "_" + to_string(i);
         }
-        return it->second;
+        names[node->get_name()] = name;
     }
+
+    string model = serialize(function, 0);
+    string canonical;
+    canonical.reserve(model.size());
+    size_t i = 0;
+    while (i < model.size())
+    {
+        if (model[i] != '"')
+        {
+            canonical.push_back(model[i++]);
+            continue;
+        }
+        size_t end = i + 1;
+        while (end < model.size() && model[end] != '"')
+        {
+            end += model[end] == '\\' ? 2 : 1;
+        }
+        end = min(end, model.size());
+        auto it = names.find(model.substr(i + 1, end - i - 1));
+        canonical.push_back('"');
+        if (it == names.end())
+        {
+            canonical.append(model, i + 1, end - i - 1);
+        }
+        else
+        {
+            canonical.append(it->second);
+        }
+        canonical.push_back('"');
+        i = end + 1;
+    }
+    return canonical;
 }
 
-// Need the clone function to get the output shape so that
-// storage can be allocated for output
-shared_ptr<Function> runtime::LRUCache::get_cloned_function(const vector<int>& shape)
+string runtime::DiskCache::make_key(const string& backend_name,
+                                    const shared_ptr<Function>& function,
+                                    const pass::PassConfig* pass_config)
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    ostringstream key;
-    convert_shape_to_string(shape, key);
-    // find the entry and return the function
-    auto it = m_clone_function_map.find(key.str());
-    if (it == m_clone_function_map.end())
+    stringstream options;
+    options << get_ngraph_version_string() << "\n" << backend_name << "\n";
+    if (pass_config != nullptr)
     {
-        throw ngraph_error("Cloned function not found");
+        for (auto& enable : pass_config->get_enables())
+        {
+            options << "enable " << enable.first << "=" << enable.second << "\n";
+        }
+        for (auto& attribute : pass_config->get_pass_attributes())
+        {
+            options << "attribute " << attribute.first << "=" << attribute.second << "\n";
+        }
+    }
+
+    // Two independent 64-bit hashes: FNV-1a, and a multiply-rotate hash with another constant.
+    uint64_t h1 = 0xcbf29ce484222325;
+    uint64_t h2 = 0x84222325cbf29ce4;
+    auto hash = [&](const string& s) {
+        for (char c : s)
+        {
+            uint64_t byte = static_cast<unsigned char>(c);
+            h1 = (h1 ^ byte) * 0x100000001b3;
+            h2 = (h2 + byte) * 0x9e3779b97f4a7c15;
+            h2 = (h2 << 31) | (h2 >> 33);
+        }
+    };
+    hash(options.str());
+    hash(canonical_model(function));
+
+    stringstream key;
+    key << hex << setfill('0') << setw(16) << h1 << setw(16) << h2;
+    return key.str();
+}
+
+string runtime::DiskCache::get_path(const string& key) const
+{
+    return file_util::path_join(m_directory, key + ".ngexe");
+}
+
+shared_ptr<runtime::Executable> runtime::DiskCache::load(const string& key,
+                                                         Backend& backend) const
+{
+    ifstream in(get_path(key), ios::binary);
+    if (!in)
+    {
+        return nullptr;
+    }
+    try
+    {
+        return backend.load(in);
+    }
+    catch (const exception& e)
+    {
+        NGRAPH_WARN << "Ignoring unreadable executable cache entry " << get_path(key) << ": "
+                    << e.what();
+    }
+    return nullptr;
+}
+
+void runtime::DiskCache::store(const string& key, Executable& executable) const
+{
+    string path = get_path(key);
+    stringstream unique;
+    unique << hash<thread::id>()(this_thread::get_id()) << "_"
+           << chrono::steady_clock::now().time_since_epoch().count();
+    string temp_path = path + "." + unique.str() + ".tmp";
+    try
+    {
+        {
+            ofstream out(temp_path, ios::binary);
+            if (!out)
+            {
+                throw ngraph_error("cannot create " + temp_path);
+            }
+            executable.save(out);
+            if (!out)
+            {
+                throw ngraph_error("cannot write " + temp_path);
+            }
+        }
+        if (rename(temp_path.c_str(), path.c_str()) != 0)
+        {
+            throw ngraph_error("cannot rename " + temp_path + " to " + path);
+        }
+    }
+    catch (const exception& e)
+    {
+        NGRAPH_WARN << "Could not store executable cache entry " << path << ": " << e.what();
+        remove(temp_path.c_str());
     }
-    return it->second;
 }
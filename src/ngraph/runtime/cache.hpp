@@ -16,46 +16,145 @@
 
 #pragma once
 
-#include <algorithm>
-#include <iostream>
-#include <iterator>
+#include <array>
+#include <cstdint>
 #include <list>
+#include <memory>
 #include <mutex>
-#include <sstream>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
 #include "ngraph/function.hpp"
+#include "ngraph/ngraph_visibility.hpp"
 #include "ngraph/runtime/executable.hpp"
-#include "ngraph/shape.hpp"
 
 namespace ngraph
 {
+    namespace pass
+    {
+        class PassConfig;
+    }
+
     namespace runtime
     {
-        class LRUCache : public std::enable_shared_from_this<LRUCache>
+        class Backend;
+
+        /// \brief Key of the LRUCache: a sequence of 64-bit words with a running hash.
+        ///
+        /// The first words are stored inline so that building a key for a typical call (a few
+        /// inputs of low rank) does not allocate.
+        class NGRAPH_API CacheKey
         {
         public:
-            using GraphCache = std::unordered_map<std::string, std::shared_ptr<Executable>>;
-            using ClonedFunctionMap = std::unordered_map<std::string, std::shared_ptr<Function>>;
+            CacheKey() = default;
+            CacheKey(std::initializer_list<int64_t> words);
+
+            void push_back(int64_t word);
+            size_t size() const { return m_size; }
+            size_t get_hash() const { return static_cast<size_t>(m_hash); }
+            int64_t operator[](size_t i) const
+            {
+                return i < s_inline_capacity ? m_inline[i] : m_overflow[i - s_inline_capacity];
+            }
+            bool operator==(const CacheKey& other) const;
+            bool operator!=(const CacheKey& other) const { return !(*this == other); }
+            struct Hash
+            {
+                size_t operator()(const CacheKey& key) const { return key.get_hash(); }
+            };
 
+        private:
+            static constexpr size_t s_inline_capacity = 32;
+            std::array<int64_t, s_inline_capacity> m_inline{};
+            std::vector<int64_t> m_overflow;
+            size_t m_size = 0;
+            uint64_t m_hash = 0xcbf29ce484222325;
+        };
+
+        /// \brief Bounded cache of compiled executables, evicting the least recently used.
+        ///
+        /// Entries are spread over independently locked shards by key hash so concurrent
+        /// lookups for different keys rarely contend. Recency is tracked per shard, so eviction
+        /// is least-recently-used within a shard. The capacity defaults to NGRAPH_CACHE_SIZE
+        /// (1024 if unset); a capacity of 0 disables caching.
+        class NGRAPH_API LRUCache : public std::enable_shared_from_this<LRUCache>
+        {
+        public:
             LRUCache();
+            explicit LRUCache(size_t capacity);
 
             virtual ~LRUCache();
 
-            void add_entry(const std::vector<int>& shape,
+            void add_entry(const CacheKey& key,
                            std::shared_ptr<Executable> exec,
                            std::shared_ptr<Function> func);
-            bool is_cached(const std::vector<int>& shape);
-            std::shared_ptr<Executable> get_cached_entry(const std::vector<int>& shape);
-            void convert_shape_to_string(const std::vector<int>& shape, std::ostringstream& key);
-            std::shared_ptr<Function> get_cloned_function(const std::vector<int>& shape);
+            /// \brief Looks up key and marks it most recently used.
+            /// \return false if the key is not cached; exec and func are left untouched.
+            bool get_entry(const CacheKey& key,
+                           std::shared_ptr<Executable>& exec,
+                           std::shared_ptr<Function>& func);
+            bool is_cached(const CacheKey& key);
+            std::shared_ptr<Executable> get_cached_entry(const CacheKey& key);
+            std::shared_ptr<Function> get_cloned_function(const CacheKey& key);
+
+            size_t get_capacity() const { return m_capacity; }
+            size_t size();
+
+        private:
+            struct Entry
+            {
+                std::shared_ptr<Executable> m_executable;
+                std::shared_ptr<Function> m_function;
+                std::list<CacheKey>::iterator m_recency;
+            };
+            struct Shard
+            {
+                std::mutex m_mutex;
+                std::unordered_map<CacheKey, Entry, CacheKey::Hash> m_map;
+                // Most recently used key first.
+                std::list<CacheKey> m_recency;
+            };
+
+            Shard& get_shard(const CacheKey& key);
+
+            size_t m_capacity;
+            size_t m_shard_capacity;
+            std::vector<std::unique_ptr<Shard>> m_shards;
+        };
+
+        /// \brief Directory of saved executables (see Executable::save), addressed by the
+        ///        content of the compiled function and the options it was compiled with.
+        ///
+        /// Keys do not depend on the generated names of nodes and tensors, so the same graph
+        /// built again in another process maps to the same entry. Entries are written to a
+        /// temporary file and renamed into place, so processes sharing a directory never see
+        /// partially written entries.
+        class NGRAPH_API DiskCache
+        {
+        public:
+            explicit DiskCache(const std::string& directory);
+
+            /// \brief The cache in NGRAPH_EXECUTABLE_CACHE_DIR, or nullptr if that is unset or
+            ///        functions cannot be serialized in this build.
+            static std::shared_ptr<DiskCache> get_default();
+            /// \brief Key of `function` compiled by backend `backend_name`.
+            /// \param pass_config Options of the compilation; nullptr for the defaults.
+            static std::string make_key(const std::string& backend_name,
+                                        const std::shared_ptr<Function>& function,
+                                        const pass::PassConfig* pass_config);
+
+            const std::string& get_directory() const { return m_directory; }
+            std::string get_path(const std::string& key) const;
+            /// \brief Loads the entry for `key` with `backend`.
+            /// \return nullptr if there is no entry, or it cannot be loaded.
+            std::shared_ptr<Executable> load(const std::string& key, Backend& backend) const;
+            /// \brief Saves `executable` as the entry for `key`. Failures are logged and
+            ///        otherwise ignored; the cache is an optimization.
+            void store(const std::string& key, Executable& executable) const;
 
         private:
-            int m_cache_size;
-            GraphCache m_map;
-            ClonedFunctionMap m_clone_function_map;
-            std::list<std::vector<int>> m_list;
-            std::mutex m_mutex;
+            std::string m_directory;
         };
     }
 }
@@ -14,13 +14,24 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <iomanip>
 #include <iostream>
 #include <map>
 #include <sstream>
 #include <string>
+#ifndef _WIN32
+#include <csignal>
+#include <fcntl.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 #include "chrome_trace.hpp"
 #include "ngraph/env_util.hpp"
+#include "ngraph/except.hpp"
 #include "ngraph/log.hpp"
 
 using namespace std;
@@ -239,3 +250,341 @@ string runtime::event::Manager::get_thread_id()
     }
     return rc;
 }
+
+struct runtime::event::Recorder::State
+{
+    mutex m_mutex;
+    size_t m_capacity = 0;
+    vector<shared_ptr<ThreadBuffer>> m_buffers;
+    vector<pair<string, string>> m_names;
+    map<pair<string, string>, uint32_t> m_name_ids;
+    vector<string> m_thread_names;
+    // now() and the clock at enable(), to convert timestamps to microseconds
+    uint64_t m_origin_ticks = 0;
+    chrono::steady_clock::time_point m_origin_time;
+    string m_dump_path;
+};
+
+atomic<bool> runtime::event::Recorder::s_enabled{false};
+atomic<size_t> runtime::event::Recorder::s_generation{0};
+
+runtime::event::Recorder::State& runtime::event::Recorder::get_state()
+{
+    static State s_state;
+    return s_state;
+}
+
+void runtime::event::Recorder::enable(size_t events_per_thread)
+{
+    State& state = get_state();
+    lock_guard<mutex> lock(state.m_mutex);
+    // One slot more, the one a thread may be writing during a dump
+    size_t capacity = 1;
+    while (capacity < events_per_thread + 1)
+    {
+        capacity *= 2;
+    }
+    state.m_capacity = capacity;
+    state.m_buffers.clear();
+    state.m_thread_names.clear();
+    state.m_origin_ticks = now();
+    state.m_origin_time = chrono::steady_clock::now();
+    // Threads notice the new generation on their next event and take a new buffer
+    s_generation++;
+    s_enabled = events_per_thread > 0;
+}
+
+void runtime::event::Recorder::disable()
+{
+    s_enabled = false;
+}
+
+uint32_t runtime::event::Recorder::register_name(const string& name, const string& category)
+{
+    State& state = get_state();
+    lock_guard<mutex> lock(state.m_mutex);
+    auto key = make_pair(name, category);
+    auto it = state.m_name_ids.find(key);
+    if (it != state.m_name_ids.end())
+    {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(state.m_names.size());
+    state.m_names.push_back(key);
+    state.m_name_ids.insert({key, id});
+    return id;
+}
+
+constexpr uint32_t runtime::event::Recorder::Name::s_unregistered;
+
+uint32_t runtime::event::Recorder::Name::get_id()
+{
+    uint32_t id = m_id.load(memory_order_acquire);
+    if (id == s_unregistered)
+    {
+        // Threads racing here register the same name and get the same id
+        id = register_name(m_name, m_category);
+        m_id.store(id, memory_order_release);
+    }
+    return id;
+}
+
+uint64_t runtime::event::Recorder::now()
+{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+runtime::event::Recorder::ThreadBuffer* runtime::event::Recorder::get_thread_buffer()
+{
+    struct Handle
+    {
+        ~Handle()
+        {
+            if (m_buffer)
+            {
+                m_buffer->m_in_use = false;
+            }
+        }
+        shared_ptr<ThreadBuffer> m_buffer;
+        size_t m_generation = 0;
+    };
+    static thread_local Handle t_handle;
+
+    size_t generation = s_generation.load(memory_order_relaxed);
+    if (t_handle.m_generation != generation)
+    {
+        State& state = get_state();
+        lock_guard<mutex> lock(state.m_mutex);
+        if (t_handle.m_buffer)
+        {
+            t_handle.m_buffer->m_in_use = false;
+            t_handle.m_buffer = nullptr;
+        }
+        for (const shared_ptr<ThreadBuffer>& buffer : state.m_buffers)
+        {
+            bool in_use = false;
+            if (buffer->m_in_use.compare_exchange_strong(in_use, true))
+            {
+                t_handle.m_buffer = buffer;
+                break;
+            }
+        }
+        if (!t_handle.m_buffer)
+        {
+            t_handle.m_buffer = make_shared<ThreadBuffer>(state.m_capacity);
+            state.m_buffers.push_back(t_handle.m_buffer);
+        }
+        stringstream name;
+        name << this_thread::get_id();
+        t_handle.m_buffer->m_thread = static_cast<uint32_t>(state.m_thread_names.size());
+        state.m_thread_names.push_back(name.str());
+        t_handle.m_generation = s_generation.load(memory_order_relaxed);
+    }
+    return t_handle.m_buffer.get();
+}
+
+void runtime::event::Recorder::record(uint32_t name_id, uint64_t start, uint64_t stop)
+{
+    if (!is_enabled())
+    {
+        return;
+    }
+    ThreadBuffer* buffer = get_thread_buffer();
+    uint64_t head = buffer->m_head.load(memory_order_relaxed);
+    // A dump that reads any of the stores below into the slot of event head - capacity also
+    // sees the head that drops that event, as in a seqlock
+    atomic_thread_fence(memory_order_release);
+    Event& event = buffer->m_events[head & (buffer->m_capacity - 1)];
+    event.m_name_id.store(name_id, memory_order_relaxed);
+    event.m_thread.store(buffer->m_thread.load(memory_order_relaxed), memory_order_relaxed);
+    event.m_start.store(start, memory_order_relaxed);
+    event.m_stop.store(stop, memory_order_relaxed);
+    buffer->m_head.store(head + 1, memory_order_release);
+}
+
+static void write_json_string(ostream& out, const string& s)
+{
+    out << '"';
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out << '\\';
+        }
+        out << c;
+    }
+    out << '"';
+}
+
+void runtime::event::Recorder::dump(ostream& out)
+{
+    State& state = get_state();
+    lock_guard<mutex> lock(state.m_mutex);
+
+    // Calibrate the timestamps against the clock over at least a few milliseconds
+    uint64_t ticks = now();
+    auto time = chrono::steady_clock::now();
+    if (time - state.m_origin_time < chrono::milliseconds(10))
+    {
+        this_thread::sleep_for(chrono::milliseconds(10));
+        ticks = now();
+        time = chrono::steady_clock::now();
+    }
+    double elapsed_us = chrono::duration<double, micro>(time - state.m_origin_time).count();
+    double ticks_per_us = (ticks - state.m_origin_ticks) / elapsed_us;
+
+    const string& pid = Manager::get_process_id();
+    out << "[\n";
+    bool first = true;
+    for (size_t i = 0; i < state.m_thread_names.size(); i++)
+    {
+        out << (first ? "" : ",\n") << R"({"name":"thread_name","ph":"M","pid":)" << pid
+            << R"(,"tid":)" << i << R"(,"args":{"name":)";
+        write_json_string(out, state.m_thread_names[i]);
+        out << "}}";
+        first = false;
+    }
+
+    struct Copy
+    {
+        uint64_t m_index;
+        uint32_t m_name_id;
+        uint32_t m_thread;
+        uint64_t m_start;
+        uint64_t m_stop;
+    };
+    out << fixed << setprecision(3);
+    for (const shared_ptr<ThreadBuffer>& buffer : state.m_buffers)
+    {
+        uint64_t head = buffer->m_head.load(memory_order_acquire);
+        uint64_t capacity = buffer->m_capacity;
+        vector<Copy> events;
+        uint64_t kept = capacity - 1;
+        for (uint64_t index = head > kept ? head - kept : 0; index < head; index++)
+        {
+            const Event& event = buffer->m_events[index & (capacity - 1)];
+            events.push_back({index,
+                              event.m_name_id.load(memory_order_relaxed),
+                              event.m_thread.load(memory_order_relaxed),
+                              event.m_start.load(memory_order_relaxed),
+                              event.m_stop.load(memory_order_relaxed)});
+        }
+        // Events in the slots the owner wrote while they were copied may be torn. The owner
+        // may also be writing the slot after new_head.
+        atomic_thread_fence(memory_order_acquire);
+        uint64_t new_head = buffer->m_head.load(memory_order_relaxed);
+        for (const Copy& event : events)
+        {
+            if (event.m_index + kept < new_head || event.m_name_id >= state.m_names.size() ||
+                event.m_start < state.m_origin_ticks)
+            {
+                continue;
+            }
+            const pair<string, string>& name = state.m_names[event.m_name_id];
+            out << (first ? "" : ",\n") << R"({"name":)";
+            write_json_string(out, name.first);
+            out << R"(,"cat":)";
+            write_json_string(out, name.second);
+            out << R"(,"ph":"X","pid":)" << pid << R"(,"tid":)" << event.m_thread << R"(,"ts":)"
+                << (event.m_start - state.m_origin_ticks) / ticks_per_us << R"(,"dur":)"
+                << (event.m_stop - event.m_start) / ticks_per_us << "}";
+            first = false;
+        }
+    }
+    out << "\n]\n";
+    out.unsetf(ios_base::floatfield);
+}
+
+void runtime::event::Recorder::dump(const string& path)
+{
+    ofstream out(path, ios_base::trunc);
+    if (!out)
+    {
+        throw ngraph_error("Cannot open trace file " + path);
+    }
+    dump(out);
+}
+
+#ifndef _WIN32
+static int s_dump_pipe[2] = {-1, -1};
+
+static void dump_signal_handler(int)
+{
+    // Only async-signal-safe calls here; the dump itself runs on the thread reading the pipe
+    char c = 0;
+    ssize_t rc = write(s_dump_pipe[1], &c, 1);
+    (void)rc;
+}
+#endif
+
+void runtime::event::Recorder::dump_on_signal(int signal, const string& path)
+{
+#ifdef _WIN32
+    (void)signal;
+    (void)path;
+    throw ngraph_error("Trace dumps on signals are not supported on Windows");
+#else
+    State& state = get_state();
+    lock_guard<mutex> lock(state.m_mutex);
+    state.m_dump_path = path;
+    if (s_dump_pipe[0] < 0)
+    {
+        if (pipe(s_dump_pipe) != 0)
+        {
+            throw ngraph_error("Cannot create the pipe for trace dumps");
+        }
+        fcntl(s_dump_pipe[1], F_SETFL, O_NONBLOCK);
+        thread([]() {
+            char c;
+            while (read(s_dump_pipe[0], &c, 1) == 1)
+            {
+                string dump_path;
+                {
+                    lock_guard<mutex> path_lock(get_state().m_mutex);
+                    dump_path = get_state().m_dump_path;
+                }
+                try
+                {
+                    dump(dump_path);
+                }
+                catch (const exception& e)
+                {
+                    NGRAPH_WARN << e.what();
+                }
+            }
+        }).detach();
+    }
+    struct sigaction action = {};
+    action.sa_handler = dump_signal_handler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    if (sigaction(signal, &action, nullptr) != 0)
+    {
+        throw ngraph_error("Cannot install a handler for signal " + to_string(signal));
+    }
+#endif
+}
+
+static bool configure_recorder()
+{
+    int32_t events_per_thread = getenv_int("NGRAPH_TRACE_BUFFER_EVENTS", 0);
+    if (events_per_thread <= 0)
+    {
+        return false;
+    }
+    runtime::event::Recorder::enable(events_per_thread);
+    int32_t signal = getenv_int("NGRAPH_TRACE_DUMP_SIGNAL", 0);
+    if (signal > 0)
+    {
+        string path = getenv_string("NGRAPH_TRACE_DUMP_FILE");
+        runtime::event::Recorder::dump_on_signal(signal,
+                                                 path.empty() ? "ngraph_trace_buffer.json" : path);
+    }
+    return true;
+}
+
+static bool s_recorder_configured = configure_recorder();
@@ -16,12 +16,16 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 #ifdef _WIN32
 #include <windows.h>
 // windows.h must be before processthreadsapi.h so we need this comment
@@ -40,6 +44,7 @@ namespace ngraph
             class Duration;
             class Object;
             class Manager;
+            class Recorder;
         }
     }
 }
@@ -79,6 +84,7 @@ class ngraph::runtime::event::Manager
 {
     friend class Duration;
     friend class Object;
+    friend class Recorder;
 
 public:
     static void open(const std::string& path = "runtime_event_trace.json");
@@ -142,3 +148,120 @@ private:
     const std::string m_name;
     size_t m_id{0};
 };
+
+//
+// Recorder keeps the most recent events of each thread in a fixed-size ring buffer of compact
+// binary records (name id, thread, start and stop timestamps) instead of formatting them as they
+// happen, so it is cheap enough to leave on. A compiled function keeps a Name for each op,
+// registered the first time an event is recorded for it, so functions compiled before recording
+// starts are traced too and functions never traced add no names. Recording an event is two
+// timestamp reads and a few stores into memory owned by the thread. The buffers are converted to
+// chrome trace JSON only when dumped, on request or when the process receives the signal given
+// to dump_on_signal.
+//
+// NGRAPH_TRACE_BUFFER_EVENTS sets the number of events kept per thread and enables recording
+// at startup. NGRAPH_TRACE_DUMP_SIGNAL then installs a handler for that signal number which
+// dumps to NGRAPH_TRACE_DUMP_FILE.
+//
+class ngraph::runtime::event::Recorder
+{
+public:
+    /// \brief Start recording, keeping at least the last `events_per_thread` events of every
+    /// thread. Events recorded before are discarded.
+    static void enable(size_t events_per_thread);
+    static void disable();
+    static bool is_enabled() { return s_enabled.load(std::memory_order_relaxed); }
+    /// \brief Id of an event name to pass to record. Registering the same name and category
+    /// again returns the same id.
+    static uint32_t register_name(const std::string& name, const std::string& category);
+    /// \brief Current timestamp in the units of record, the time stamp counter where available
+    static uint64_t now();
+    static void record(uint32_t name_id, uint64_t start, uint64_t stop);
+    /// \brief Write the buffered events as a chrome trace. Threads may keep recording meanwhile;
+    /// events they overwrite during the dump are left out.
+    static void dump(std::ostream& out);
+    static void dump(const std::string& path);
+    /// \brief Dump to `path` whenever the process receives `signal`. Not available on Windows.
+    static void dump_on_signal(int signal, const std::string& path);
+
+    /// \brief An event name that is registered the first time it is recorded
+    class Name
+    {
+    public:
+        Name(const std::string& name, const std::string& category)
+            : m_name(name)
+            , m_category(category)
+        {
+        }
+        uint32_t get_id();
+        Name(const Name&) = delete;
+        Name& operator=(const Name&) = delete;
+
+    private:
+        static constexpr uint32_t s_unregistered = UINT32_MAX;
+        std::string m_name;
+        std::string m_category;
+        std::atomic<uint32_t> m_id{s_unregistered};
+    };
+
+    /// \brief Records the lifetime of the object as an event when recording is enabled
+    class Scope
+    {
+    public:
+        explicit Scope(uint32_t name_id)
+            : m_name_id(name_id)
+            , m_start(is_enabled() ? now() : 0)
+        {
+        }
+        explicit Scope(Name& name)
+            : m_name(&name)
+            , m_start(is_enabled() ? now() : 0)
+        {
+        }
+        ~Scope()
+        {
+            if (m_start != 0)
+            {
+                record(m_name ? m_name->get_id() : m_name_id, m_start, now());
+            }
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Name* m_name = nullptr;
+        uint32_t m_name_id = 0;
+        uint64_t m_start;
+    };
+
+private:
+    struct Event
+    {
+        std::atomic<uint32_t> m_name_id;
+        std::atomic<uint32_t> m_thread;
+        std::atomic<uint64_t> m_start;
+        std::atomic<uint64_t> m_stop;
+    };
+    struct ThreadBuffer
+    {
+        explicit ThreadBuffer(size_t capacity)
+            : m_events(new Event[capacity])
+            , m_capacity(capacity)
+        {
+        }
+        std::unique_ptr<Event[]> m_events;
+        // A power of two
+        size_t m_capacity;
+        // Number of events ever written; only the owning thread stores it
+        std::atomic<uint64_t> m_head{0};
+        // Index of the owning thread in the dump; a buffer is reused when its thread exits
+        std::atomic<uint32_t> m_thread{0};
+        std::atomic<bool> m_in_use{true};
+    };
+    struct State;
+    static State& get_state();
+    static ThreadBuffer* get_thread_buffer();
+
+    static std::atomic<bool> s_enabled;
+    static std::atomic<size_t> s_generation;
+};
@@ -14,8 +14,12 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <cstring>
+
 #include "ngraph/op/allreduce.hpp"
 #include "ngraph/log.hpp"
+#include "ngraph/op/allreduce_start.hpp"
+#include "ngraph/op/allreduce_wait.hpp"
 #include "ngraph/runtime/cpu/cpu_builder.hpp"
 
 using namespace std;
@@ -67,7 +71,71 @@ namespace ngraph
                 functors.emplace_back(functor);
             }
 
-            void register_builders_allreduce_cpp() { REGISTER_OP_BUILDER(AllReduce); }
+            template <>
+            void Builder::BUILDER_DECL(ngraph::op::AllReduceStart)
+            {
+                auto& functors = external_function->get_functors();
+                auto arg_buffer_index = external_function->get_buffer_index(args[0].get_name());
+                auto out_buffer_index = external_function->get_buffer_index(out[0].get_name());
+                auto count = out[0].get_size();
+                auto size = out[0].get_size() * out[0].get_element_type().size();
+                auto data_type = args[0].get_element_type();
+                auto reduce_type =
+                    static_cast<const ngraph::op::AllReduceStart*>(node)->get_reduce_type();
+
+                auto request_index = external_function->add_all_reduce_request(node);
+
+                // The argument may be reused once this functor returns, so the reduction
+                // works on the output buffer
+                auto functor =
+                    [request_index,
+                     count,
+                     size,
+                     reduce_type,
+                     data_type,
+                     arg_buffer_index,
+                     out_buffer_index](CPURuntimeContext* ctx, CPUExecutionContext* /* ectx */) {
+                        void* data = ctx->buffer_data[out_buffer_index];
+                        memcpy(data, ctx->buffer_data[arg_buffer_index], size);
+                        ctx->all_reduce_requests[request_index] =
+                            get_distributed_interface()->all_reduce_start(
+                                data, data, data_type, reduce_type, count);
+                    };
+                functors.emplace_back(functor);
+            }
+
+            template <>
+            void Builder::BUILDER_DECL(ngraph::op::AllReduceWait)
+            {
+                auto& functors = external_function->get_functors();
+                auto arg_buffer_index = external_function->get_buffer_index(args[0].get_name());
+                auto out_buffer_index = external_function->get_buffer_index(out[0].get_name());
+                auto size = out[0].get_size() * out[0].get_element_type().size();
+
+                auto request_index =
+                    external_function->get_all_reduce_request(node->get_input_node_ptr(0));
+
+                auto functor = [request_index, size, arg_buffer_index, out_buffer_index](
+                    CPURuntimeContext* ctx, CPUExecutionContext* /* ectx */) {
+                    shared_ptr<DistributedInterface::Request> request;
+                    swap(request, ctx->all_reduce_requests[request_index]);
+                    request->wait();
+                    if (ctx->buffer_data[out_buffer_index] != ctx->buffer_data[arg_buffer_index])
+                    {
+                        memcpy(ctx->buffer_data[out_buffer_index],
+                               ctx->buffer_data[arg_buffer_index],
+                               size);
+                    }
+                };
+                functors.emplace_back(functor);
+            }
+
+            void register_builders_allreduce_cpp()
+            {
+                REGISTER_OP_BUILDER(AllReduce);
+                REGISTER_OP_BUILDER(AllReduceStart);
+                REGISTER_OP_BUILDER(AllReduceWait);
+            }
         }
     }
 }
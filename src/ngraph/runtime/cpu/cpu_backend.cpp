@@ -21,15 +21,18 @@
 #include "cpu_backend_visibility.h"
 
 #include "ngraph/component_manager.hpp"
+#include "ngraph/cpio.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/log.hpp"
 #include "ngraph/runtime/backend_manager.hpp"
+#include "ngraph/runtime/cache.hpp"
 #include "ngraph/runtime/cpu/cpu_backend.hpp"
 #include "ngraph/runtime/cpu/cpu_builder_registry.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/static_initialize.hpp"
+#include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
 
 #ifdef NGRAPH_MLIR_ENABLE
@@ -116,8 +119,15 @@ shared_ptr<runtime::Executable>
             return rc;
         }
     }
-    rc = make_shared<CPU_Executable>(
-        func, pass_config, get_host_memory_allocator(), performance_counters_enabled);
+    rc = compile_with_disk_cache("CPU", func, &pass_config, performance_counters_enabled, [&]() {
+        // Only executables that go to the disk cache are saved, and they need their source.
+        bool keep_source_function = DiskCache::get_default() != nullptr;
+        return make_shared<CPU_Executable>(func,
+                                           pass_config,
+                                           get_host_memory_allocator(),
+                                           performance_counters_enabled,
+                                           keep_source_function);
+    });
     {
         std::lock_guard<std::mutex> guard(m_exec_map_mutex);
         m_exec_map.insert({func, rc});
@@ -128,8 +138,15 @@ shared_ptr<runtime::Executable>
 runtime::cpu::CPU_Executable::CPU_Executable(shared_ptr<Function> func,
                                              ngraph::pass::PassConfig& pass_config,
                                              Allocator* allocator,
-                                             bool performance_counters_enabled)
+                                             bool performance_counters_enabled,
+                                             bool keep_source_function)
+    : m_pass_config(pass_config)
 {
+    if (keep_source_function)
+    {
+        // Compilation rewrites func in place.
+        m_source_function = clone_function(*func);
+    }
     FunctionInstance& instance = m_function_instance;
     if (instance.m_external_function == nullptr)
     {
@@ -164,6 +181,83 @@ bool runtime::cpu::CPU_Executable::call(const vector<shared_ptr<runtime::Tensor>
     return rc;
 }
 
+static const string s_save_info = "CPU Save File 1.0";
+
+// Pass enables and attributes are saved as lines of "<name> <0|1>".
+static string serialize_pass_settings(const map<string, bool>& settings)
+{
+    stringstream ss;
+    for (auto& setting : settings)
+    {
+        ss << setting.first << " " << setting.second << "\n";
+    }
+    return ss.str();
+}
+
+static map<string, bool> deserialize_pass_settings(const string& s)
+{
+    map<string, bool> settings;
+    stringstream ss(s);
+    string name;
+    bool enable;
+    while (ss >> name >> enable)
+    {
+        settings[name] = enable;
+    }
+    return settings;
+}
+
+void runtime::cpu::CPU_Executable::save(ostream& out)
+{
+    if (!m_source_function)
+    {
+        throw ngraph_error(
+            "CPU executable was compiled without keeping its source function and cannot be "
+            "saved");
+    }
+    cpio::Writer writer(out);
+    writer.write("save_info", s_save_info.data(), s_save_info.size());
+    string model = serialize(m_source_function, 0);
+    writer.write("model", model.data(), model.size());
+    string enables = serialize_pass_settings(m_pass_config.get_enables());
+    writer.write("pass_enables", enables.data(), enables.size());
+    string attributes = serialize_pass_settings(m_pass_config.get_pass_attributes());
+    writer.write("pass_attributes", attributes.data(), attributes.size());
+}
+
+shared_ptr<runtime::Executable> runtime::cpu::CPU_Backend::load(istream& in)
+{
+    cpio::Reader reader(in);
+    map<string, string> files;
+    for (const cpio::FileInfo& info : reader.get_file_info())
+    {
+        vector<char> buffer = reader.read(info);
+        files[info.get_name()] = string(buffer.data(), buffer.size());
+    }
+    if (files["save_info"] != s_save_info)
+    {
+        throw ngraph_error("Stream does not contain a saved CPU executable");
+    }
+
+    shared_ptr<Function> func = deserialize(files["model"]);
+    ngraph::pass::PassConfig pass_config;
+    for (auto& enable : deserialize_pass_settings(files["pass_enables"]))
+    {
+        pass_config.set_pass_enable(enable.first, enable.second);
+    }
+    for (auto& attribute : deserialize_pass_settings(files["pass_attributes"]))
+    {
+        pass_config.set_pass_attribute(attribute.first, attribute.second);
+    }
+
+    // Not through compile(), which would consult the disk cache this is often called from.
+    auto exec =
+        make_shared<CPU_Executable>(func, pass_config, get_host_memory_allocator(), false, true);
+    std::lock_guard<std::mutex> guard(m_exec_map_mutex);
+    m_exec_map.insert({func, exec});
+    return exec;
+}
+
 void runtime::cpu::CPU_Backend::remove_compiled_function(shared_ptr<Executable> exec)
 {
     std::lock_guard<std::mutex> guard(m_exec_map_mutex);
@@ -65,6 +65,8 @@ namespace ngraph
 
                 void remove_compiled_function(std::shared_ptr<Executable> exec) override;
 
+                std::shared_ptr<Executable> load(std::istream& input_stream) override;
+
                 Allocator* get_host_memory_allocator() override;
                 void set_host_memory_allocator(Allocator* allocator) override;
 
@@ -83,13 +85,22 @@ namespace ngraph
             class CPU_BACKEND_API CPU_Executable : public runtime::Executable
             {
             public:
+                /// \param keep_source_function Keep a copy of `func` as it was before
+                ///        compilation, which `save` requires.
                 CPU_Executable(std::shared_ptr<Function> func,
                                ngraph::pass::PassConfig& pass_config,
                                Allocator* allocator,
-                               bool performance_counters_enabled);
+                               bool performance_counters_enabled,
+                               bool keep_source_function = false);
                 bool call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                           const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) override;
 
+                /// \brief Saves the source function and the compilation options.
+                ///
+                /// The compiled state itself (kernel functors, memory plan, MKLDNN primitives)
+                /// refers to addresses of this process and is rebuilt by CPU_Backend::load.
+                void save(std::ostream& output_stream) override;
+
                 std::shared_ptr<CPU_CallFrame> get_call_frame();
 
                 std::vector<PerformanceCounter> get_performance_data() const override;
@@ -130,6 +141,8 @@ namespace ngraph
                     std::shared_ptr<CPU_CallFrame> m_call_frame = nullptr;
                     bool m_performance_counters_enabled = false;
                 } m_function_instance;
+                std::shared_ptr<Function> m_source_function;
+                ngraph::pass::PassConfig m_pass_config;
             };
         }
     }
@@ -15,11 +15,17 @@
 //*****************************************************************************
 
 #include <algorithm>
+#include <functional>
+#include <mutex>
+#include <new>
 #include <thread>
+#include <unordered_map>
 
 #include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
+#include "ngraph/runtime/cpu/cpu_numa.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/cpu_tracing.hpp"
 #include "ngraph/runtime/cpu/mkldnn_emitter.hpp"
@@ -27,19 +33,50 @@
 using namespace std;
 using namespace ngraph;
 
+namespace
+{
+    atomic<size_t> s_next_call_frame_serial{0};
+
+    // For every live call frame, by serial number, the function that returns a context pinned
+    // by a thread that has exited
+    mutex s_call_frames_mutex;
+    unordered_map<size_t, function<void(size_t)>> s_unpin_functions;
+
+    // Contexts pinned by a thread, by serial number of their call frame. Serial numbers are
+    // never reused, so a frame allocated where a destroyed one lived does not inherit its pins.
+    struct PinnedContexts : public unordered_map<size_t, size_t>
+    {
+        // The contexts of the frames that are still alive go back to their pools
+        ~PinnedContexts()
+        {
+            lock_guard<mutex> guard(s_call_frames_mutex);
+            for (auto& pinned : *this)
+            {
+                auto it = s_unpin_functions.find(pinned.first);
+                if (it != s_unpin_functions.end())
+                {
+                    it->second(pinned.second);
+                }
+            }
+        }
+    };
+    thread_local PinnedContexts t_pinned_contexts;
+}
+
 runtime::cpu::CPU_CallFrame::CPU_CallFrame(std::shared_ptr<CPU_ExternalFunction> external_function,
                                            InitContextFuncCG compiled_init_ctx_func,
                                            DestroyContextFuncCG compiled_destroy_ctx_func,
                                            EntryPoint compiled_function,
                                            runtime::Allocator* allocator)
     : m_external_function(external_function)
+    , m_serial(s_next_call_frame_serial++)
     , m_compiled_init_ctx_func(compiled_init_ctx_func)
     , m_compiled_destroy_ctx_func(compiled_destroy_ctx_func)
     , m_compiled_function(compiled_function)
 {
     const auto envConcurrency = std::getenv("NGRAPH_CPU_CONCURRENCY");
     m_num_ctx = envConcurrency == nullptr ? 1 : std::atoi(envConcurrency);
-    if (m_num_ctx > std::thread::hardware_concurrency())
+    if (m_num_ctx == 0 || m_num_ctx > std::thread::hardware_concurrency())
     {
         throw ngraph_error(
             "Unexpected value specified for NGRAPH_CPU_CONCURRENCY "
@@ -49,6 +86,13 @@ runtime::cpu::CPU_CallFrame::CPU_CallFrame(std::shared_ptr<CPU_ExternalFunction>
     }
 
     setup_runtime_context(allocator);
+    {
+        lock_guard<mutex> guard(s_call_frames_mutex);
+        s_unpin_functions[m_serial] = [this](size_t id) {
+            m_num_pinned--;
+            release_context(id);
+        };
+    }
     if (!m_external_function->is_direct_execution())
     {
         // Invoke codegen runtime context initialization function.
@@ -59,6 +103,10 @@ runtime::cpu::CPU_CallFrame::CPU_CallFrame(std::shared_ptr<CPU_ExternalFunction>
 
 runtime::cpu::CPU_CallFrame::~CPU_CallFrame()
 {
+    {
+        lock_guard<mutex> guard(s_call_frames_mutex);
+        s_unpin_functions.erase(m_serial);
+    }
     cleanup_runtime_context();
     if (!m_external_function->is_direct_execution())
     {
@@ -119,44 +167,119 @@ void runtime::cpu::CPU_CallFrame::call(
     const std::vector<std::shared_ptr<runtime::Tensor>>& output_tvs,
     const std::vector<std::shared_ptr<runtime::Tensor>>& input_tvs)
 {
-    size_t id = 0;
-    auto disable_caching = false;
+    bool pinned;
+    size_t id = acquire_context(pinned);
+    // Staleness hints describe the inputs of the previous call, so they only apply to the
+    // context that ran it. A pinned context is no exception: a call on another context may
+    // have cleared the hints of a tensor it shares with this one.
+    auto disable_caching = m_prev_ctx.exchange(id) != id;
+
+    m_ctx_vec[id]->pc = 0;
+    try
     {
-        std::unique_lock<std::mutex> lck(m_mutex);
-        while (m_num_ctx_available == 0)
+        propagate_layouts(output_tvs, m_external_function->get_result_layout_descriptors());
+        inner_call(output_tvs, input_tvs, id, disable_caching);
+    }
+    catch (...)
+    {
+        if (!pinned)
         {
-            m_cv.wait(lck);
+            release_context(id);
         }
+        throw;
+    }
+
+    if (!pinned)
+    {
+        release_context(id);
+    }
+}
 
-        for (size_t i = 0; i < m_num_ctx; i++)
+bool runtime::cpu::CPU_CallFrame::try_acquire_context(size_t start, size_t& id)
+{
+    for (size_t i = 0; i < m_num_ctx; i++)
+    {
+        id = (start + i) % m_num_ctx;
+        int state = CONTEXT_FREE;
+        if (m_slots[id].m_state.load(memory_order_relaxed) == CONTEXT_FREE &&
+            m_slots[id].m_state.compare_exchange_strong(state, CONTEXT_BUSY))
         {
-            if (m_id_pool[i])
-            {
-                id = i;
-                break;
-            }
+            return true;
         }
-        NGRAPH_CHECK(id != m_num_ctx);
-        m_id_pool[id] = false;
-        if (id != m_prev_ctx)
+    }
+    return false;
+}
+
+size_t runtime::cpu::CPU_CallFrame::acquire_context(bool& pinned)
+{
+    auto it = t_pinned_contexts.find(m_serial);
+    pinned = it != t_pinned_contexts.end();
+    if (pinned)
+    {
+        return it->second;
+    }
+
+    // Start the search at a slot picked by the thread so that threads tend to keep a context
+    size_t start = hash<thread::id>()(this_thread::get_id()) % m_num_ctx;
+    size_t id;
+    if (try_acquire_context(start, id))
+    {
+        return id;
+    }
+
+    // Every context is busy. Waiters are counted before they search again, and releasers
+    // check the count after freeing their slot, so a release cannot slip between the search
+    // and the wait unnoticed.
+    m_num_waiting++;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [&]() { return try_acquire_context(start, id); });
+    }
+    m_num_waiting--;
+    return id;
+}
+
+void runtime::cpu::CPU_CallFrame::release_context(size_t id)
+{
+    m_slots[id].m_state.store(CONTEXT_FREE);
+    if (m_num_waiting.load() > 0)
+    {
         {
-            // Disable caching since staleness hints are no longer
-            // applicable to this context
-            disable_caching = true;
+            std::lock_guard<std::mutex> lock(m_mutex);
         }
-        m_prev_ctx = id;
-        m_num_ctx_available--;
+        m_cv.notify_one();
     }
+}
 
-    m_ctx_vec[id]->pc = 0;
-    propagate_layouts(output_tvs, m_external_function->get_result_layout_descriptors());
-    inner_call(output_tvs, input_tvs, id, disable_caching);
-
-    m_mutex.lock();
-    m_id_pool[id] = true;
-    m_num_ctx_available++;
-    m_mutex.unlock();
-    m_cv.notify_one();
+bool runtime::cpu::CPU_CallFrame::pin_context()
+{
+    if (t_pinned_contexts.count(m_serial) != 0)
+    {
+        return true;
+    }
+    if (m_num_pinned.fetch_add(1) + 1 >= m_num_ctx)
+    {
+        m_num_pinned--;
+        return false;
+    }
+    bool pinned;
+    size_t id = acquire_context(pinned);
+    m_slots[id].m_state.store(CONTEXT_PINNED);
+    t_pinned_contexts[m_serial] = id;
+    return true;
+}
+
+void runtime::cpu::CPU_CallFrame::unpin_context()
+{
+    auto it = t_pinned_contexts.find(m_serial);
+    if (it == t_pinned_contexts.end())
+    {
+        return;
+    }
+    size_t id = it->second;
+    t_pinned_contexts.erase(it);
+    m_num_pinned--;
+    release_context(id);
 }
 
 void runtime::cpu::CPU_CallFrame::propagate_layouts(
@@ -181,30 +304,57 @@ void runtime::cpu::CPU_CallFrame::propagate_layouts(
 
 void runtime::cpu::CPU_CallFrame::setup_runtime_context(Allocator* allocator)
 {
+    m_slot_buffer = AlignedBuffer(m_num_ctx * sizeof(ContextSlot), alignof(ContextSlot));
+    m_slots = static_cast<ContextSlot*>(m_slot_buffer.get_ptr());
+    for (size_t i = 0; i < m_num_ctx; i++)
+    {
+        new (&m_slots[i]) ContextSlot();
+    }
+    auto& cpu_executor = executor::GetCPUExecutor();
+    int num_numa_nodes = cpu_executor.get_num_numa_nodes();
     for (size_t i = 0; i < m_num_ctx; i++)
     {
-        m_id_pool[i] = true;
         auto ctx = new CPURuntimeContext;
         m_ctx_vec.push_back(ctx);
 
         ctx->pc = 0;
+        // Contexts are spread round-robin over the NUMA nodes, and their memory is placed on
+        // the node that runs them
+        ctx->numa_node = static_cast<int>(i % num_numa_nodes);
+        const std::vector<int>& numa_cpus = cpu_executor.get_numa_cpus(ctx->numa_node);
+        bool place_memory = num_numa_nodes > 1 && !numa_cpus.empty();
         ctx->op_durations = nullptr;
         if (runtime::cpu::IsTracingEnabled())
         {
             ctx->op_durations = new int64_t[m_external_function->get_op_attrs().size()];
         }
         ctx->p_en = new bool[m_external_function->get_parameter_layout_descriptors().size()];
+        ctx->pending_predecessors =
+            new std::atomic<size_t>[m_external_function->get_op_attrs().size()];
 
         ctx->first_iteration = true;
 
         ctx->buffer_data = std::vector<void*>(m_external_function->get_buffer_size());
+        ctx->all_reduce_requests.resize(m_external_function->get_all_reduce_request_count());
 
-        // Create temporary buffer pools
+        // Create temporary buffer pools. Buffers placed on a NUMA node get whole pages of their
+        // own, which no other allocation can have faulted in on another node.
         size_t alignment = runtime::cpu::CPU_ExternalFunction::s_memory_pool_alignment;
+        size_t page_size = numa::get_page_size();
+        auto allocate = [&](size_t size) {
+            if (!place_memory)
+            {
+                return new AlignedBuffer(size, alignment, allocator);
+            }
+            auto buffer = new AlignedBuffer((size + page_size - 1) / page_size * page_size,
+                                            std::max(alignment, page_size),
+                                            allocator);
+            cpu_executor.place_on_numa_node(ctx->numa_node, buffer->get_ptr(), buffer->size());
+            return buffer;
+        };
         for (auto buffer_size : m_external_function->get_memory_buffer_sizes())
         {
-            auto buffer = new AlignedBuffer(buffer_size, alignment, allocator);
-            ctx->memory_buffers.push_back(buffer);
+            ctx->memory_buffers.push_back(allocate(buffer_size));
         }
         const auto& mkldnn_emitter = m_external_function->get_mkldnn_emitter();
         // Create scratchpad
@@ -219,7 +369,7 @@ void runtime::cpu::CPU_CallFrame::setup_runtime_context(Allocator* allocator)
                 mkldnn_emitter->get_mkldnn_scratchpad_mds().size());
             if (scratchpad_size > 0)
             {
-                ctx->scratchpad_buffer = new AlignedBuffer(scratchpad_size, alignment, allocator);
+                ctx->scratchpad_buffer = allocate(scratchpad_size);
             }
             else
             {
@@ -247,7 +397,6 @@ void runtime::cpu::CPU_CallFrame::setup_runtime_context(Allocator* allocator)
         }
 #endif
     }
-    m_num_ctx_available = m_num_ctx;
 }
 
 void runtime::cpu::CPU_CallFrame::cleanup_runtime_context()
@@ -259,6 +408,7 @@ void runtime::cpu::CPU_CallFrame::cleanup_runtime_context()
 
         delete[] ctx->op_durations;
         delete[] ctx->p_en;
+        delete[] ctx->pending_predecessors;
         for (auto p : ctx->mkldnn_primitives)
         {
             delete p;
@@ -304,5 +454,6 @@ void runtime::cpu::CPU_CallFrame::cleanup_runtime_context()
 #endif
         delete ctx;
     }
-    m_num_ctx_available = 0;
+    m_slots = nullptr;
+    m_slot_buffer = AlignedBuffer();
 }
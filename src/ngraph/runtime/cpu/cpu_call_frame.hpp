@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <memory>
@@ -24,6 +25,7 @@
 #include <vector>
 
 #include "ngraph/function.hpp"
+#include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/allocator.hpp"
 #include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
 #include "ngraph/runtime/cpu/cpu_runtime_context.hpp"
@@ -70,6 +72,20 @@ namespace ngraph
                 void call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                           const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
 
+                /// \brief Reserve an execution context for the calling thread.
+                ///
+                /// Calls from the thread then always run on that context. The staleness hints of
+                /// its inputs stay valid between its calls as long as no other thread calls the
+                /// frame in between. One context is always left
+                /// to the other threads, so NGRAPH_CPU_CONCURRENCY must be larger than the number
+                /// of pinned threads. The context returns to the pool when the thread calls
+                /// unpin_context or exits.
+                /// \return false if every context but one is already pinned
+                bool pin_context();
+
+                /// \brief Return the context pinned by the calling thread, if any, to the pool.
+                void unpin_context();
+
                 void propagate_layouts(const std::vector<std::shared_ptr<runtime::Tensor>>& tvs,
                                        const LayoutDescriptorPtrs& layouts) const;
 
@@ -87,14 +103,40 @@ namespace ngraph
                                 const size_t id,
                                 const bool disable_caching = true);
 
+                /// Claim a context, waiting for one to be released if all of them are busy.
+                /// Sets `pinned` if it is the context pinned by the calling thread.
+                size_t acquire_context(bool& pinned);
+                bool try_acquire_context(size_t start, size_t& id);
+                void release_context(size_t id);
+
                 std::shared_ptr<CPU_ExternalFunction> m_external_function;
 
+                enum ContextState : int
+                {
+                    CONTEXT_FREE,
+                    CONTEXT_BUSY,
+                    CONTEXT_PINNED
+                };
+                // Aligned to a cache line so that threads claiming neighbouring contexts do not
+                // contend on the same line
+                struct alignas(64) ContextSlot
+                {
+                    std::atomic<int> m_state{CONTEXT_FREE};
+                };
+
+                // Contexts are claimed with a compare-and-swap on their slot; the mutex and the
+                // condition variable are only used to sleep while every context is busy
                 std::mutex m_mutex;
                 std::condition_variable m_cv;
-                volatile size_t m_num_ctx_available = 0;
-                size_t m_prev_ctx = 0;
+                std::atomic<size_t> m_num_waiting{0};
+                std::atomic<size_t> m_num_pinned{0};
+                std::atomic<size_t> m_prev_ctx{0};
                 size_t m_num_ctx = 1;
-                std::unordered_map<size_t, bool> m_id_pool;
+                // Identifies the call frame in the pinned contexts of threads
+                const size_t m_serial;
+                // new does not honour the alignment of ContextSlot before C++17
+                AlignedBuffer m_slot_buffer;
+                ContextSlot* m_slots = nullptr;
                 std::vector<CPURuntimeContext*> m_ctx_vec;
 
                 // Codegen specific
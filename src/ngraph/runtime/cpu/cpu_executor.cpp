@@ -14,6 +14,8 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
+#include <future>
 #include <thread>
 
 #include "cpu_executor.hpp"
@@ -79,8 +81,28 @@ namespace ngraph
                     : m_num_thread_pools(num_thread_pools)
                 {
                     m_num_cores = GetNumCores();
+
+                    // With NUMA binding every node gets at least one pool, pool i runs on node
+                    // i % nodes and is never wider than the node it is bound to.
+                    std::vector<numa::Node> nodes{numa::Node{0, {}}};
+                    if (std::getenv("NGRAPH_CPU_NUMA_BIND") != nullptr)
+                    {
+                        nodes = numa::get_nodes();
+                        m_num_thread_pools = num_thread_pools =
+                            std::max(num_thread_pools, static_cast<int>(nodes.size()));
+                    }
+                    m_numa_pools.resize(nodes.size());
+                    for (const numa::Node& node : nodes)
+                    {
+                        m_numa_cpus.push_back(node.m_cpus);
+                        m_numa_node_ids.push_back(node.m_id);
+                    }
+
                     for (int i = 0; i < num_thread_pools; i++)
                     {
+                        size_t node = i % nodes.size();
+                        m_numa_pools[node].push_back(i);
+
                         int num_threads_per_pool;
 
                         // Eigen threadpool will still be used for reductions
@@ -104,8 +126,15 @@ namespace ngraph
                             num_threads_per_pool = tp_count;
                         }
 
-                        m_thread_pools.push_back(std::unique_ptr<Eigen::ThreadPool>(
-                            new Eigen::ThreadPool(num_threads_per_pool)));
+                        const std::vector<int>& cpus = m_numa_cpus[node];
+                        if (!cpus.empty())
+                        {
+                            num_threads_per_pool =
+                                std::min(num_threads_per_pool, static_cast<int>(cpus.size()));
+                        }
+
+                        m_thread_pools.push_back(std::unique_ptr<NumaThreadPool>(
+                            new NumaThreadPool(num_threads_per_pool, NumaThreadEnvironment(cpus))));
                         m_thread_pool_devices.push_back(
                             std::unique_ptr<Eigen::ThreadPoolDevice>(new Eigen::ThreadPoolDevice(
                                 m_thread_pools[i].get(), num_threads_per_pool)));
@@ -115,6 +144,17 @@ namespace ngraph
                     }
                 }
 
+                void CPUExecutor::place_on_numa_node(int node, void* data, size_t size)
+                {
+                    numa::bind_memory(data, size, m_numa_node_ids[node]);
+                    std::promise<void> touched;
+                    schedule(m_numa_pools[node][0], [&]() {
+                        numa::first_touch(data, size);
+                        touched.set_value();
+                    });
+                    touched.get_future().wait();
+                }
+
 #if defined(NGRAPH_TBB_ENABLE)
                 void CPUExecutor::execute(CPUKernelFunctor& f,
                                           CPURuntimeContext* ctx,
@@ -21,6 +21,7 @@
 
 #include <mkldnn.hpp>
 
+#include "ngraph/runtime/cpu/cpu_numa.hpp"
 #include "ngraph/runtime/cpu/cpu_runtime_context.hpp"
 
 #define EIGEN_USE_THREADS
@@ -40,6 +41,32 @@ namespace ngraph
             {
                 extern mkldnn::engine global_cpu_engine;
 
+                // Eigen thread environment whose threads are restricted to a set of CPUs
+                struct NumaThreadEnvironment : Eigen::StlThreadEnvironment
+                {
+                    NumaThreadEnvironment() = default;
+                    explicit NumaThreadEnvironment(const std::vector<int>& cpus)
+                        : m_cpus(cpus)
+                    {
+                    }
+
+                    EnvThread* CreateThread(std::function<void()> f)
+                    {
+                        std::vector<int> cpus = m_cpus;
+                        return new EnvThread([cpus, f]() {
+                            if (!cpus.empty())
+                            {
+                                numa::bind_current_thread(cpus);
+                            }
+                            f();
+                        });
+                    }
+
+                    std::vector<int> m_cpus;
+                };
+
+                typedef Eigen::ThreadPoolTempl<NumaThreadEnvironment> NumaThreadPool;
+
                 // CPUExecutor owns the resources for executing a graph.
                 class CPUExecutor
                 {
@@ -61,14 +88,41 @@ namespace ngraph
                                  CPURuntimeContext* ctx,
                                  CPUExecutionContext* ectx);
 #endif
+                    /// \brief Run `task` on a thread of pool `id`
+                    void schedule(int id, std::function<void()> task)
+                    {
+                        m_thread_pools[id]->Schedule(std::move(task));
+                    }
+
                     int get_num_thread_pools() { return m_num_thread_pools; }
                     int get_num_cores() { return m_num_cores; }
+                    /// \brief Number of NUMA nodes the thread pools are spread over; 1 unless
+                    /// NGRAPH_CPU_NUMA_BIND is set
+                    int get_num_numa_nodes() { return static_cast<int>(m_numa_pools.size()); }
+                    /// \brief Ids of the thread pools whose threads run on NUMA node `node`
+                    const std::vector<int>& get_numa_thread_pools(int node)
+                    {
+                        return m_numa_pools[node];
+                    }
+                    /// \brief CPUs of NUMA node `node`, empty when pools are not bound
+                    const std::vector<int>& get_numa_cpus(int node) { return m_numa_cpus[node]; }
+                    /// \brief The kernel's number for NUMA node `node`, which can differ from
+                    /// `node` when some nodes have no CPUs
+                    int get_numa_node_id(int node) { return m_numa_node_ids[node]; }
+                    /// \brief Place `data` on NUMA node `node`: bind its pages to the node and
+                    /// fault them in from a thread of the node's first pool. Call it on new
+                    /// allocations, before anything else writes them, and not from a pool thread.
+                    void place_on_numa_node(int node, void* data, size_t size);
+
                 private:
-                    std::vector<std::unique_ptr<Eigen::ThreadPool>> m_thread_pools;
+                    std::vector<std::unique_ptr<NumaThreadPool>> m_thread_pools;
                     std::vector<std::unique_ptr<Eigen::ThreadPoolDevice>> m_thread_pool_devices;
 #if defined(NGRAPH_TBB_ENABLE)
                     std::vector<tbb::task_arena> m_tbb_arenas;
 #endif
+                    std::vector<std::vector<int>> m_numa_pools;
+                    std::vector<std::vector<int>> m_numa_cpus;
+                    std::vector<int> m_numa_node_ids;
                     int m_num_thread_pools;
                     int m_num_cores;
                 };
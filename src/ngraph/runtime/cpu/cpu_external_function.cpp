@@ -14,9 +14,14 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstdlib>
+#include <exception>
 #include <fstream>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <tuple>
 #include <typeindex>
@@ -50,6 +55,7 @@
 #include "ngraph/op/add.hpp"
 #include "ngraph/op/all.hpp"
 #include "ngraph/op/allreduce.hpp"
+#include "ngraph/op/allreduce_start.hpp"
 #include "ngraph/op/and.hpp"
 #include "ngraph/op/any.hpp"
 #include "ngraph/op/argmax.hpp"
@@ -120,6 +126,7 @@
 #include "ngraph/op/quantize.hpp"
 #include "ngraph/op/quantized_convolution.hpp"
 #include "ngraph/op/quantized_dot.hpp"
+#include "ngraph/op/recv.hpp"
 #include "ngraph/op/relu.hpp"
 #include "ngraph/op/replace_slice.hpp"
 #include "ngraph/op/reshape.hpp"
@@ -129,6 +136,7 @@
 #include "ngraph/op/scatter_add.hpp"
 #include "ngraph/op/scatter_nd_add.hpp"
 #include "ngraph/op/select.hpp"
+#include "ngraph/op/send.hpp"
 #include "ngraph/op/sigmoid.hpp"
 #include "ngraph/op/sign.hpp"
 #include "ngraph/op/sin.hpp"
@@ -163,6 +171,7 @@
 #include "ngraph/pass/reshape_sinking.hpp"
 #include "ngraph/pass/zero_dim_tensor_elimination.hpp"
 #include "ngraph/runtime/aligned_buffer.hpp"
+#include "ngraph/runtime/chrome_trace.hpp"
 #include "ngraph/runtime/cpu/cpu_backend.hpp"
 #include "ngraph/runtime/cpu/cpu_builder.hpp"
 #include "ngraph/runtime/cpu/cpu_builder_registry.hpp"
@@ -1470,6 +1479,18 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
         debug_tracer.set_enable_tracing(true);
     }
 
+    // The inter-op scheduler relies on data dependencies alone, so it is not used when
+    // intermediate buffers are reused, nor for the debugging modes that follow program order.
+    m_use_inter_op_scheduler =
+        executor::GetCPUExecutor().get_num_thread_pools() >
+            executor::GetCPUExecutor().get_num_numa_nodes() &&
+        !pass_config.get_pass_attribute("CPUMemoryAssignment::ReuseMemory") &&
+        !pass_config.get_pass_attribute("ReuseMemory") && !debug_tracer.tracing_is_enabled() &&
+        std::getenv("NGRAPH_DEX_DEBUG") == nullptr;
+#if defined(NGRAPH_TBB_ENABLE)
+    m_use_inter_op_scheduler = m_use_inter_op_scheduler && !m_use_tbb;
+#endif
+
     // Store layouts assigned for arguments
     for (const auto& parameter : m_function->get_parameters())
     {
@@ -1715,6 +1736,12 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
         enable_nodename_list.emplace_back(make_pair(enable, node->get_name()));
 
         m_perf_counters.emplace_back(node, 0, 0);
+        m_trace_names.emplace_back(new runtime::event::Recorder::Name(node->get_name(), "CPU"));
+    }
+
+    if (m_use_inter_op_scheduler)
+    {
+        build_op_dependencies();
     }
 
     if ((std::getenv("NGRAPH_DEX_DEBUG") != nullptr))
@@ -1921,6 +1948,14 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
         else
 #endif
         {
+            if (m_use_inter_op_scheduler && ctx->pc == 0 && ctx->breakpoints.empty())
+            {
+                // Leaves the program counter at the end, so the sequential loop below is skipped
+                execute_op_dependencies(ctx);
+                profiler_count = functors.size();
+                ctx->pc = functors.size();
+            }
+
             static const auto ddebug = std::getenv("NGRAPH_DEX_DEBUG");
             if (ddebug != nullptr)
             {
@@ -1964,14 +1999,18 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
                         start_ts = cpu::Clock::now();
                     }
 
-                    CPUExecutionContext ectx{0};
+                    CPUExecutionContext ectx{
+                        executor::GetCPUExecutor().get_numa_thread_pools(ctx->numa_node)[0]};
 
                     if (debug_tracer.tracing_is_enabled())
                     {
                         this->dump_one_kernel(debug_tracer, ctx, true);
                     }
 
-                    executor::GetCPUExecutor().execute(functors.at(ctx->pc), ctx, &ectx);
+                    {
+                        runtime::event::Recorder::Scope trace(*m_trace_names[ctx->pc]);
+                        executor::GetCPUExecutor().execute(functors.at(ctx->pc), ctx, &ectx);
+                    }
 
                     if (debug_tracer.tracing_is_enabled())
                     {
@@ -2037,6 +2076,279 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
     }
 }
 
+void runtime::cpu::CPU_ExternalFunction::build_op_dependencies()
+{
+    // Functors are created in this order, skipping parameters and constants
+    unordered_map<Node*, size_t> op_index;
+    for (shared_ptr<Node> node : m_function->get_ordered_ops())
+    {
+        if (!node->is_parameter() && !node->is_constant())
+        {
+            op_index.insert({node.get(), op_index.size()});
+        }
+    }
+    NGRAPH_CHECK(op_index.size() == functors.size());
+
+    // Ops reading each tensor
+    unordered_map<descriptor::Tensor*, vector<size_t>> readers;
+    for (auto& p : op_index)
+    {
+        for (auto& input : p.first->inputs())
+        {
+            readers[&input.get_tensor()].push_back(p.second);
+        }
+    }
+
+    vector<set<size_t>> predecessors(functors.size());
+
+    // Every rank must issue its collectives in the same order, so they are chained
+    bool have_collective = false;
+    size_t last_collective = 0;
+    for (shared_ptr<Node> node : m_function->get_ordered_ops())
+    {
+        if (is_type<ngraph::op::AllReduce>(node) || is_type<ngraph::op::AllReduceStart>(node) ||
+            is_type<ngraph::op::BroadcastDistributed>(node) || is_type<ngraph::op::Recv>(node) ||
+            is_type<ngraph::op::Send>(node))
+        {
+            size_t index = op_index.at(node.get());
+            if (have_collective)
+            {
+                predecessors[index].insert(last_collective);
+            }
+            have_collective = true;
+            last_collective = index;
+        }
+    }
+
+    for (auto& p : op_index)
+    {
+        Node* node = p.first;
+        size_t index = p.second;
+        for (auto& input : node->inputs())
+        {
+            auto it = op_index.find(input.get_source_output().get_node());
+            if (it != op_index.end())
+            {
+                predecessors[index].insert(it->second);
+            }
+        }
+        for (auto& dependency : node->get_control_dependencies())
+        {
+            auto it = op_index.find(dependency.get());
+            if (it != op_index.end())
+            {
+                predecessors[index].insert(it->second);
+            }
+        }
+
+        // An op that overwrites its input in place must also wait for the other readers of
+        // that buffer. Memory assignment only allows this after their last use in program
+        // order, so only earlier readers are considered, which keeps the graph acyclic.
+        auto op = dynamic_cast<ngraph::op::Op*>(node);
+        auto op_annotations = op ? op->get_op_annotations() : nullptr;
+        if (!op_annotations)
+        {
+            continue;
+        }
+        for (auto& oi_pair : op_annotations->get_in_place_oi_pairs())
+        {
+            if (!oi_pair.destructive)
+            {
+                continue;
+            }
+            auto buffer = tensor_to_bufferID.find(&node->input(oi_pair.input).get_tensor());
+            if (buffer == tensor_to_bufferID.end())
+            {
+                continue;
+            }
+            for (auto tensor : bufferID_to_tensorSets.at(buffer->second).second)
+            {
+                for (size_t reader : readers[tensor])
+                {
+                    if (reader < index)
+                    {
+                        predecessors[index].insert(reader);
+                    }
+                }
+            }
+        }
+    }
+
+    m_op_successors.assign(functors.size(), vector<size_t>());
+    m_op_predecessor_counts.assign(functors.size(), 0);
+    for (size_t i = 0; i < functors.size(); i++)
+    {
+        m_op_predecessor_counts[i] = predecessors[i].size();
+        for (size_t predecessor : predecessors[i])
+        {
+            m_op_successors[predecessor].push_back(i);
+        }
+    }
+}
+
+void runtime::cpu::CPU_ExternalFunction::execute_op(CPURuntimeContext* ctx,
+                                                    size_t index,
+                                                    int arena)
+{
+    if (enables[index](ctx) || ctx->first_iteration)
+    {
+        cpu::Timestamp start_ts;
+        if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
+        {
+            start_ts = cpu::Clock::now();
+        }
+
+        CPUExecutionContext ectx{arena};
+        {
+            runtime::event::Recorder::Scope trace(*m_trace_names[index]);
+            executor::GetCPUExecutor().execute(functors[index], ctx, &ectx);
+        }
+
+        if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
+        {
+            auto end_ts = cpu::Clock::now();
+            if (runtime::cpu::IsTracingEnabled())
+            {
+                ctx->op_durations[index] =
+                    (std::chrono::duration_cast<cpu::Timescale>(end_ts - start_ts)).count();
+            }
+            if (m_emit_timing)
+            {
+                m_perf_counters[index].m_total_microseconds +=
+                    std::chrono::duration_cast<std::chrono::microseconds>(end_ts - start_ts)
+                        .count();
+                m_perf_counters[index].m_call_count++;
+            }
+        }
+    }
+    else
+    {
+        if (runtime::cpu::IsTracingEnabled())
+        {
+            ctx->op_durations[index] = 0;
+        }
+        if (m_emit_timing)
+        {
+            m_perf_counters[index].m_call_count++;
+        }
+    }
+}
+
+void runtime::cpu::CPU_ExternalFunction::execute_op_dependencies(CPURuntimeContext* ctx)
+{
+    // The calling thread runs ops with the first thread pool of the context's NUMA node for
+    // their intra-op parallelism. Whenever more ops are ready, a helper is scheduled on each
+    // idle pool of that node and runs ready ops with that pool until none is left. A pool never
+    // runs more than one helper of a call, so the kernels it runs always find the other threads
+    // of the pool free.
+    struct Run
+    {
+        mutex m_mutex;
+        condition_variable m_changed;
+        vector<size_t> m_ready;
+        vector<bool> m_arena_busy;
+        size_t m_remaining;
+        size_t m_active_helpers = 0;
+        exception_ptr m_error;
+        // `slot` indexes the pools of the node; slot 0 is the calling thread
+        function<void(size_t)> m_work;
+    };
+    // A helper may still be returning from m_work after the call has seen it finish, so the
+    // scheduled helpers share the ownership of the run.
+    auto run = make_shared<Run>();
+
+    auto& cpu_executor = executor::GetCPUExecutor();
+    const vector<int>& pools = cpu_executor.get_numa_thread_pools(ctx->numa_node);
+    run->m_arena_busy.assign(pools.size(), false);
+    run->m_arena_busy[0] = true;
+    run->m_remaining = functors.size();
+    for (size_t i = functors.size(); i-- > 0;)
+    {
+        ctx->pending_predecessors[i].store(m_op_predecessor_counts[i], memory_order_relaxed);
+        if (m_op_predecessor_counts[i] == 0)
+        {
+            run->m_ready.push_back(i);
+        }
+    }
+
+    Run* r = run.get();
+    weak_ptr<Run> weak_run = run;
+    executor::CPUExecutor* executor = &cpu_executor;
+    const vector<int>* node_pools = &pools;
+    run->m_work = [this, ctx, r, weak_run, executor, node_pools](size_t slot) {
+        unique_lock<mutex> lock(r->m_mutex);
+        while (!r->m_error && r->m_remaining > 0)
+        {
+            if (r->m_ready.empty())
+            {
+                if (slot != 0)
+                {
+                    break;
+                }
+                r->m_changed.wait(lock);
+                continue;
+            }
+            size_t index = r->m_ready.back();
+            r->m_ready.pop_back();
+            for (size_t i = 1; i < r->m_arena_busy.size() && !r->m_ready.empty(); i++)
+            {
+                if (!r->m_arena_busy[i])
+                {
+                    r->m_arena_busy[i] = true;
+                    r->m_active_helpers++;
+                    shared_ptr<Run> helper_run = weak_run.lock();
+                    executor->schedule((*node_pools)[i],
+                                       [helper_run, i]() { helper_run->m_work(i); });
+                }
+            }
+            lock.unlock();
+
+            vector<size_t> ready;
+            try
+            {
+                execute_op(ctx, index, (*node_pools)[slot]);
+                for (size_t successor : m_op_successors[index])
+                {
+                    if (ctx->pending_predecessors[successor].fetch_sub(1) == 1)
+                    {
+                        ready.push_back(successor);
+                    }
+                }
+            }
+            catch (...)
+            {
+                lock.lock();
+                r->m_error = current_exception();
+                r->m_changed.notify_all();
+                break;
+            }
+
+            lock.lock();
+            r->m_ready.insert(r->m_ready.end(), ready.rbegin(), ready.rend());
+            if (--r->m_remaining == 0 || !ready.empty())
+            {
+                r->m_changed.notify_all();
+            }
+        }
+        if (slot != 0)
+        {
+            r->m_arena_busy[slot] = false;
+            r->m_active_helpers--;
+            r->m_changed.notify_all();
+        }
+        else
+        {
+            r->m_changed.wait(lock, [r]() { return r->m_active_helpers == 0; });
+        }
+    };
+    run->m_work(0);
+
+    if (run->m_error)
+    {
+        rethrow_exception(run->m_error);
+    }
+}
+
 size_t runtime::cpu::CPU_ExternalFunction::get_buffer_index(const std::string& name)
 {
     if (tensor_alias.count(name))
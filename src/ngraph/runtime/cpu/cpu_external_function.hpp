@@ -39,6 +39,7 @@
 #include "ngraph/op/concat.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/pass_config.hpp"
+#include "ngraph/runtime/chrome_trace.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
 #include "ngraph/runtime/cpu/cpu_debug_tracer.hpp"
 #include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
@@ -153,6 +154,24 @@ namespace ngraph
                     return m_states.size() - 1;
                 }
 
+                // Index of the request an AllReduceStart leaves in each context for its
+                // AllReduceWait
+                size_t add_all_reduce_request(const Node* start)
+                {
+                    m_all_reduce_request_indices[start] = m_all_reduce_request_count;
+                    return m_all_reduce_request_count++;
+                }
+                size_t get_all_reduce_request(const Node* start) const
+                {
+                    auto it = m_all_reduce_request_indices.find(start);
+                    NGRAPH_CHECK(it != m_all_reduce_request_indices.end(),
+                                 "AllReduceStart ",
+                                 start->get_name(),
+                                 " has not been built");
+                    return it->second;
+                }
+                size_t get_all_reduce_request_count() const { return m_all_reduce_request_count; }
+
                 const std::string& get_function_name() const { return m_function_name; }
                 const std::shared_ptr<ngraph::Function> get_function() { return m_function; }
                 // Temporary Memory Pool alignment
@@ -202,6 +221,12 @@ namespace ngraph
 
                 bool computes_result(Node* node);
                 void release_function() { m_function = nullptr; }
+                // Compute the dependencies between functors used by the inter-op scheduler
+                void build_op_dependencies();
+                // Run the functors as their dependencies complete, on the CPUExecutor pools
+                void execute_op_dependencies(CPURuntimeContext* ctx);
+                // Run one functor, unless its inputs are unchanged, and record its timing
+                void execute_op(CPURuntimeContext* ctx, size_t index, int arena);
 #if !defined(NGRAPH_DEX_ONLY)
                 void emit_debug_function_entry(CodeWriter& writer,
                                                Node* node,
@@ -320,6 +345,17 @@ namespace ngraph
                 std::unordered_map<std::string, std::shared_ptr<CPU_ExternalFunction>> callees;
                 bool m_is_built;
                 std::vector<runtime::PerformanceCounter> m_perf_counters;
+                // Name of each functor's events in the trace ring buffer
+                std::vector<std::unique_ptr<runtime::event::Recorder::Name>> m_trace_names;
+
+                // With more than one CPUExecutor thread pool (NGRAPH_INTER_OP_PARALLELISM), ops
+                // whose predecessors have completed run concurrently, each on its own pool.
+                bool m_use_inter_op_scheduler = false;
+                // For each functor, the functors waiting for it and the number it waits for
+                std::vector<std::vector<size_t>> m_op_successors;
+                std::vector<size_t> m_op_predecessor_counts;
+                std::unordered_map<const Node*, size_t> m_all_reduce_request_indices;
+                size_t m_all_reduce_request_count = 0;
 
                 /// Map each node with mkldnn implementation to its mkldnn primitive creating
                 /// string, deps, mkldnn primitive index, and mkldnn scratchpad size.
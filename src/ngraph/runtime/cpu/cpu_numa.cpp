@@ -0,0 +1,189 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "ngraph/except.hpp"
+#include "ngraph/runtime/cpu/cpu_numa.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+vector<int> runtime::cpu::numa::parse_cpu_list(const string& list)
+{
+    auto malformed = [&list]() { return ngraph_error("Malformed CPU list '" + list + "'"); };
+    auto parse_cpu = [&malformed](const string& cpu) {
+        if (cpu.empty() || cpu.size() > 9 || cpu.find_first_not_of("0123456789") != string::npos)
+        {
+            throw malformed();
+        }
+        return stoi(cpu);
+    };
+
+    vector<int> cpus;
+    stringstream ss(list);
+    string range;
+    while (getline(ss, range, ','))
+    {
+        // The list in sysfs ends with a newline
+        auto begin = range.find_first_not_of(" \t\n");
+        if (begin == string::npos)
+        {
+            continue;
+        }
+        range = range.substr(begin, range.find_last_not_of(" \t\n") + 1 - begin);
+        auto dash = range.find('-');
+        int first = parse_cpu(range.substr(0, dash));
+        int last = dash == string::npos ? first : parse_cpu(range.substr(dash + 1));
+        if (last < first)
+        {
+            throw malformed();
+        }
+        for (int cpu = first; cpu <= last; cpu++)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+vector<runtime::cpu::numa::Node> runtime::cpu::numa::read_nodes(const string& directory)
+{
+    vector<Node> nodes;
+    // Node numbers may have gaps, e.g. after hot-unplug, so look a little past the last one
+    for (int node = 0, missing = 0; missing < 8; node++)
+    {
+        ifstream in(directory + "/node" + to_string(node) + "/cpulist");
+        if (!in)
+        {
+            missing++;
+            continue;
+        }
+        missing = 0;
+        string list;
+        getline(in, list);
+        vector<int> cpus = runtime::cpu::numa::parse_cpu_list(list);
+        // Nodes with memory but no CPUs cannot run pools
+        if (!cpus.empty())
+        {
+            nodes.push_back(Node{node, cpus});
+        }
+    }
+    if (nodes.empty())
+    {
+        vector<int> cpus;
+        for (unsigned cpu = 0; cpu < max(thread::hardware_concurrency(), 1u); cpu++)
+        {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+        nodes.push_back(Node{0, cpus});
+    }
+    return nodes;
+}
+
+const vector<runtime::cpu::numa::Node>& runtime::cpu::numa::get_nodes()
+{
+#if defined(__linux__)
+    static const vector<Node> nodes = read_nodes("/sys/devices/system/node");
+#else
+    static const vector<Node> nodes = read_nodes("");
+#endif
+    return nodes;
+}
+
+bool runtime::cpu::numa::bind_current_thread(const vector<int>& cpus)
+{
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus)
+    {
+        if (cpu >= 0 && cpu < CPU_SETSIZE)
+        {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+size_t runtime::cpu::numa::get_page_size()
+{
+#if defined(__linux__)
+    static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return page_size;
+#else
+    return 4096;
+#endif
+}
+
+bool runtime::cpu::numa::bind_memory(void* data, size_t size, int node)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    // The pages at either end may also hold other data, which stays where it is
+    size_t page_size = get_page_size();
+    uintptr_t begin = (reinterpret_cast<uintptr_t>(data) + page_size - 1) / page_size * page_size;
+    uintptr_t end = (reinterpret_cast<uintptr_t>(data) + size) / page_size * page_size;
+    if (node < 0 || begin >= end)
+    {
+        return false;
+    }
+    // From <numaif.h>, which is part of libnuma rather than the C library
+    const int mpol_preferred = 1;
+    const unsigned mpol_mf_move = 1 << 1;
+    const size_t bits = 8 * sizeof(unsigned long);
+    vector<unsigned long> node_mask(node / bits + 1, 0);
+    node_mask[node / bits] |= 1ul << (node % bits);
+    return syscall(SYS_mbind,
+                   begin,
+                   end - begin,
+                   mpol_preferred,
+                   node_mask.data(),
+                   node_mask.size() * bits + 1,
+                   mpol_mf_move) == 0;
+#else
+    return false;
+#endif
+}
+
+void runtime::cpu::numa::first_touch(void* data, size_t size)
+{
+    if (data == nullptr || size == 0)
+    {
+        return;
+    }
+    size_t page_size = get_page_size();
+    char* bytes = static_cast<char*>(data);
+    bytes[0] = 0;
+    // Then the start of every following page, up to the one holding the last byte
+    uintptr_t start = reinterpret_cast<uintptr_t>(data);
+    for (uintptr_t page = (start / page_size + 1) * page_size; page < start + size;
+         page += page_size)
+    {
+        bytes[page - start] = 0;
+    }
+}
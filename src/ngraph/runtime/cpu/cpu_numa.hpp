@@ -0,0 +1,69 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace numa
+            {
+                /// \brief A NUMA node that pools can run on
+                struct Node
+                {
+                    /// the node number the kernel knows it by, which memory is bound to
+                    int m_id;
+                    std::vector<int> m_cpus;
+                };
+
+                /// \brief The NUMA nodes that have CPUs, read from /sys/devices/system/node on
+                /// Linux. Systems without that information are one node 0 holding every CPU.
+                const std::vector<Node>& get_nodes();
+
+                /// \brief The nodes under `directory`, laid out like /sys/devices/system/node.
+                /// Nodes without CPUs are left out, and when no node has any the result is one
+                /// node 0 holding every CPU.
+                std::vector<Node> read_nodes(const std::string& directory);
+
+                /// \brief Parse a Linux CPU list such as "0-3,8-11"
+                /// \throws ngraph_error if the list is malformed
+                std::vector<int> parse_cpu_list(const std::string& list);
+
+                /// \brief Restrict the calling thread to `cpus`
+                /// \return false if thread affinity is not supported
+                bool bind_current_thread(const std::vector<int>& cpus);
+
+                size_t get_page_size();
+
+                /// \brief Ask the kernel to place the pages that lie entirely within `data` on
+                /// node `node`, moving those that are already faulted in.
+                /// \return false if memory policies are not supported
+                bool bind_memory(void* data, size_t size, int node);
+
+                /// \brief Fault in every page that `data` overlaps by writing a zero to its first
+                /// byte within `data`. New pages are placed on the node of the calling thread.
+                void first_touch(void* data, size_t size);
+            }
+        }
+    }
+}
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <set>
@@ -28,6 +29,7 @@
 #include <tbb/task_scheduler_init.h>
 #endif
 
+#include "ngraph/distributed.hpp"
 #include "ngraph/op/experimental/compiled_kernel.hpp"
 
 #ifdef NGRAPH_MLIR_ENABLE
@@ -77,8 +79,15 @@ namespace ngraph
                 tbb::global_control* c;
 #endif
                 State* const* states;
+                // Number of unfinished predecessors of each op, used by the inter-op scheduler
+                std::atomic<size_t>* pending_predecessors;
+                // In-flight reduction of each AllReduceStart, until its AllReduceWait
+                std::vector<std::shared_ptr<DistributedInterface::Request>> all_reduce_requests;
                 std::set<size_t> breakpoints;
                 size_t pc;
+                // Index of the NUMA node whose thread pools run this context and hold its
+                // memory, see CPUExecutor::get_numa_node_id
+                int numa_node;
 #ifdef NGRAPH_MLIR_ENABLE
                 /// Maps CompiledKernel nodes to their MLIR compiler
                 /// The MLIR compiler caches the compiled code on the first invocation,
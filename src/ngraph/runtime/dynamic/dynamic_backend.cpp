@@ -14,8 +14,12 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
+#include <array>
+
 #include "ngraph/runtime/dynamic/dynamic_backend.hpp"
 #include "ngraph/graph_util.hpp"
+#include "ngraph/log.hpp"
 #include "ngraph/op/avg_pool.hpp"
 #include "ngraph/op/broadcast.hpp"
 #include "ngraph/op/convolution.hpp"
@@ -32,6 +36,8 @@
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/opset0_downgrade.hpp"
 #include "ngraph/pass/shape_relevance.hpp"
+#include "ngraph/runtime/reference/pad.hpp"
+#include "ngraph/runtime/reference/slice.hpp"
 #include "ngraph/specialize_function.hpp"
 #include "ngraph/util.hpp"
 
@@ -111,212 +117,846 @@ static size_t count_dyn_nodes(const shared_ptr<ngraph::Function>& f)
     return count;
 }
 
+void runtime::dynamic::BucketPolicy::add_power_of_two(size_t parameter_index,
+                                                      size_t axis,
+                                                      size_t min_size)
+{
+    m_rules.erase(remove_if(m_rules.begin(),
+                            m_rules.end(),
+                            [&](const Rule& rule) {
+                                return rule.m_parameter_index == parameter_index &&
+                                       rule.m_axis == axis;
+                            }),
+                  m_rules.end());
+    size_t min_bucket = 1;
+    while (min_bucket < min_size)
+    {
+        min_bucket *= 2;
+    }
+    m_rules.push_back(Rule{parameter_index, axis, min_bucket, {}});
+}
+
+void runtime::dynamic::BucketPolicy::add_boundaries(size_t parameter_index,
+                                                    size_t axis,
+                                                    vector<size_t> boundaries)
+{
+    NGRAPH_CHECK(!boundaries.empty(), "Bucket boundaries must not be empty");
+    sort(boundaries.begin(), boundaries.end());
+    add_power_of_two(parameter_index, axis);
+    m_rules.back().m_boundaries = move(boundaries);
+}
+
+void runtime::dynamic::BucketPolicy::add_output_slice(size_t result_index,
+                                                      size_t result_axis,
+                                                      size_t parameter_index,
+                                                      size_t parameter_axis)
+{
+    m_output_slices.push_back(
+        OutputSlice{result_index, result_axis, parameter_index, parameter_axis});
+}
+
+size_t runtime::dynamic::BucketPolicy::get_bucket(size_t parameter_index,
+                                                  size_t axis,
+                                                  size_t size) const
+{
+    for (const Rule& rule : m_rules)
+    {
+        if (rule.m_parameter_index != parameter_index || rule.m_axis != axis || size == 0)
+        {
+            continue;
+        }
+        if (rule.m_boundaries.empty())
+        {
+            size_t bucket = rule.m_min_size;
+            while (bucket < size)
+            {
+                bucket *= 2;
+            }
+            return bucket;
+        }
+        auto it = lower_bound(rule.m_boundaries.begin(), rule.m_boundaries.end(), size);
+        return it == rule.m_boundaries.end() ? size : *it;
+    }
+    return size;
+}
+
+size_t runtime::dynamic::BucketPolicy::get_larger_bucket(size_t parameter_index,
+                                                         size_t axis,
+                                                         size_t bucket) const
+{
+    for (const Rule& rule : m_rules)
+    {
+        if (rule.m_parameter_index != parameter_index || rule.m_axis != axis || bucket == 0)
+        {
+            continue;
+        }
+        if (rule.m_boundaries.empty())
+        {
+            return get_bucket(parameter_index, axis, bucket + 1);
+        }
+        auto it = upper_bound(rule.m_boundaries.begin(), rule.m_boundaries.end(), bucket);
+        return it == rule.m_boundaries.end() ? bucket : *it;
+    }
+    return bucket;
+}
+
+Shape runtime::dynamic::BucketPolicy::get_bucketed_shape(size_t parameter_index,
+                                                         const Shape& shape) const
+{
+    Shape bucketed_shape(shape);
+    for (size_t axis = 0; axis < shape.size(); axis++)
+    {
+        bucketed_shape[axis] = get_bucket(parameter_index, axis, shape[axis]);
+    }
+    return bucketed_shape;
+}
+
+void runtime::dynamic::DynamicExecutable::set_bucket_policy(const BucketPolicy& policy)
+{
+    m_bucket_policy = policy;
+}
+
+// Element-type agnostic helpers for bucketing: a tensor of shape S is handled as a tensor of
+// bytes with shape S + [element size].
+static Shape byte_shape(const runtime::Tensor& tensor)
+{
+    Shape shape = tensor.get_shape();
+    shape.push_back(tensor.get_element_type().size());
+    return shape;
+}
+
+// The memory of host-resident tensors, which are accessed in place; nullptr for the others,
+// which are staged through Tensor::read and Tensor::write.
+static char* get_host_data(const runtime::Tensor& tensor)
+{
+    const runtime::Tensor* host_tensor = &tensor;
+    if (auto dynamic_tensor = dynamic_cast<const runtime::dynamic::DynamicTensor*>(host_tensor))
+    {
+        host_tensor = dynamic_tensor->get_wrapped_tensor().get();
+    }
+    if (auto host = dynamic_cast<const runtime::HostTensor*>(host_tensor))
+    {
+        return const_cast<char*>(host->get_data_ptr());
+    }
+    return nullptr;
+}
+
+// Pads `source` with zeros to `target_shape`, into `target`, which holds `target_shape` of
+// the source's element type.
+static void pad_tensor(const runtime::Tensor& source, const Shape& target_shape, char* target)
+{
+    Shape source_shape = byte_shape(source);
+    Shape target_byte_shape(target_shape);
+    target_byte_shape.push_back(source.get_element_type().size());
+    CoordinateDiff padding_below(source_shape.size(), 0);
+    CoordinateDiff padding_above(source_shape.size(), 0);
+    for (size_t i = 0; i < source_shape.size(); i++)
+    {
+        padding_above[i] = target_byte_shape[i] - source_shape[i];
+    }
+
+    vector<char> source_bytes;
+    const char* source_data = get_host_data(source);
+    if (!source_data)
+    {
+        source_bytes.resize(source.get_size_in_bytes());
+        source.read(source_bytes.data(), source_bytes.size());
+        source_data = source_bytes.data();
+    }
+    char zero = 0;
+    runtime::reference::pad<char>(source_data,
+                                  &zero,
+                                  target,
+                                  source_shape,
+                                  target_byte_shape,
+                                  padding_below,
+                                  padding_above,
+                                  op::PadMode::CONSTANT);
+}
+
+static void slice_tensor(const runtime::Tensor& source, runtime::Tensor& target)
+{
+    Shape source_shape = byte_shape(source);
+    Shape target_shape = byte_shape(target);
+
+    vector<char> source_bytes;
+    const char* source_data = get_host_data(source);
+    if (!source_data)
+    {
+        source_bytes.resize(source.get_size_in_bytes());
+        source.read(source_bytes.data(), source_bytes.size());
+        source_data = source_bytes.data();
+    }
+    vector<char> target_bytes;
+    char* target_data = get_host_data(target);
+    if (!target_data)
+    {
+        target_bytes.resize(target.get_size_in_bytes());
+        target_data = target_bytes.data();
+    }
+    runtime::reference::slice<char>(source_data,
+                                    target_data,
+                                    source_shape,
+                                    Coordinate(source_shape.size(), 0),
+                                    Coordinate(target_shape),
+                                    Strides(source_shape.size(), 1),
+                                    target_shape);
+    if (!target_bytes.empty())
+    {
+        target.write(target_bytes.data(), target_bytes.size());
+    }
+}
+
 bool runtime::dynamic::DynamicExecutable::call(
     const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
     const std::vector<std::shared_ptr<runtime::Tensor>>& inputs)
 {
-    // TODO: Get cached executable out if it exists.
-    // We will cache on:
-    // (1) all shapes;
-    // (2) all values of shape-relevant input tensors.
+    if (!m_bucket_policy.empty())
+    {
+        return call_bucketed(outputs, inputs);
+    }
+    return call_specialized(outputs, inputs);
+}
 
-    std::vector<int> merged_input_shapes;
-    std::ostringstream key;
-    size_t loop_count = 0;
-    for (auto& input : inputs)
+// How many successively larger buckets call_bucketed looks at for an already compiled
+// executable before settling for the fallback of background compilation.
+static const size_t s_max_larger_bucket_probes = 4;
+
+bool runtime::dynamic::DynamicExecutable::call_bucketed(
+    const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+    const std::vector<std::shared_ptr<runtime::Tensor>>& inputs)
+{
+    NGRAPH_CHECK(m_wrapped_function->get_parameters().size() == inputs.size());
+
+    std::vector<Shape> bucketed_shapes;
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        bucketed_shapes.push_back(m_bucket_policy.get_bucketed_shape(i, inputs[i]->get_shape()));
+    }
+
+    // While a bucket compiles in the background its calls run on the fallback backend. An
+    // executable already compiled for a somewhat larger bucket is usually faster than that,
+    // despite the extra padding.
+    if (is_background_compilation_enabled() &&
+        !m_lru->is_cached(make_cache_key(inputs, bucketed_shapes)))
     {
-        if (m_wrapped_function->get_parameters()[loop_count]->is_relevant_to_shapes())
+        std::vector<Shape> larger_shapes(bucketed_shapes);
+        for (size_t probe = 0; probe < s_max_larger_bucket_probes; probe++)
         {
-            // Caching on values of Shape relevant inputs
-            int size = input->get_size_in_bytes() / (input->get_element_type().bitwidth() / 8);
-            std::vector<int64_t> data(size);
-            input->read(data.data(), input->get_size_in_bytes());
-            for (int i = 0; i < input->get_element_count(); i++)
+            bool grown = false;
+            for (size_t i = 0; i < larger_shapes.size(); i++)
+            {
+                for (size_t axis = 0; axis < larger_shapes[i].size(); axis++)
+                {
+                    size_t bucket =
+                        m_bucket_policy.get_larger_bucket(i, axis, larger_shapes[i][axis]);
+                    grown = grown || bucket != larger_shapes[i][axis];
+                    larger_shapes[i][axis] = bucket;
+                }
+            }
+            if (!grown)
+            {
+                break;
+            }
+            if (m_lru->is_cached(make_cache_key(inputs, larger_shapes)))
             {
-                merged_input_shapes.emplace_back(data[i]);
+                // The exact bucket still gets compiled, and takes over once it is cached.
+                queue_compilation(inputs, bucketed_shapes);
+                bucketed_shapes = larger_shapes;
+                break;
             }
         }
-        else
+    }
+
+    std::vector<std::shared_ptr<runtime::Tensor>> bucketed_inputs;
+    // Padded inputs are written straight into memory that their wrapped tensors then use
+    std::vector<AlignedBuffer> padded_buffers;
+    bool any_padded = false;
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        const Shape& bucketed_shape = bucketed_shapes[i];
+        if (bucketed_shape == inputs[i]->get_shape())
+        {
+            bucketed_inputs.push_back(inputs[i]);
+            continue;
+        }
+
+        const auto& parameter = m_wrapped_function->get_parameters()[i];
+        NGRAPH_CHECK(!parameter->is_relevant_to_shapes(),
+                     "Cannot bucket parameter ",
+                     i,
+                     " because its value is relevant to shapes");
+        NGRAPH_CHECK(parameter->get_output_partial_shape(0).relaxes(bucketed_shape),
+                     "Bucketed shape ",
+                     bucketed_shape,
+                     " of parameter ",
+                     i,
+                     " is incompatible with ",
+                     parameter->get_output_partial_shape(0));
+
+        const element::Type& element_type = inputs[i]->get_element_type();
+        padded_buffers.emplace_back(shape_size(bucketed_shape) * element_type.size());
+        char* padded = padded_buffers.back().get_ptr<char>();
+        pad_tensor(*inputs[i], bucketed_shape, padded);
+        bucketed_inputs.push_back(
+            m_wrapped_backend->create_tensor(element_type, bucketed_shape, padded));
+        any_padded = true;
+    }
+
+    if (!any_padded)
+    {
+        return call_specialized(outputs, inputs);
+    }
+
+    // Results that get sliced are produced into temporaries of the bucketed size first.
+    std::vector<std::shared_ptr<runtime::Tensor>> bucketed_outputs(outputs);
+    for (const BucketPolicy::OutputSlice& output_slice : m_bucket_policy.get_output_slices())
+    {
+        NGRAPH_CHECK(output_slice.m_result_index < outputs.size() &&
+                         output_slice.m_parameter_index < inputs.size(),
+                     "Bucket policy refers to a result or parameter that does not exist");
+        bucketed_outputs[output_slice.m_result_index] = make_shared<DynamicTensor>(
+            element::dynamic, PartialShape::dynamic(), m_wrapped_backend);
+    }
+
+    bool result = call_specialized(bucketed_outputs, bucketed_inputs);
+
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        if (bucketed_outputs[i] == outputs[i])
         {
-            // Caching on all remaining shapes
-            for (int i = 0; i < input->get_shape().size(); i++)
+            continue;
+        }
+        const runtime::Tensor& bucketed_output = *bucketed_outputs[i];
+        Shape shape = bucketed_output.get_shape();
+        for (const BucketPolicy::OutputSlice& output_slice :
+             m_bucket_policy.get_output_slices())
+        {
+            if (output_slice.m_result_index == i)
             {
-                merged_input_shapes.emplace_back(input->get_shape()[i]);
+                NGRAPH_CHECK(output_slice.m_result_axis < shape.size() &&
+                                 output_slice.m_parameter_axis <
+                                     inputs[output_slice.m_parameter_index]->get_shape().size(),
+                             "Bucket policy slice axis out of range");
+                size_t actual = inputs[output_slice.m_parameter_index]
+                                    ->get_shape()[output_slice.m_parameter_axis];
+                NGRAPH_CHECK(actual <= shape[output_slice.m_result_axis],
+                             "Result ",
+                             i,
+                             " is smaller than the dimension it is sliced to");
+                shape[output_slice.m_result_axis] = actual;
             }
         }
-        // -1 is the separator.
-        // So if shape of Input 1 = {2, 2, 3, 3} & Input 2 = {4, 5}
-        // the key would be 2, 2, 3, 3, -1, 4, 5, -1
-        merged_input_shapes.emplace_back(-1);
-        loop_count++;
+
+        if (auto dynamic_tensor =
+                std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(outputs[i]))
+        {
+            dynamic_tensor->make_storage(bucketed_output.get_element_type(), shape);
+        }
+        else
+        {
+            NGRAPH_CHECK(outputs[i]->get_shape() == shape,
+                         "Output ",
+                         i,
+                         " has shape ",
+                         outputs[i]->get_shape(),
+                         " but the sliced result has shape ",
+                         shape);
+        }
+        slice_tensor(bucketed_output, *outputs[i]);
     }
 
-    std::copy(merged_input_shapes.begin(),
-              merged_input_shapes.end(),
-              std::ostream_iterator<int>(key, ", "));
+    return result;
+}
+
+// Allocates storage for dynamic outputs according to the results of the specialized clone and
+// returns the static tensors the clone's executable writes to.
+static std::vector<std::shared_ptr<runtime::Tensor>>
+    prepare_outputs(const Function& clone,
+                    const std::vector<std::shared_ptr<runtime::Tensor>>& outputs)
+{
+    std::vector<std::shared_ptr<runtime::Tensor>> wrapped_outputs;
 
-    if (m_lru->is_cached(merged_input_shapes))
+    const ResultVector& results = clone.get_results();
+    for (auto& result : results)
     {
-        std::vector<std::shared_ptr<runtime::Tensor>> wrapped_inputs;
-        std::vector<std::shared_ptr<runtime::Tensor>> wrapped_outputs;
+        NGRAPH_CHECK(result->get_output_partial_shape(0).is_static(),
+                     "Shape staticization failed for result node ",
+                     *result);
+    }
+    NGRAPH_CHECK(results.size() == outputs.size());
 
-        std::shared_ptr<Function> clone = m_lru->get_cloned_function(merged_input_shapes);
-        const ResultVector& results = clone->get_results();
-        for (auto& result : results)
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        if (auto dynamic_tensor =
+                std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(outputs[i]))
         {
-            NGRAPH_CHECK(result->get_output_partial_shape(0).is_static(),
-                         "Shape staticization failed for result node ",
-                         *result);
+            dynamic_tensor->make_storage(results[i]->get_output_element_type(0),
+                                         results[i]->get_output_shape(0));
+            wrapped_outputs.push_back(dynamic_tensor->get_wrapped_tensor());
         }
-        NGRAPH_CHECK(results.size() == outputs.size());
+        else
+        {
+            wrapped_outputs.push_back(outputs[i]);
+        }
+    }
+    return wrapped_outputs;
+}
 
-        for (size_t i = 0; i < outputs.size(); i++)
+runtime::CacheKey runtime::dynamic::DynamicExecutable::make_cache_key(
+    const std::vector<std::shared_ptr<runtime::Tensor>>& inputs,
+    const std::vector<Shape>& shapes) const
+{
+    // We cache on:
+    // (1) all shapes;
+    // (2) all values of shape-relevant input tensors.
+    //
+    // Each input contributes its rank and dimensions, and for shape-relevant inputs also the
+    // byte count and the raw bytes packed into 64-bit words, so the encoding is unambiguous
+    // without separators. Inputs whose parameter has a dynamic element type also record the
+    // actual element type.
+    runtime::CacheKey key;
+    for (size_t input_index = 0; input_index < inputs.size(); input_index++)
+    {
+        const auto& input = inputs[input_index];
+        const auto& parameter = m_wrapped_function->get_parameters()[input_index];
+        if (parameter->get_element_type().is_dynamic())
         {
-            if (auto dynamic_tensor =
-                    std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(outputs[i]))
+            key.push_back(static_cast<int64_t>(
+                static_cast<element::Type_t>(input->get_element_type())));
+        }
+
+        const Shape& shape = shapes[input_index];
+        key.push_back(static_cast<int64_t>(shape.size()));
+        for (size_t d : shape)
+        {
+            key.push_back(static_cast<int64_t>(d));
+        }
+
+        if (parameter->is_relevant_to_shapes())
+        {
+            // Caching on values of Shape relevant inputs
+            size_t size_in_bytes = input->get_size_in_bytes();
+            std::array<int64_t, 16> small_buffer;
+            std::vector<int64_t> large_buffer;
+            int64_t* words = small_buffer.data();
+            size_t word_count = (size_in_bytes + sizeof(int64_t) - 1) / sizeof(int64_t);
+            if (word_count > small_buffer.size())
             {
-                dynamic_tensor->make_storage(results[i]->get_output_element_type(0),
-                                             results[i]->get_output_shape(0));
-                wrapped_outputs.push_back(dynamic_tensor->get_wrapped_tensor());
+                large_buffer.resize(word_count);
+                words = large_buffer.data();
             }
-            else
+            if (word_count > 0)
             {
-                wrapped_outputs.push_back(outputs[i]);
+                words[word_count - 1] = 0;
             }
-        }
+            input->read(words, size_in_bytes);
 
-        return m_lru->get_cached_entry(merged_input_shapes)->call(wrapped_outputs, inputs);
+            key.push_back(static_cast<int64_t>(size_in_bytes));
+            for (size_t i = 0; i < word_count; i++)
+            {
+                key.push_back(words[i]);
+            }
+        }
     }
-    else
+    return key;
+}
+
+bool runtime::dynamic::DynamicExecutable::call_specialized(
+    const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+    const std::vector<std::shared_ptr<runtime::Tensor>>& inputs)
+{
+    NGRAPH_CHECK(m_wrapped_function->get_parameters().size() == inputs.size());
+
+    std::vector<Shape> shapes;
+    shapes.reserve(inputs.size());
+    for (auto& input : inputs)
     {
-        NGRAPH_CHECK(m_wrapped_function->get_parameters().size() == inputs.size());
+        shapes.push_back(input->get_shape());
+    }
+    runtime::CacheKey key = make_cache_key(inputs, shapes);
 
-        std::vector<std::shared_ptr<runtime::Tensor>> wrapped_inputs;
-        std::vector<element::Type> arg_element_types;
-        std::vector<PartialShape> arg_shapes;
+    std::shared_ptr<Executable> cached_executable;
+    std::shared_ptr<Function> cached_clone;
+    bool cached = m_lru->get_entry(key, cached_executable, cached_clone);
 
-        std::shared_ptr<Function> clone;
+    // Background compilation needs somewhere to put its result.
+    bool compile_in_background = is_background_compilation_enabled() && m_lru->get_capacity() > 0;
+    std::shared_ptr<PendingCompilation> pending;
+    if (!cached && compile_in_background)
+    {
+        std::lock_guard<std::mutex> guard(m_pending_mutex);
+        auto it = m_pending.find(key);
+        if (it == m_pending.end())
         {
-            // We'll use AlignedBuffers to back the base pointers, storing them in this vector for
-            // RAII
-            // purposes.
-            std::vector<AlignedBuffer> arg_buffers;
-            arg_buffers.reserve(inputs.size());
-            std::vector<void*> arg_value_base_pointers(inputs.size());
+            // The compilation may have finished since the lookup above; it is cached before it
+            // stops being pending.
+            cached = m_lru->get_entry(key, cached_executable, cached_clone);
+        }
+        else if (it->second->m_failed)
+        {
+            m_pending.erase(it);
+            compile_in_background = false;
+        }
+        else
+        {
+            pending = it->second;
+        }
+    }
+
+    if (cached)
+    {
+        return cached_executable->call(prepare_outputs(*cached_clone, outputs), inputs);
+    }
+    if (pending)
+    {
+        return call_fallback(*pending, outputs, inputs);
+    }
 
-            size_t i = 0;
+    std::vector<std::shared_ptr<runtime::Tensor>> wrapped_inputs;
+    std::shared_ptr<Function> clone = specialize(get_specialization_args(inputs, wrapped_inputs));
 
-            for (auto& input : inputs)
-            {
-                if (m_wrapped_function->get_parameters()[i]->is_relevant_to_shapes())
-                {
-                    // TODO(amprocte): Move has_storage() to runtime::Tensor?
-                    if (auto dynamic_tensor =
-                            std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(input))
-                    {
-                        NGRAPH_CHECK(dynamic_tensor->has_storage());
-                    }
-
-                    arg_buffers.emplace_back(input->get_size_in_bytes(), /*alignment=*/64);
-                    arg_value_base_pointers[i] = arg_buffers.back().get_ptr();
-
-                    // TODO(amprocte): For host-resident tensors we should be able to skip the read,
-                    // but no API for that yet.
-                    input->read(arg_value_base_pointers[i], input->get_size_in_bytes());
-                }
-                else
-                {
-                    arg_value_base_pointers[i] = nullptr;
-                }
+    if (compile_in_background)
+    {
+        // Nothing compiled can serve this call, so it runs on the fallback, which is compiled
+        // here; the wrapped backend compiles on the background thread.
+        pending = make_shared<PendingCompilation>();
+        pending->m_clone = clone;
+        schedule_compilation(key, pending);
+        return call_fallback(*pending, outputs, wrapped_inputs);
+    }
 
-                if (auto dynamic_tensor =
-                        std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(input))
-                {
-                    NGRAPH_CHECK(dynamic_tensor->has_storage());
-                    arg_element_types.push_back(
-                        dynamic_tensor->get_wrapped_tensor()->get_element_type());
-                    arg_shapes.push_back(dynamic_tensor->get_wrapped_tensor()->get_shape());
-                    wrapped_inputs.push_back(dynamic_tensor->get_wrapped_tensor());
-                }
-                else
-                {
-                    arg_element_types.push_back(input->get_element_type());
-                    arg_shapes.push_back(input->get_shape());
-                    wrapped_inputs.push_back(input);
-                }
+    std::vector<std::shared_ptr<runtime::Tensor>> wrapped_outputs =
+        prepare_outputs(*clone, outputs);
+    auto compiled_executable = m_wrapped_backend->compile(clone, m_enable_performance_collection);
+    // Put compiled executable in the cache.
+    m_lru->add_entry(key, compiled_executable, clone);
+    add_compiled_executable(compiled_executable);
+    auto result = compiled_executable->call(wrapped_outputs, wrapped_inputs);
+
+    return result;
+}
+
+runtime::dynamic::DynamicExecutable::SpecializationArgs
+    runtime::dynamic::DynamicExecutable::get_specialization_args(
+        const std::vector<std::shared_ptr<runtime::Tensor>>& inputs,
+        std::vector<std::shared_ptr<runtime::Tensor>>& wrapped_inputs) const
+{
+    SpecializationArgs args;
+    args.m_values.reserve(inputs.size());
 
-                i++;
+    size_t i = 0;
+
+    for (auto& input : inputs)
+    {
+        if (m_wrapped_function->get_parameters()[i]->is_relevant_to_shapes())
+        {
+            // TODO(amprocte): Move has_storage() to runtime::Tensor?
+            if (auto dynamic_tensor =
+                    std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(input))
+            {
+                NGRAPH_CHECK(dynamic_tensor->has_storage());
             }
 
-            clone = specialize_function(
-                m_wrapped_function, arg_element_types, arg_shapes, arg_value_base_pointers);
+            args.m_values.emplace_back(input->get_size_in_bytes(), /*alignment=*/64);
+
+            // TODO(amprocte): For host-resident tensors we should be able to skip the read,
+            // but no API for that yet.
+            input->read(args.m_values.back().get_ptr(), input->get_size_in_bytes());
+        }
+        else
+        {
+            args.m_values.emplace_back();
         }
 
-        pass::Manager passes;
-        passes.register_pass<pass::ConstantFolding>();
-        passes.register_pass<pass::DynElimination>();
-        passes.register_pass<pass::Opset0Downgrade>(); // Converts dynamic v1 variants to v0 ops
-        passes.set_per_pass_validation(false);
+        if (auto dynamic_tensor =
+                std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(input))
+        {
+            NGRAPH_CHECK(dynamic_tensor->has_storage());
+            args.m_element_types.push_back(
+                dynamic_tensor->get_wrapped_tensor()->get_element_type());
+            args.m_shapes.push_back(dynamic_tensor->get_wrapped_tensor()->get_shape());
+            wrapped_inputs.push_back(dynamic_tensor->get_wrapped_tensor());
+        }
+        else
+        {
+            args.m_element_types.push_back(input->get_element_type());
+            args.m_shapes.push_back(input->get_shape());
+            wrapped_inputs.push_back(input);
+        }
 
-        // FIXME(amprocte): Vile, temporary hack: we need to do repeated rounds of
-        // ConstantFolding/DynElimination until everything that DynElimination is supposed to
-        // eliminate has actually been eliminated. We could do this by monitoring the return values
-        // of the passes (keep iterating until both CF and DE report no changes), but that did not
-        // seem to work so here we are. Probably a better fix is to somehow combine the matchers in
-        // CF
-        // and DE into one pass.
-        size_t num_dyn_nodes_last_pass = std::numeric_limits<size_t>::max();
+        i++;
+    }
+    return args;
+}
 
-        while (num_dyn_nodes_last_pass != 0)
+shared_ptr<Function>
+    runtime::dynamic::DynamicExecutable::specialize(const SpecializationArgs& args) const
+{
+    std::vector<void*> arg_value_base_pointers;
+    for (const AlignedBuffer& value : args.m_values)
+    {
+        arg_value_base_pointers.push_back(value.size() > 0 ? value.get_ptr(0) : nullptr);
+    }
+    std::shared_ptr<Function> clone = specialize_function(
+        m_wrapped_function, args.m_element_types, args.m_shapes, arg_value_base_pointers);
+
+    pass::Manager passes;
+    passes.register_pass<pass::ConstantFolding>();
+    passes.register_pass<pass::DynElimination>();
+    passes.register_pass<pass::Opset0Downgrade>(); // Converts dynamic v1 variants to v0 ops
+    passes.set_per_pass_validation(false);
+
+    // FIXME(amprocte): Vile, temporary hack: we need to do repeated rounds of
+    // ConstantFolding/DynElimination until everything that DynElimination is supposed to
+    // eliminate has actually been eliminated. We could do this by monitoring the return values
+    // of the passes (keep iterating until both CF and DE report no changes), but that did not
+    // seem to work so here we are. Probably a better fix is to somehow combine the matchers in
+    // CF
+    // and DE into one pass.
+    size_t num_dyn_nodes_last_pass = std::numeric_limits<size_t>::max();
+
+    while (num_dyn_nodes_last_pass != 0)
+    {
+        passes.run_passes(clone);
+        auto num_dyn_nodes_this_pass = count_dyn_nodes(clone);
+
+        NGRAPH_CHECK(num_dyn_nodes_this_pass < num_dyn_nodes_last_pass,
+                     "Could not eliminate all Dyn nodes (",
+                     num_dyn_nodes_this_pass,
+                     " remaining)");
+
+        num_dyn_nodes_last_pass = num_dyn_nodes_this_pass;
+    }
+
+    pass::Manager pass_val;
+    pass_val.register_pass<pass::Validate>();
+    pass_val.run_passes(clone);
+
+    return clone;
+}
+
+bool runtime::dynamic::DynamicExecutable::call_fallback(
+    PendingCompilation& pending,
+    const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+    const std::vector<std::shared_ptr<runtime::Tensor>>& inputs)
+{
+    // Compilations queued for a call that a larger bucket served have no fallback executable
+    // until a call of their own shape needs one.
+    std::shared_ptr<Function> clone;
+    std::shared_ptr<Executable> fallback_executable;
+    {
+        std::lock_guard<std::mutex> guard(pending.m_mutex);
+        if (!pending.m_clone)
+        {
+            pending.m_clone = specialize(pending.m_args);
+            pending.m_args = SpecializationArgs();
+        }
+        if (!pending.m_fallback_executable)
         {
-            passes.run_passes(clone);
-            auto num_dyn_nodes_this_pass = count_dyn_nodes(clone);
+            pending.m_fallback_executable = m_fallback_backend->compile(pending.m_clone);
+        }
+        clone = pending.m_clone;
+        fallback_executable = pending.m_fallback_executable;
+    }
+
+    // The fallback backend cannot be assumed to accept the wrapped backend's tensors, so the
+    // values are staged through tensors of its own.
+    std::vector<std::shared_ptr<runtime::Tensor>> wrapped_outputs =
+        prepare_outputs(*clone, outputs);
+    std::vector<std::shared_ptr<runtime::Tensor>> fallback_inputs;
+    std::vector<std::shared_ptr<runtime::Tensor>> fallback_outputs;
+    std::vector<char> buffer;
+    for (auto& input : inputs)
+    {
+        auto fallback_input =
+            m_fallback_backend->create_tensor(input->get_element_type(), input->get_shape());
+        buffer.resize(input->get_size_in_bytes());
+        input->read(buffer.data(), buffer.size());
+        fallback_input->write(buffer.data(), buffer.size());
+        fallback_inputs.push_back(fallback_input);
+    }
+    for (auto& output : wrapped_outputs)
+    {
+        fallback_outputs.push_back(
+            m_fallback_backend->create_tensor(output->get_element_type(), output->get_shape()));
+    }
+
+    bool result = fallback_executable->call(fallback_outputs, fallback_inputs);
+
+    for (size_t i = 0; i < wrapped_outputs.size(); i++)
+    {
+        buffer.resize(fallback_outputs[i]->get_size_in_bytes());
+        fallback_outputs[i]->read(buffer.data(), buffer.size());
+        wrapped_outputs[i]->write(buffer.data(), buffer.size());
+    }
+    return result;
+}
+
+void runtime::dynamic::DynamicExecutable::add_compiled_executable(
+    const shared_ptr<Executable>& executable)
+{
+    if (!m_enable_performance_collection)
+    {
+        return;
+    }
+    lock_guard<mutex> guard(m_compiled_executables_mutex);
+    // Forget the executables the cache has evicted since
+    m_compiled_executables.erase(remove_if(m_compiled_executables.begin(),
+                                           m_compiled_executables.end(),
+                                           [](const weak_ptr<Executable>& compiled) {
+                                               return compiled.expired();
+                                           }),
+                                 m_compiled_executables.end());
+    m_compiled_executables.push_back(executable);
+}
+
+vector<runtime::PerformanceCounter>
+    runtime::dynamic::DynamicExecutable::get_performance_data() const
+{
+    vector<PerformanceCounter> rc;
+    lock_guard<mutex> guard(m_compiled_executables_mutex);
+    for (const weak_ptr<Executable>& compiled : m_compiled_executables)
+    {
+        if (shared_ptr<Executable> executable = compiled.lock())
+        {
+            vector<PerformanceCounter> counters = executable->get_performance_data();
+            rc.insert(rc.end(), counters.begin(), counters.end());
+        }
+    }
+    return rc;
+}
+
+runtime::dynamic::DynamicExecutable::~DynamicExecutable()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_pending_mutex);
+        m_stop_compiling = true;
+        m_compile_queue.clear();
+    }
+    m_compile_queue_changed.notify_all();
+    if (m_compile_thread.joinable())
+    {
+        m_compile_thread.join();
+    }
+}
 
-            NGRAPH_CHECK(num_dyn_nodes_this_pass < num_dyn_nodes_last_pass,
-                         "Could not eliminate all Dyn nodes (",
-                         num_dyn_nodes_this_pass,
-                         " remaining)");
+void runtime::dynamic::DynamicExecutable::enable_background_compilation(
+    const std::string& fallback_backend)
+{
+    m_fallback_backend = runtime::Backend::create(fallback_backend);
+    NGRAPH_CHECK(m_fallback_backend != nullptr,
+                 "Fallback backend ",
+                 fallback_backend,
+                 " is not available");
+}
+
+void runtime::dynamic::DynamicExecutable::wait_for_background_compilation()
+{
+    std::unique_lock<std::mutex> lock(m_pending_mutex);
+    m_compile_queue_changed.wait(lock,
+                                 [this] { return m_compile_queue.empty() && !m_compiling; });
+}
 
-            num_dyn_nodes_last_pass = num_dyn_nodes_this_pass;
+void runtime::dynamic::DynamicExecutable::queue_compilation(
+    const std::vector<std::shared_ptr<runtime::Tensor>>& inputs, const std::vector<Shape>& shapes)
+{
+    if (m_lru->get_capacity() == 0)
+    {
+        return;
+    }
+    runtime::CacheKey key = make_cache_key(inputs, shapes);
+    {
+        std::lock_guard<std::mutex> guard(m_pending_mutex);
+        if (m_pending.find(key) != m_pending.end())
+        {
+            return;
         }
+    }
 
-        pass::Manager pass_val;
-        pass_val.register_pass<pass::Validate>();
-        pass_val.run_passes(clone);
+    // The background thread specializes the clone; this call is served by a larger bucket and
+    // needs neither the clone nor a fallback executable. Only the values of shape-relevant
+    // inputs, which are never bucketed, are copied, and the other inputs take the bucketed
+    // shapes.
+    std::vector<std::shared_ptr<runtime::Tensor>> wrapped_inputs;
+    auto pending = make_shared<PendingCompilation>();
+    pending->m_args = get_specialization_args(inputs, wrapped_inputs);
+    for (size_t i = 0; i < shapes.size(); i++)
+    {
+        pending->m_args.m_shapes[i] = shapes[i];
+    }
+    schedule_compilation(key, pending);
+}
 
-        std::vector<std::shared_ptr<runtime::Tensor>> wrapped_outputs;
+void runtime::dynamic::DynamicExecutable::schedule_compilation(
+    const runtime::CacheKey& key, std::shared_ptr<PendingCompilation> pending)
+{
+    std::lock_guard<std::mutex> guard(m_pending_mutex);
+    if (!m_pending.insert({key, pending}).second)
+    {
+        // A concurrent call with the same shapes got here first.
+        return;
+    }
+    m_compile_queue.push_back(key);
+    if (!m_compile_thread.joinable())
+    {
+        m_compile_thread = std::thread(&DynamicExecutable::compile_in_background, this);
+    }
+    m_compile_queue_changed.notify_all();
+}
 
-        const ResultVector& results = clone->get_results();
-        for (auto& result : results)
+void runtime::dynamic::DynamicExecutable::compile_in_background()
+{
+    std::unique_lock<std::mutex> lock(m_pending_mutex);
+    while (true)
+    {
+        m_compile_queue_changed.wait(
+            lock, [this] { return m_stop_compiling || !m_compile_queue.empty(); });
+        if (m_stop_compiling)
         {
-            NGRAPH_CHECK(result->get_output_partial_shape(0).is_static(),
-                         "Shape staticization failed for result node ",
-                         *result);
+            return;
         }
-        NGRAPH_CHECK(results.size() == outputs.size());
+        runtime::CacheKey key = m_compile_queue.front();
+        m_compile_queue.pop_front();
+        std::shared_ptr<PendingCompilation> pending = m_pending.at(key);
+        m_compiling = true;
+        lock.unlock();
 
-        for (size_t i = 0; i < outputs.size(); i++)
+        std::shared_ptr<Executable> executable;
+        try
         {
-            if (auto dynamic_tensor =
-                    std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(outputs[i]))
+            std::shared_ptr<Function> function;
             {
-                dynamic_tensor->make_storage(results[i]->get_output_element_type(0),
-                                             results[i]->get_output_shape(0));
-                wrapped_outputs.push_back(dynamic_tensor->get_wrapped_tensor());
-            }
-            else
-            {
-                wrapped_outputs.push_back(outputs[i]);
+                std::lock_guard<std::mutex> guard(pending->m_mutex);
+                if (!pending->m_clone)
+                {
+                    pending->m_clone = specialize(pending->m_args);
+                    pending->m_args = SpecializationArgs();
+                }
+                // Backends may rewrite the function they compile, and calls on the fallback
+                // keep reading the pending clone meanwhile, so compile a copy.
+                function = clone_function(*pending->m_clone);
             }
+            executable = m_wrapped_backend->compile(function, m_enable_performance_collection);
+            m_lru->add_entry(key, executable, function);
+            add_compiled_executable(executable);
+        }
+        catch (const std::exception& e)
+        {
+            NGRAPH_WARN << "Background compilation failed: " << e.what();
         }
 
-        auto compiled_executable =
-            m_wrapped_backend->compile(clone, m_enable_performance_collection);
-        // Put compiled executable in the cache.
-        m_lru->add_entry(merged_input_shapes, compiled_executable, clone);
-        auto result = compiled_executable->call(wrapped_outputs, wrapped_inputs);
-
-        return result;
+        lock.lock();
+        m_compiling = false;
+        if (executable)
+        {
+            m_pending.erase(key);
+        }
+        else
+        {
+            pending->m_failed = true;
+        }
+        m_compile_queue_changed.notify_all();
     }
 }
 
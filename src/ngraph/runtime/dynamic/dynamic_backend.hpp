@@ -16,11 +16,17 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
+#include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/backend.hpp"
 #include "ngraph/runtime/cache.hpp"
 #include "ngraph/runtime/host_tensor.hpp"
@@ -32,6 +38,7 @@ namespace ngraph
     {
         namespace dynamic
         {
+            class BucketPolicy;
             class DynamicBackend;
             class DynamicExecutable;
             class DynamicTensor;
@@ -75,6 +82,65 @@ private:
     std::shared_ptr<ngraph::runtime::Backend> m_wrapped_backend;
 };
 
+///
+/// \brief Opt-in policy that bounds how many distinct shapes a DynamicExecutable compiles for.
+///
+/// Selected parameter dimensions are rounded up to a bucket (the next power of two, or the next
+/// of a list of boundaries). The inputs are zero-padded to the bucketed shape, the executable
+/// specialized for that shape runs, and selected result dimensions are sliced back to the size
+/// of the parameter dimension they follow. This is only correct for graphs whose sliced
+/// results do not depend on the padding, e.g. when every position along the bucketed axis is
+/// computed independently (elementwise ops, per-token layers, masked attention).
+///
+/// Shape-relevant parameters (whose values determine shapes) cannot be bucketed.
+///
+class ngraph::runtime::dynamic::BucketPolicy
+{
+public:
+    /// \brief Round dimension `axis` of parameter `parameter_index` up to a power of two that
+    ///        is at least `min_size`, which is itself rounded up to a power of two.
+    void add_power_of_two(size_t parameter_index, size_t axis, size_t min_size = 1);
+    /// \brief Round dimension `axis` of parameter `parameter_index` up to the smallest of
+    ///        `boundaries` that is not below it. Larger sizes are left as they are.
+    void add_boundaries(size_t parameter_index, size_t axis, std::vector<size_t> boundaries);
+    /// \brief Slice dimension `result_axis` of result `result_index` back to the actual size
+    ///        of dimension `parameter_axis` of parameter `parameter_index`.
+    void add_output_slice(size_t result_index,
+                          size_t result_axis,
+                          size_t parameter_index,
+                          size_t parameter_axis);
+
+    bool empty() const { return m_rules.empty(); }
+    /// \brief The bucketed size of the given parameter dimension.
+    size_t get_bucket(size_t parameter_index, size_t axis, size_t size) const;
+    /// \brief The shape parameter `parameter_index` is padded to.
+    Shape get_bucketed_shape(size_t parameter_index, const Shape& shape) const;
+    /// \brief The smallest bucket of the given parameter dimension that is larger than
+    ///        `bucket`, or `bucket` itself if there is none.
+    size_t get_larger_bucket(size_t parameter_index, size_t axis, size_t bucket) const;
+
+    struct OutputSlice
+    {
+        size_t m_result_index;
+        size_t m_result_axis;
+        size_t m_parameter_index;
+        size_t m_parameter_axis;
+    };
+    const std::vector<OutputSlice>& get_output_slices() const { return m_output_slices; }
+
+private:
+    struct Rule
+    {
+        size_t m_parameter_index;
+        size_t m_axis;
+        size_t m_min_size;
+        // Empty for power-of-two rounding.
+        std::vector<size_t> m_boundaries;
+    };
+    std::vector<Rule> m_rules;
+    std::vector<OutputSlice> m_output_slices;
+};
+
 ///
 /// \brief Wrapper class used to provide an Executable that supports dynamic
 ///        tensors on top of a backend that does not support dynamic tensors
@@ -87,6 +153,12 @@ private:
 /// 2. compiles the clone using the wrapped backend;
 /// 3. fowards the input tensors to the clone executable for actual execution.
 ///
+/// With background compilation enabled, step 2 is moved off the calling thread: a cache miss
+/// queues the compilation of the clone and serves the call from a fallback instead, either the
+/// executable of a larger bucket that is already cached (when a BucketPolicy is set) or the
+/// clone compiled on a cheap fallback backend. Once the background compilation finishes, its
+/// executable is cached and used for all later calls with that shape.
+///
 /// `DynamicExecutable` objects are produced by `DynamicBackend::compile()`.
 ///
 class ngraph::runtime::dynamic::DynamicExecutable : public ngraph::runtime::Executable
@@ -95,15 +167,99 @@ public:
     DynamicExecutable(std::shared_ptr<Function> wrapped_function,
                       std::shared_ptr<ngraph::runtime::Backend> wrapped_backend,
                       bool enable_performance_collection = false);
+    ~DynamicExecutable() override;
     virtual bool call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                       const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) override;
 
+    /// \brief Enables shape bucketing; see BucketPolicy. Must not be called concurrently with
+    ///        call().
+    void set_bucket_policy(const BucketPolicy& policy);
+    const BucketPolicy& get_bucket_policy() const { return m_bucket_policy; }
+    /// \brief Number of shape-specialized executables currently cached.
+    size_t get_cached_executable_count() const { return m_lru->size(); }
+    /// \brief Compiles cache misses on a background thread; until a compilation finishes,
+    ///        calls for that shape run on a fallback (see the class description).
+    /// \param fallback_backend Name of the backend the clone is compiled on while the wrapped
+    ///        backend compiles it in the background. Should be much cheaper to compile for than
+    ///        the wrapped backend.
+    ///
+    /// Must not be called concurrently with call().
+    void enable_background_compilation(const std::string& fallback_backend = "INTERPRETER");
+    bool is_background_compilation_enabled() const { return m_fallback_backend != nullptr; }
+    /// \brief Blocks until every queued background compilation has finished.
+    void wait_for_background_compilation();
+    /// \brief Performance data of the shape-specialized executables that are still cached.
+    ///        Their counters refer to the nodes of the specialized clones.
+    std::vector<PerformanceCounter> get_performance_data() const override;
+
 private:
+    // What specializing the wrapped function for one call depends on
+    struct SpecializationArgs
+    {
+        std::vector<element::Type> m_element_types;
+        std::vector<PartialShape> m_shapes;
+        // Copies of the values of shape-relevant inputs; empty for the other inputs
+        std::vector<AlignedBuffer> m_values;
+    };
+
+    struct PendingCompilation
+    {
+        // Guards m_args, m_clone and m_fallback_executable, which calls of this shape and the
+        // background compile thread both fill in as they need them.
+        std::mutex m_mutex;
+        // Used to specialize m_clone when it was not specialized on the calling thread
+        SpecializationArgs m_args;
+        std::shared_ptr<Function> m_clone;
+        std::shared_ptr<Executable> m_fallback_executable;
+        // Set if compiling on the wrapped backend threw; the next miss compiles in the
+        // foreground so that the error reaches the caller.
+        bool m_failed = false;
+    };
+
+    bool call_specialized(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                          const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
+    bool call_bucketed(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                       const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
+    bool call_fallback(PendingCompilation& pending,
+                       const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                       const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
+    runtime::CacheKey make_cache_key(const std::vector<std::shared_ptr<runtime::Tensor>>& inputs,
+                                     const std::vector<Shape>& shapes) const;
+    SpecializationArgs get_specialization_args(
+        const std::vector<std::shared_ptr<runtime::Tensor>>& inputs,
+        std::vector<std::shared_ptr<runtime::Tensor>>& wrapped_inputs) const;
+    std::shared_ptr<Function> specialize(const SpecializationArgs& args) const;
+    // Compiles the executable for `shapes` in the background, unless it is already pending
+    void queue_compilation(const std::vector<std::shared_ptr<runtime::Tensor>>& inputs,
+                           const std::vector<Shape>& shapes);
+    void schedule_compilation(const runtime::CacheKey& key,
+                              std::shared_ptr<PendingCompilation> pending);
+    void compile_in_background();
+    void add_compiled_executable(const std::shared_ptr<Executable>& executable);
+
     std::shared_ptr<ngraph::Function> m_wrapped_function;
     std::shared_ptr<ngraph::runtime::Backend> m_wrapped_backend;
     std::shared_ptr<ngraph::runtime::LRUCache> m_lru =
         std::make_shared<ngraph::runtime::LRUCache>();
     bool m_enable_performance_collection;
+    BucketPolicy m_bucket_policy;
+    // Executables compiled with performance collection, for get_performance_data
+    std::vector<std::weak_ptr<Executable>> m_compiled_executables;
+    mutable std::mutex m_compiled_executables_mutex;
+
+    std::shared_ptr<ngraph::runtime::Backend> m_fallback_backend;
+    // Clones whose compilation is queued or running, by cache key. Guarded by m_pending_mutex,
+    // as are the queue and the worker state below.
+    std::unordered_map<runtime::CacheKey,
+                       std::shared_ptr<PendingCompilation>,
+                       runtime::CacheKey::Hash>
+        m_pending;
+    std::deque<runtime::CacheKey> m_compile_queue;
+    bool m_compiling = false;
+    bool m_stop_compiling = false;
+    std::mutex m_pending_mutex;
+    std::condition_variable m_compile_queue_changed;
+    std::thread m_compile_thread;
 };
 
 ///
@@ -21,11 +21,13 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "ngraph/ops.hpp"
 #include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/gcpu/kernel/dot.hpp"
 #include "ngraph/runtime/host_tensor.hpp"
 #include "ngraph/runtime/interpreter/int_executable.hpp"
 #include "ngraph/runtime/opt_kernel/broadcast.hpp"
@@ -68,18 +70,66 @@ public:
     GCPUExecutable(const std::shared_ptr<Function>& function,
                    bool enable_performance_collection = false);
 
-    bool call(const std::vector<std::shared_ptr<Tensor>>& outputs,
-              const std::vector<std::shared_ptr<Tensor>>& intputs) override;
-
 private:
     int get_alignment() const { return 64; }
-    void generate_calls(const element::Type& type,
-                        const Node& op,
-                        const std::vector<std::shared_ptr<HostTensor>>& outputs,
-                        const std::vector<std::shared_ptr<HostTensor>>& inputs) override;
+    Kernel get_kernel(const element::Type& type) const override;
+    std::shared_ptr<INTExecutable>
+        compile_loop_body(const std::shared_ptr<Function>& body) const override;
+
+    template <typename T>
+    void dot_engine(ngraph::runtime::interpreter::OP_TYPEID type_id,
+                    const Node& node,
+                    const std::vector<std::shared_ptr<HostTensor>>& out,
+                    const std::vector<std::shared_ptr<HostTensor>>& args,
+                    std::true_type /* is_eigen_dot_type */)
+    {
+        if (type_id == ngraph::runtime::interpreter::OP_TYPEID::BatchMatMul)
+        {
+            const Shape& arg0_shape = node.get_input_shape(0);
+            const Shape& arg1_shape = node.get_input_shape(1);
+            const Shape& out_shape = node.get_output_shape(0);
+            const Shape dot_input0_shape{arg0_shape[1], arg0_shape[2]};
+            const Shape dot_input1_shape{arg1_shape[1], arg1_shape[2]};
+            const Shape dot_output_shape{out_shape[1], out_shape[2]};
+            const size_t input0_offset = shape_size(dot_input0_shape);
+            const size_t input1_offset = shape_size(dot_input1_shape);
+            const size_t output_offset = shape_size(dot_output_shape);
+            for (size_t i = 0; i < arg0_shape[0]; ++i)
+            {
+                kernel::dot<T>(args[0]->get_data_ptr<const T>() + i * input0_offset,
+                               args[1]->get_data_ptr<const T>() + i * input1_offset,
+                               out[0]->get_data_ptr<T>() + i * output_offset,
+                               dot_input0_shape,
+                               dot_input1_shape,
+                               dot_output_shape,
+                               1);
+            }
+            return;
+        }
+        const op::Dot* dot = static_cast<const op::Dot*>(&node);
+        kernel::dot<T>(args[0]->get_data_ptr<const T>(),
+                       args[1]->get_data_ptr<const T>(),
+                       out[0]->get_data_ptr<T>(),
+                       node.get_input_shape(0),
+                       node.get_input_shape(1),
+                       node.get_output_shape(0),
+                       dot->get_reduction_axes_count());
+    }
+
+    // Other element types, such as bool, run the reference kernels
+    template <typename T>
+    void dot_engine(ngraph::runtime::interpreter::OP_TYPEID type_id,
+                    const Node& node,
+                    const std::vector<std::shared_ptr<HostTensor>>& out,
+                    const std::vector<std::shared_ptr<HostTensor>>& args,
+                    std::false_type /* is_eigen_dot_type */)
+    {
+        op_engine<T>(type_id, node, out, args);
+    }
 
     template <typename T>
-    void gop_engine(const Node& node,
+    void gop_engine(ngraph::runtime::interpreter::OP_TYPEID type_id,
+                    const Node& node,
                     const std::vector<std::shared_ptr<HostTensor>>& out,
                     const std::vector<std::shared_ptr<HostTensor>>& args)
     {
@@ -87,7 +137,7 @@ private:
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wswitch-enum"
 #endif
-        switch (INTExecutable::get_typeid(node))
+        switch (type_id)
         {
         case ngraph::runtime::interpreter::OP_TYPEID::Broadcast:
         {
@@ -102,6 +152,10 @@ private:
                                     broadcast_axes);
             break;
         }
+        case ngraph::runtime::interpreter::OP_TYPEID::BatchMatMul:
+        case ngraph::runtime::interpreter::OP_TYPEID::Dot:
+            dot_engine<T>(type_id, node, out, args, kernel::is_eigen_dot_type<T>());
+            break;
         case ngraph::runtime::interpreter::OP_TYPEID::Reshape:
         {
             const op::Reshape* reshape = static_cast<const op::Reshape*>(&node);
@@ -112,7 +166,7 @@ private:
                                node.get_output_shape(0));
             break;
         }
-        default: op_engine<T>(node, out, args); break;
+        default: op_engine<T>(type_id, node, out, args); break;
         }
 #if defined(__GNUC__) && !(__GNUC__ == 4 && __GNUC_MINOR__ == 8)
 #pragma GCC diagnostic pop
@@ -61,7 +61,10 @@ shared_ptr<runtime::Executable>
     runtime::interpreter::INTBackend::compile(shared_ptr<Function> function,
                                               bool enable_performance_collection)
 {
-    return make_shared<INTExecutable>(function, enable_performance_collection);
+    return compile_with_disk_cache(
+        "INTERPRETER", function, nullptr, enable_performance_collection, [&]() {
+            return make_shared<INTExecutable>(function, enable_performance_collection);
+        });
 }
 
 bool runtime::interpreter::INTBackend::is_supported(const Node& node) const
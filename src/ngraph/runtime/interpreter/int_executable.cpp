@@ -14,17 +14,23 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <cstring>
+
 #include "ngraph/runtime/interpreter/int_executable.hpp"
 #include "ngraph/cpio.hpp"
 #include "ngraph/descriptor/layout/dense_tensor_layout.hpp"
+#include "ngraph/env_util.hpp"
 #include "ngraph/except.hpp"
 #include "ngraph/ops.hpp"
 #include "ngraph/pass/assign_layout.hpp"
 #include "ngraph/pass/core_fusion.hpp"
+#include "ngraph/pass/elementwise_fusion.hpp"
 #include "ngraph/pass/fused_op_decomposition.hpp"
 #include "ngraph/pass/like_replacement.hpp"
 #include "ngraph/pass/liveness.hpp"
+#include "ngraph/pass/lstm_sequence_to_tensor_iterator.hpp"
 #include "ngraph/pass/manager.hpp"
+#include "ngraph/pass/memory_layout.hpp"
 #include "ngraph/pass/opset0_downgrade.hpp"
 #include "ngraph/runtime/backend_manager.hpp"
 #include "ngraph/runtime/chrome_trace.hpp"
@@ -36,6 +42,57 @@ using namespace ngraph;
 
 using descriptor::layout::DenseTensorLayout;
 
+// Elements per block of a fused kernel, small enough for the buffers of a chain to stay in L2
+static const size_t s_fused_block_size = 4096;
+
+// Half-precision tensors are stored as they are and computed on in f32
+static bool is_half(const element::Type& type)
+{
+    return type == element::f16 || type == element::bf16;
+}
+
+static element::Type widened(const element::Type& type)
+{
+    return is_half(type) ? element::f32 : type;
+}
+
+static void widen(const element::Type& type, const void* source, float* target, size_t count)
+{
+    if (type == element::f16)
+    {
+        float16::to_float(static_cast<const float16*>(source), target, count);
+    }
+    else
+    {
+        bfloat16::to_float(static_cast<const bfloat16*>(source), target, count);
+    }
+}
+
+static void narrow(const element::Type& type, const float* source, void* target, size_t count)
+{
+    if (type == element::f16)
+    {
+        float16::from_float(source, static_cast<float16*>(target), count);
+    }
+    else
+    {
+        bfloat16::from_float(source, static_cast<bfloat16*>(target), count);
+    }
+}
+
+// Ops that only move elements around, which they can do on the bits of any 2 byte type
+static bool moves_elements(runtime::interpreter::OP_TYPEID type_id)
+{
+    using runtime::interpreter::OP_TYPEID;
+    return type_id == OP_TYPEID::Broadcast || type_id == OP_TYPEID::Concat ||
+           type_id == OP_TYPEID::Gather || type_id == OP_TYPEID::GatherND ||
+           type_id == OP_TYPEID::GetOutputElement || type_id == OP_TYPEID::Pad ||
+           type_id == OP_TYPEID::ReplaceSlice || type_id == OP_TYPEID::Reshape ||
+           type_id == OP_TYPEID::Result || type_id == OP_TYPEID::Reverse ||
+           type_id == OP_TYPEID::ReverseSequence || type_id == OP_TYPEID::Select ||
+           type_id == OP_TYPEID::Slice;
+}
+
 runtime::interpreter::OP_TYPEID runtime::interpreter::INTExecutable::get_typeid(const Node& node)
 {
     const NodeTypeInfo& type_info = node.get_type_info();
@@ -62,6 +119,7 @@ runtime::interpreter::INTExecutable::INTExecutable(const shared_ptr<Function>& f
                                                    bool enable_performance_collection)
     : m_is_compiled{true}
     , m_performance_counters_enabled{enable_performance_collection}
+    , m_thread_count{static_cast<size_t>(max(getenv_int("NGRAPH_INTERPRETER_THREADS", 1), 1))}
 {
 #ifdef INTERPRETER_FORCE_SERIALIZE
     // To verify that the serializer works correctly let's just run this graph round-trip
@@ -70,32 +128,387 @@ runtime::interpreter::INTExecutable::INTExecutable(const shared_ptr<Function>& f
 #else
     m_function = clone_function(*function);
 #endif
+    // TensorIterator bodies run as loops, so sequences don't have to be unrolled
+    auto is_loop = [](const Node& node) { return is_type<op::TensorIterator>(&node); };
     pass::Manager pass_manager;
     pass_manager.register_pass<pass::LikeReplacement>();
-    pass_manager.register_pass<pass::FusedOpDecomposition>();
+    pass_manager.register_pass<pass::LSTMSequenceToTensorIterator>();
+    pass_manager.register_pass<pass::FusedOpDecomposition>(is_loop);
     pass_manager.register_pass<pass::Opset0Downgrade>();
     // Need to decompose any v0 fused ops, which were produced by the downgrade pass
-    pass_manager.register_pass<pass::FusedOpDecomposition>();
+    pass_manager.register_pass<pass::FusedOpDecomposition>(is_loop);
+    if (getenv_int("NGRAPH_INTERPRETER_FUSION", 1) != 0)
+    {
+        pass_manager.register_pass<pass::ElementwiseFusion>();
+    }
     pass_manager.register_pass<pass::AssignLayout<DenseTensorLayout>>();
     pass_manager.register_pass<pass::Liveness>();
+    // Buffer reuse is planned for the sequential op order, so it must be turned off when
+    // independent ops may run concurrently
+    pass_manager.register_pass<pass::MemoryLayout>(get_alignment(), m_thread_count > 1);
     pass_manager.run_passes(m_function);
     for (auto node : m_function->get_ordered_ops())
     {
         m_nodes.push_back(node);
     }
     set_parameters_and_results(*m_function);
+    build_memory_plan();
 }
 
 runtime::interpreter::INTExecutable::INTExecutable(const std::string& model_string)
     : m_is_compiled{true}
     , m_performance_counters_enabled{false}
+    , m_thread_count{static_cast<size_t>(max(getenv_int("NGRAPH_INTERPRETER_THREADS", 1), 1))}
 {
     m_function = deserialize(model_string);
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::AssignLayout<DenseTensorLayout>>();
+    pass_manager.register_pass<pass::Liveness>();
+    // Buffer reuse is planned for the sequential op order, so it must be turned off when
+    // independent ops may run concurrently
+    pass_manager.register_pass<pass::MemoryLayout>(get_alignment(), m_thread_count > 1);
+    pass_manager.run_passes(m_function);
     for (auto node : m_function->get_ordered_ops())
     {
         m_nodes.push_back(node);
     }
     set_parameters_and_results(*m_function);
+    build_memory_plan();
+}
+
+void runtime::interpreter::INTExecutable::build_memory_plan()
+{
+    m_memory_pool_size = m_function->get_temporary_pool_size();
+    if (m_thread_count > 1)
+    {
+        m_thread_pool = ThreadPool::get_shared(m_thread_count);
+    }
+
+    // Constants are never written by a kernel so their outputs can alias the constant data
+    // directly instead of being copied into the arena on every call.
+    for (auto node : m_nodes)
+    {
+        if (auto constant = as_type_ptr<op::Constant>(node))
+        {
+            descriptor::Tensor* tensor = &constant->output(0).get_tensor();
+            m_constant_tensors[tensor] =
+                make_shared<runtime::HostTensor>(constant->get_element_type(),
+                                                 constant->get_shape(),
+                                                 const_cast<void*>(constant->get_data_ptr()),
+                                                 tensor->get_name());
+        }
+    }
+}
+
+void runtime::interpreter::INTExecutable::build_call_steps()
+{
+    unordered_map<descriptor::Tensor*, pair<size_t, bool>> external_tensors;
+    size_t input_count = 0;
+    for (auto param : get_parameters())
+    {
+        for (size_t i = 0; i < param->get_output_size(); ++i)
+        {
+            external_tensors[&param->output(i).get_tensor()] = {input_count++, false};
+        }
+    }
+    for (size_t output_count = 0; output_count < get_results().size(); ++output_count)
+    {
+        auto output = get_results()[output_count];
+        if (!is_type<op::Result>(output))
+        {
+            throw ngraph_error("One of function's outputs isn't op::Result");
+        }
+        external_tensors[&output->output(0).get_tensor()] = {output_count, true};
+    }
+
+    unordered_map<descriptor::Tensor*, size_t> tensor_producers;
+    unordered_map<const Node*, size_t> node_steps;
+    for (auto op : m_nodes)
+    {
+        if (op->is_parameter() || op->is_constant())
+        {
+            continue;
+        }
+        size_t step_index = m_call_steps.size();
+        node_steps[op.get()] = step_index;
+        CallStep step;
+        step.m_node = op;
+        step.m_type_id = get_typeid(*op);
+        step.m_type = get_dispatch_type(*op, step.m_type_id);
+        step.m_kernel = get_kernel(step.m_type);
+        step.m_timer = m_performance_counters_enabled ? &m_timer_map[op] : nullptr;
+        step.m_trace_name =
+            make_shared<runtime::event::Recorder::Name>(op->get_name(), "Interpreter");
+        if (auto kernel = as_type_ptr<op::CompiledKernel>(op))
+        {
+            step.m_fused_kernel = build_fused_kernel(*kernel);
+        }
+        if (auto tensor_iterator = as_type_ptr<op::TensorIterator>(op))
+        {
+            step.m_loop = build_loop(*tensor_iterator);
+        }
+        step.m_start_step = 0;
+        if (is_type<op::AllReduceWait>(op))
+        {
+            step.m_start_step = node_steps.at(op->get_input_node_ptr(0));
+        }
+        step.m_widened = false;
+        if (!step.m_fused_kernel && !step.m_loop)
+        {
+            if (is_half(step.m_type) && moves_elements(step.m_type_id))
+            {
+                step.m_kernel = get_kernel(element::u16);
+            }
+            else
+            {
+                for (size_t i = 0; i < op->get_input_size(); ++i)
+                {
+                    if (is_half(op->get_input_element_type(i)))
+                    {
+                        step.m_widened_inputs.push_back(i);
+                    }
+                }
+                // Convert writes half-precision outputs itself
+                for (size_t i = 0; i < op->get_output_size() && !is_type<op::Convert>(op); ++i)
+                {
+                    if (is_half(op->get_output_element_type(i)))
+                    {
+                        step.m_widened_outputs.push_back(i);
+                    }
+                }
+                step.m_widened =
+                    !step.m_widened_inputs.empty() || !step.m_widened_outputs.empty();
+                if (step.m_widened)
+                {
+                    step.m_type = widened(step.m_type);
+                    step.m_kernel = get_kernel(step.m_type);
+                }
+            }
+        }
+        for (auto input : op->inputs())
+        {
+            descriptor::Tensor* tensor = &input.get_tensor();
+            auto it = external_tensors.find(tensor);
+            if (it != external_tensors.end())
+            {
+                m_external_bindings.push_back(
+                    {it->second.first, it->second.second, step_index, step.m_inputs.size()});
+            }
+            step.m_inputs.push_back(tensor);
+        }
+        for (size_t i = 0; i < op->get_output_size(); ++i)
+        {
+            descriptor::Tensor* tensor = &op->output(i).get_tensor();
+            auto it = external_tensors.find(tensor);
+            if (it != external_tensors.end())
+            {
+                m_external_bindings.push_back(
+                    {it->second.first, it->second.second, step_index, step.m_outputs.size()});
+            }
+            step.m_outputs.push_back(tensor);
+            tensor_producers[tensor] = step_index;
+        }
+        m_call_steps.push_back(step);
+    }
+
+    // Dependency graph for the parallel scheduler
+    m_step_successors.resize(m_call_steps.size());
+    m_step_dependency_counts.resize(m_call_steps.size());
+    // Every rank must issue its collectives in the same order, so they are chained
+    bool have_collective = false;
+    size_t last_collective = 0;
+    for (size_t i = 0; i < m_call_steps.size(); ++i)
+    {
+        set<size_t> predecessors;
+        OP_TYPEID type_id = m_call_steps[i].m_type_id;
+        if (type_id == OP_TYPEID::AllReduce || type_id == OP_TYPEID::AllReduceStart ||
+            type_id == OP_TYPEID::BroadcastDistributed || type_id == OP_TYPEID::Recv ||
+            type_id == OP_TYPEID::Send)
+        {
+            if (have_collective)
+            {
+                predecessors.insert(last_collective);
+            }
+            have_collective = true;
+            last_collective = i;
+        }
+        for (descriptor::Tensor* tensor : m_call_steps[i].m_inputs)
+        {
+            auto it = tensor_producers.find(tensor);
+            if (it != tensor_producers.end())
+            {
+                predecessors.insert(it->second);
+            }
+        }
+        for (auto dependency : m_call_steps[i].m_node->get_control_dependencies())
+        {
+            auto it = node_steps.find(dependency.get());
+            if (it != node_steps.end())
+            {
+                predecessors.insert(it->second);
+            }
+        }
+        for (size_t predecessor : predecessors)
+        {
+            m_step_successors[predecessor].push_back(i);
+        }
+        m_step_dependency_counts[i] = predecessors.size();
+    }
+}
+
+element::Type runtime::interpreter::INTExecutable::get_dispatch_type(const Node& node,
+                                                                     OP_TYPEID type_id)
+{
+    element::Type type;
+#if defined(__GNUC__) && !(__GNUC__ == 4 && __GNUC_MINOR__ == 8)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-enum"
+#endif
+    switch (type_id)
+    {
+    case OP_TYPEID::Convert:
+    case OP_TYPEID::Quantize:
+    case OP_TYPEID::Dequantize:
+    case OP_TYPEID::ArgMin:
+    case OP_TYPEID::ArgMax: type = node.get_input_element_type(0); break;
+    case OP_TYPEID::Equal:
+    case OP_TYPEID::Greater:
+    case OP_TYPEID::GreaterEq:
+    case OP_TYPEID::Less:
+    case OP_TYPEID::LessEq:
+    case OP_TYPEID::NotEqual:
+        // Get the type of the second input, not the first
+        // All BinaryElementwiseComparision ops have the same type for inputs
+        // Select has bool for first input and the type we are interested in for the second
+        type = node.get_input_element_type(1);
+        break;
+    case OP_TYPEID::TopK: type = node.get_output_element_type(1); break;
+    default: type = node.get_output_element_type(0); break;
+    }
+#if defined(__GNUC__) && !(__GNUC__ == 4 && __GNUC_MINOR__ == 8)
+#pragma GCC diagnostic pop
+#endif
+    return type;
+}
+
+runtime::interpreter::INTExecutable::Kernel
+    runtime::interpreter::INTExecutable::get_kernel(const element::Type& type) const
+{
+    Kernel kernel = nullptr;
+    switch (type)
+    {
+    case element::Type_t::boolean: kernel = &INTExecutable::op_engine<char>; break;
+    case element::Type_t::f32: kernel = &INTExecutable::op_engine<float>; break;
+    case element::Type_t::f64: kernel = &INTExecutable::op_engine<double>; break;
+    case element::Type_t::i8: kernel = &INTExecutable::op_engine<int8_t>; break;
+    case element::Type_t::i16: kernel = &INTExecutable::op_engine<int16_t>; break;
+    case element::Type_t::i32: kernel = &INTExecutable::op_engine<int32_t>; break;
+    case element::Type_t::i64: kernel = &INTExecutable::op_engine<int64_t>; break;
+    case element::Type_t::u8: kernel = &INTExecutable::op_engine<uint8_t>; break;
+    case element::Type_t::u16: kernel = &INTExecutable::op_engine<uint16_t>; break;
+    case element::Type_t::u32: kernel = &INTExecutable::op_engine<uint32_t>; break;
+    case element::Type_t::u64: kernel = &INTExecutable::op_engine<uint64_t>; break;
+    case element::Type_t::undefined:
+    case element::Type_t::dynamic:
+    case element::Type_t::u1:
+    case element::Type_t::bf16:
+    case element::Type_t::f16: break;
+    }
+    return kernel;
+}
+
+shared_ptr<runtime::interpreter::INTExecutable::MemoryArena>
+    runtime::interpreter::INTExecutable::acquire_memory_arena()
+{
+    unique_ptr<MemoryArena> arena;
+    {
+        lock_guard<mutex> lock(m_arena_mutex);
+        if (!m_free_arenas.empty())
+        {
+            arena = move(m_free_arenas.back());
+            m_free_arenas.pop_back();
+        }
+    }
+    if (!arena)
+    {
+        arena.reset(new MemoryArena());
+        arena->m_buffer = AlignedBuffer(m_memory_pool_size, get_alignment());
+        unordered_map<descriptor::Tensor*, shared_ptr<HostTensor>> tensor_map =
+            m_constant_tensors;
+        for (auto node : m_nodes)
+        {
+            for (descriptor::Tensor* tensor : node->liveness_new_list)
+            {
+                tensor_map[tensor] = make_shared<runtime::HostTensor>(
+                    tensor->get_element_type(),
+                    tensor->get_shape(),
+                    arena->m_buffer.get_ptr(tensor->get_pool_offset()),
+                    tensor->get_name());
+            }
+        }
+        // Parameter and result slots are left empty here and bound on every call
+        auto lookup = [&tensor_map](descriptor::Tensor* tensor) {
+            auto it = tensor_map.find(tensor);
+            return it == tensor_map.end() ? nullptr : it->second;
+        };
+        for (const CallStep& step : m_call_steps)
+        {
+            arena->m_step_inputs.emplace_back();
+            for (descriptor::Tensor* tensor : step.m_inputs)
+            {
+                arena->m_step_inputs.back().push_back(lookup(tensor));
+            }
+            arena->m_step_outputs.emplace_back();
+            for (descriptor::Tensor* tensor : step.m_outputs)
+            {
+                arena->m_step_outputs.back().push_back(lookup(tensor));
+            }
+        }
+        arena->m_fused_scratch.resize(m_call_steps.size());
+        for (size_t i = 0; i < m_call_steps.size(); ++i)
+        {
+            if (m_call_steps[i].m_fused_kernel)
+            {
+                bind_fused_scratch(*m_call_steps[i].m_fused_kernel, arena->m_fused_scratch[i]);
+            }
+        }
+        arena->m_loop_scratch.resize(m_call_steps.size());
+        for (size_t i = 0; i < m_call_steps.size(); ++i)
+        {
+            if (m_call_steps[i].m_loop)
+            {
+                bind_loop_scratch(*m_call_steps[i].m_loop, arena->m_loop_scratch[i]);
+            }
+        }
+        arena->m_all_reduce_requests.resize(m_call_steps.size());
+        bind_widened_scratch(*arena);
+    }
+    return shared_ptr<MemoryArena>(arena.release(), [this](MemoryArena* released) {
+        // A call that failed may have left all-reduces running into the arena's buffer
+        for (auto& request : released->m_all_reduce_requests)
+        {
+            if (request)
+            {
+                try
+                {
+                    request->wait();
+                }
+                catch (...)
+                {
+                }
+                request = nullptr;
+            }
+        }
+        // Don't keep the caller's tensors alive past the call
+        for (const ExternalBinding& binding : m_external_bindings)
+        {
+            auto& args = binding.m_is_result ? released->m_step_outputs
+                                             : released->m_step_inputs;
+            args[binding.m_step][binding.m_position] = nullptr;
+        }
+        lock_guard<mutex> lock(m_arena_mutex);
+        m_free_arenas.emplace_back(released);
+    });
 }
 
 bool runtime::interpreter::INTExecutable::call(const vector<shared_ptr<runtime::Tensor>>& outputs,
@@ -103,6 +516,8 @@ bool runtime::interpreter::INTExecutable::call(const vector<shared_ptr<runtime::
 {
     runtime::event::Duration d1("call", "Interpreter");
 
+    call_once(m_call_steps_flag, [this]() { build_call_steps(); });
+
     // convert inputs to HostTensor
     vector<shared_ptr<HostTensor>> func_inputs;
     for (auto tensor : inputs)
@@ -123,109 +538,857 @@ bool runtime::interpreter::INTExecutable::call(const vector<shared_ptr<runtime::
         func_outputs.push_back(host_tensor);
     }
 
-    // map function params -> HostTensor
-    unordered_map<descriptor::Tensor*, shared_ptr<HostTensor>> tensor_map;
-    size_t input_count = 0;
-    for (auto param : get_parameters())
+    // intermediate and constant tensors are pre-bound in the arena, bind params and results
+    shared_ptr<MemoryArena> arena = acquire_memory_arena();
+    for (const ExternalBinding& binding : m_external_bindings)
     {
-        for (size_t i = 0; i < param->get_output_size(); ++i)
+        if (binding.m_is_result)
         {
-            descriptor::Tensor* tensor = &param->output(i).get_tensor();
-            tensor_map.insert({tensor, func_inputs[input_count++]});
+            arena->m_step_outputs[binding.m_step][binding.m_position] =
+                func_outputs[binding.m_index];
+        }
+        else
+        {
+            arena->m_step_inputs[binding.m_step][binding.m_position] =
+                func_inputs[binding.m_index];
         }
     }
 
-    // map function outputs -> HostTensor
-    for (size_t output_count = 0; output_count < get_results().size(); ++output_count)
+    if (m_thread_pool)
     {
-        auto output = get_results()[output_count];
-        if (!is_type<op::Result>(output))
+        run_steps_parallel(*arena);
+    }
+    else
+    {
+        for (size_t i = 0; i < m_call_steps.size(); ++i)
         {
-            throw ngraph_error("One of function's outputs isn't op::Result");
+            run_step(i, *arena);
         }
-        descriptor::Tensor* tensor = &output->output(0).get_tensor();
-        tensor_map.insert({tensor, func_outputs[output_count]});
     }
 
-    // for each ordered op in the graph
-    for (auto op : m_nodes)
+    return true;
+}
+
+void runtime::interpreter::INTExecutable::run_step(size_t step_index, MemoryArena& arena)
+{
+    const CallStep& step = m_call_steps[step_index];
+    const Node& op = *step.m_node;
+    const vector<shared_ptr<HostTensor>>& op_inputs = arena.m_step_inputs[step_index];
+    const vector<shared_ptr<HostTensor>>& op_outputs = arena.m_step_outputs[step_index];
+    runtime::event::Duration d2(op.description(), "Interpreter");
+    runtime::event::Recorder::Scope trace(*step.m_trace_name);
+
+    if (step.m_timer)
+    {
+        step.m_timer->start();
+    }
+    if (step.m_fused_kernel)
+    {
+        run_fused_kernel(
+            *step.m_fused_kernel, arena.m_fused_scratch[step_index], op_outputs, op_inputs);
+    }
+    else if (step.m_loop)
+    {
+        run_loop(*step.m_loop, arena.m_loop_scratch[step_index], op_outputs, op_inputs);
+    }
+    else if (step.m_widened)
+    {
+        run_widened(step, arena.m_widened_scratch[step_index], op_outputs, op_inputs);
+    }
+    else if (step.m_type_id == OP_TYPEID::AllReduceStart)
     {
-        runtime::event::Duration d2(op->description(), "Interpreter");
-        if (op->is_parameter())
+        // The input may be reused once this step is done, so the reduction works on the output
+        auto start = static_cast<const op::AllReduceStart*>(&op);
+        void* data = op_outputs[0]->get_data_ptr();
+        memcpy(data, op_inputs[0]->get_data_ptr(), op_outputs[0]->get_size_in_bytes());
+        arena.m_all_reduce_requests[step_index] = get_distributed_interface()->all_reduce_start(
+            data,
+            data,
+            op.get_input_element_type(0),
+            start->get_reduce_type(),
+            shape_size(op.get_input_shape(0)));
+    }
+    else if (step.m_type_id == OP_TYPEID::AllReduceWait)
+    {
+        shared_ptr<DistributedInterface::Request> request;
+        swap(request, arena.m_all_reduce_requests[step.m_start_step]);
+        request->wait();
+        if (op_outputs[0]->get_data_ptr() != op_inputs[0]->get_data_ptr())
+        {
+            memcpy(op_outputs[0]->get_data_ptr(),
+                   op_inputs[0]->get_data_ptr(),
+                   op_outputs[0]->get_size_in_bytes());
+        }
+    }
+    else if (step.m_kernel)
+    {
+        (this->*step.m_kernel)(step.m_type_id, op, op_outputs, op_inputs);
+    }
+    else
+    {
+        generate_calls(step.m_type, op, op_outputs, op_inputs);
+    }
+    if (step.m_timer)
+    {
+        step.m_timer->stop();
+    }
+    if (m_nan_check_enabled)
+    {
+        perform_nan_check(op_outputs, &op);
+    }
+}
+
+shared_ptr<runtime::interpreter::INTExecutable::FusedKernel>
+    runtime::interpreter::INTExecutable::build_fused_kernel(const op::CompiledKernel& kernel)
+{
+    auto not_elementwise = [&kernel]() {
+        return unsupported_op("CompiledKernel '" + kernel.get_name() +
+                              "' is not an elementwise chain");
+    };
+    if (kernel.get_output_size() == 0)
+    {
+        throw not_elementwise();
+    }
+    auto fused = make_shared<FusedKernel>();
+    fused->m_shape = kernel.get_output_shape(0);
+    size_t element_count = shape_size(fused->m_shape);
+    fused->m_block_size = min(element_count, s_fused_block_size);
+    size_t tail_size = element_count % max<size_t>(fused->m_block_size, 1);
+
+    unordered_map<const Node*, size_t> kernel_inputs;
+    for (auto& entry : kernel.get_input_map())
+    {
+        kernel_inputs[entry.first.get()] = entry.second;
+    }
+    auto add_buffer = [&fused](const element::Type& type) {
+        fused->m_buffer_types.push_back(type);
+        return fused->m_buffer_types.size() - 1;
+    };
+    unordered_map<const Node*, size_t> node_buffers;
+    unordered_map<size_t, size_t> input_buffers;
+    for (const shared_ptr<Node>& node : kernel.get_node_list())
+    {
+        if (node->get_output_size() != 1 || node->get_output_shape(0) != fused->m_shape)
         {
+            throw not_elementwise();
+        }
+        if (auto broadcast = as_type_ptr<op::v0::Broadcast>(node))
+        {
+            auto input = kernel_inputs.find(node->get_input_node_ptr(0));
+            size_t element_size = node->get_element_type().size();
+            if (input == kernel_inputs.end() ||
+                (element_size != 1 && element_size != 2 && element_size != 4 &&
+                 element_size != 8))
+            {
+                throw not_elementwise();
+            }
+            FusedKernel::Load load{input->second,
+                                   add_buffer(widened(node->get_element_type())),
+                                   element_size,
+                                   {},
+                                   node->get_element_type()};
+            Strides input_strides = row_major_strides(node->get_input_shape(0));
+            const AxisSet& broadcast_axes = broadcast->get_broadcast_axes();
+            size_t input_axis = 0;
+            for (size_t axis = 0; axis < fused->m_shape.size(); ++axis)
+            {
+                load.m_broadcast_strides.push_back(
+                    broadcast_axes.count(axis) != 0 ? 0 : input_strides[input_axis++]);
+            }
+            node_buffers[node.get()] = load.m_buffer;
+            fused->m_loads.push_back(load);
             continue;
         }
 
-        // get op inputs from map
-        vector<shared_ptr<HostTensor>> op_inputs;
-        for (auto input : op->inputs())
+        FusedKernel::Stage stage;
+        OutputVector block_args;
+        OutputVector tail_args;
+        for (const Input<Node>& input : node->inputs())
         {
-            descriptor::Tensor* tensor = &input.get_tensor();
-            op_inputs.push_back(tensor_map.at(tensor));
+            if (input.get_shape() != fused->m_shape)
+            {
+                throw not_elementwise();
+            }
+            const Node* source = input.get_source_output().get_node();
+            auto produced = node_buffers.find(source);
+            if (produced != node_buffers.end())
+            {
+                stage.m_inputs.push_back(produced->second);
+            }
+            else
+            {
+                auto kernel_input = kernel_inputs.find(source);
+                if (kernel_input == kernel_inputs.end())
+                {
+                    throw not_elementwise();
+                }
+                auto loaded = input_buffers.find(kernel_input->second);
+                if (loaded == input_buffers.end())
+                {
+                    const element::Type& type = input.get_element_type();
+                    FusedKernel::Load load{
+                        kernel_input->second, add_buffer(widened(type)), type.size(), {}, type};
+                    fused->m_loads.push_back(load);
+                    loaded = input_buffers.emplace(kernel_input->second, load.m_buffer).first;
+                }
+                stage.m_inputs.push_back(loaded->second);
+            }
+            // Half-precision values are kept in f32 buffers, which the stages run on
+            const element::Type& type = widened(input.get_element_type());
+            block_args.push_back(make_shared<op::Parameter>(type, Shape{fused->m_block_size}));
+            tail_args.push_back(make_shared<op::Parameter>(type, Shape{tail_size}));
+        }
+        element::Type output_type = widened(node->get_element_type());
+        auto copy_stage = [&node, &output_type](const OutputVector& args) -> shared_ptr<Node> {
+            if (is_type<op::v0::Convert>(node))
+            {
+                return make_shared<op::v0::Convert>(args.at(0), output_type);
+            }
+            return node->copy_with_new_inputs(args);
+        };
+        stage.m_block_node = copy_stage(block_args);
+        if (tail_size != 0)
+        {
+            stage.m_tail_node = copy_stage(tail_args);
+        }
+        stage.m_type_id = get_typeid(*node);
+        stage.m_type = get_dispatch_type(*stage.m_block_node, stage.m_type_id);
+        stage.m_kernel = get_kernel(stage.m_type);
+        stage.m_output = add_buffer(output_type);
+        node_buffers[node.get()] = stage.m_output;
+        fused->m_stages.push_back(stage);
+    }
+    for (size_t i = 0; i < kernel.get_kernel_outputs().size(); ++i)
+    {
+        auto buffer = node_buffers.find(kernel.get_kernel_outputs()[i].get());
+        if (buffer == node_buffers.end())
+        {
+            throw not_elementwise();
         }
+        fused->m_stores.push_back(
+            {buffer->second, i, kernel.get_kernel_outputs()[i]->get_element_type()});
+    }
+    return fused;
+}
 
-        // get op outputs from map or create
-        vector<shared_ptr<HostTensor>> op_outputs;
-        for (size_t i = 0; i < op->get_output_size(); ++i)
+void runtime::interpreter::INTExecutable::bind_fused_scratch(const FusedKernel& fused,
+                                                             FusedScratch& scratch) const
+{
+    vector<size_t> offsets;
+    size_t size = 0;
+    for (const element::Type& type : fused.m_buffer_types)
+    {
+        offsets.push_back(size);
+        size += round_up(fused.m_block_size * type.size(), get_alignment());
+    }
+    scratch.m_buffer = AlignedBuffer(size, get_alignment());
+    for (size_t offset : offsets)
+    {
+        scratch.m_buffers.push_back(static_cast<char*>(scratch.m_buffer.get_ptr(offset)));
+    }
+
+    auto bind = [&](size_t element_count,
+                    vector<vector<shared_ptr<HostTensor>>>& stage_inputs,
+                    vector<vector<shared_ptr<HostTensor>>>& stage_outputs) {
+        vector<shared_ptr<HostTensor>> tensors;
+        for (size_t i = 0; i < fused.m_buffer_types.size(); ++i)
         {
-            descriptor::Tensor* tensor = &op->output(i).get_tensor();
-            shared_ptr<HostTensor> host_tensor;
-            auto it = tensor_map.find(tensor);
-            if (it == tensor_map.end())
+            tensors.push_back(make_shared<HostTensor>(
+                fused.m_buffer_types[i], Shape{element_count}, scratch.m_buffers[i]));
+        }
+        for (const FusedKernel::Stage& stage : fused.m_stages)
+        {
+            stage_inputs.emplace_back();
+            for (size_t buffer : stage.m_inputs)
+            {
+                stage_inputs.back().push_back(tensors[buffer]);
+            }
+            stage_outputs.push_back({tensors[stage.m_output]});
+        }
+    };
+    size_t element_count = shape_size(fused.m_shape);
+    bind(fused.m_block_size, scratch.m_block_inputs, scratch.m_block_outputs);
+    if (fused.m_block_size != 0 && element_count % fused.m_block_size != 0)
+    {
+        bind(element_count % fused.m_block_size, scratch.m_tail_inputs, scratch.m_tail_outputs);
+    }
+}
+
+// Expand elements [begin, begin + count) of a broadcast into target. `strides` holds the input
+// element stride of every axis of `shape`, 0 along the broadcast axes.
+template <typename S, typename T>
+static void broadcast_block(const S* source,
+                            T* target,
+                            const Shape& shape,
+                            const vector<size_t>& strides,
+                            size_t begin,
+                            size_t count)
+{
+    size_t rank = shape.size();
+    vector<size_t> coordinate(rank);
+    size_t index = 0;
+    size_t remainder = begin;
+    for (size_t axis = rank; axis-- > 0;)
+    {
+        coordinate[axis] = remainder % shape[axis];
+        remainder /= shape[axis];
+        index += coordinate[axis] * strides[axis];
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        target[i] = source[index];
+        for (size_t axis = rank; axis-- > 0;)
+        {
+            index += strides[axis];
+            if (++coordinate[axis] < shape[axis])
+            {
+                break;
+            }
+            index -= strides[axis] * shape[axis];
+            coordinate[axis] = 0;
+        }
+    }
+}
+
+void runtime::interpreter::INTExecutable::run_fused_kernel(
+    const FusedKernel& fused,
+    FusedScratch& scratch,
+    const vector<shared_ptr<HostTensor>>& out,
+    const vector<shared_ptr<HostTensor>>& args)
+{
+    size_t element_count = shape_size(fused.m_shape);
+    for (size_t begin = 0; begin < element_count; begin += fused.m_block_size)
+    {
+        size_t count = min(fused.m_block_size, element_count - begin);
+        bool is_tail = count < fused.m_block_size;
+        for (const FusedKernel::Load& load : fused.m_loads)
+        {
+            const char* source = args[load.m_input]->get_data_ptr<char>();
+            char* target = scratch.m_buffers[load.m_buffer];
+            if (load.m_broadcast_strides.empty())
+            {
+                if (is_half(load.m_type))
+                {
+                    widen(load.m_type,
+                          source + begin * load.m_element_size,
+                          reinterpret_cast<float*>(target),
+                          count);
+                }
+                else
+                {
+                    memcpy(
+                        target, source + begin * load.m_element_size, count * load.m_element_size);
+                }
+                continue;
+            }
+            if (load.m_type == element::f16)
             {
-                const Shape& shape = op->get_output_shape(i);
-                const element::Type& type = op->get_output_element_type(i);
-                string name = op->output(i).get_tensor().get_name();
-                host_tensor = make_shared<runtime::HostTensor>(type, shape, name);
-                tensor_map.insert({tensor, host_tensor});
+                broadcast_block(reinterpret_cast<const float16*>(source),
+                                reinterpret_cast<float*>(target),
+                                fused.m_shape,
+                                load.m_broadcast_strides,
+                                begin,
+                                count);
+                continue;
+            }
+            if (load.m_type == element::bf16)
+            {
+                broadcast_block(reinterpret_cast<const bfloat16*>(source),
+                                reinterpret_cast<float*>(target),
+                                fused.m_shape,
+                                load.m_broadcast_strides,
+                                begin,
+                                count);
+                continue;
+            }
+            switch (load.m_element_size)
+            {
+            case 1:
+                broadcast_block(reinterpret_cast<const uint8_t*>(source),
+                                reinterpret_cast<uint8_t*>(target),
+                                fused.m_shape,
+                                load.m_broadcast_strides,
+                                begin,
+                                count);
+                break;
+            case 2:
+                broadcast_block(reinterpret_cast<const uint16_t*>(source),
+                                reinterpret_cast<uint16_t*>(target),
+                                fused.m_shape,
+                                load.m_broadcast_strides,
+                                begin,
+                                count);
+                break;
+            case 4:
+                broadcast_block(reinterpret_cast<const uint32_t*>(source),
+                                reinterpret_cast<uint32_t*>(target),
+                                fused.m_shape,
+                                load.m_broadcast_strides,
+                                begin,
+                                count);
+                break;
+            default:
+                broadcast_block(reinterpret_cast<const uint64_t*>(source),
+                                reinterpret_cast<uint64_t*>(target),
+                                fused.m_shape,
+                                load.m_broadcast_strides,
+                                begin,
+                                count);
+                break;
+            }
+        }
+        for (size_t i = 0; i < fused.m_stages.size(); ++i)
+        {
+            const FusedKernel::Stage& stage = fused.m_stages[i];
+            const Node& node = is_tail ? *stage.m_tail_node : *stage.m_block_node;
+            const auto& stage_outputs =
+                is_tail ? scratch.m_tail_outputs[i] : scratch.m_block_outputs[i];
+            const auto& stage_inputs =
+                is_tail ? scratch.m_tail_inputs[i] : scratch.m_block_inputs[i];
+            if (stage.m_kernel)
+            {
+                (this->*stage.m_kernel)(stage.m_type_id, node, stage_outputs, stage_inputs);
             }
             else
             {
-                host_tensor = it->second;
+                generate_calls(stage.m_type, node, stage_outputs, stage_inputs);
             }
-            op_outputs.push_back(host_tensor);
         }
+        for (const FusedKernel::Store& store : fused.m_stores)
+        {
+            char* target = out[store.m_output]->get_data_ptr<char>();
+            if (is_half(store.m_type))
+            {
+                narrow(store.m_type,
+                       reinterpret_cast<const float*>(scratch.m_buffers[store.m_buffer]),
+                       target + begin * store.m_type.size(),
+                       count);
+                continue;
+            }
+            size_t element_size = fused.m_buffer_types[store.m_buffer].size();
+            memcpy(target + begin * element_size,
+                   scratch.m_buffers[store.m_buffer],
+                   count * element_size);
+        }
+    }
+}
+
+void runtime::interpreter::INTExecutable::bind_widened_scratch(MemoryArena& arena) const
+{
+    // Steps that run one at a time can share the memory of their copies
+    bool overlap = !m_thread_pool;
+    auto copy_size = [this](const descriptor::Tensor* tensor) {
+        return round_up(shape_size(tensor->get_shape()) * sizeof(float), get_alignment());
+    };
+    vector<size_t> offsets(m_call_steps.size(), 0);
+    size_t size = 0;
+    for (size_t i = 0; i < m_call_steps.size(); ++i)
+    {
+        const CallStep& step = m_call_steps[i];
+        size_t step_size = 0;
+        for (size_t input : step.m_widened_inputs)
+        {
+            step_size += copy_size(step.m_inputs[input]);
+        }
+        for (size_t output : step.m_widened_outputs)
+        {
+            step_size += copy_size(step.m_outputs[output]);
+        }
+        offsets[i] = overlap ? 0 : size;
+        size = overlap ? max(size, step_size) : size + step_size;
+    }
+    arena.m_widened_buffer = AlignedBuffer(size, get_alignment());
+
+    arena.m_widened_scratch.resize(m_call_steps.size());
+    for (size_t i = 0; i < m_call_steps.size(); ++i)
+    {
+        const CallStep& step = m_call_steps[i];
+        size_t offset = offsets[i];
+        auto bind = [&](const descriptor::Tensor* tensor) {
+            auto copy = make_shared<HostTensor>(
+                element::f32, tensor->get_shape(), arena.m_widened_buffer.get_ptr(offset));
+            offset += copy_size(tensor);
+            return copy;
+        };
+        for (size_t input : step.m_widened_inputs)
+        {
+            arena.m_widened_scratch[i].m_inputs.push_back(bind(step.m_inputs[input]));
+        }
+        for (size_t output : step.m_widened_outputs)
+        {
+            arena.m_widened_scratch[i].m_outputs.push_back(bind(step.m_outputs[output]));
+        }
+    }
+}
+
+void runtime::interpreter::INTExecutable::run_widened(
+    const CallStep& step,
+    const WidenedScratch& scratch,
+    const vector<shared_ptr<HostTensor>>& out,
+    const vector<shared_ptr<HostTensor>>& args)
+{
+    vector<shared_ptr<HostTensor>> inputs = args;
+    for (size_t i = 0; i < step.m_widened_inputs.size(); ++i)
+    {
+        const shared_ptr<HostTensor>& arg = args[step.m_widened_inputs[i]];
+        widen(arg->get_element_type(),
+              arg->get_data_ptr(),
+              scratch.m_inputs[i]->get_data_ptr<float>(),
+              arg->get_element_count());
+        inputs[step.m_widened_inputs[i]] = scratch.m_inputs[i];
+    }
+    vector<shared_ptr<HostTensor>> outputs = out;
+    for (size_t i = 0; i < step.m_widened_outputs.size(); ++i)
+    {
+        outputs[step.m_widened_outputs[i]] = scratch.m_outputs[i];
+    }
+
+    if (step.m_kernel)
+    {
+        (this->*step.m_kernel)(step.m_type_id, *step.m_node, outputs, inputs);
+    }
+    else
+    {
+        generate_calls(step.m_type, *step.m_node, outputs, inputs);
+    }
+
+    for (size_t i = 0; i < step.m_widened_outputs.size(); ++i)
+    {
+        const shared_ptr<HostTensor>& output = out[step.m_widened_outputs[i]];
+        narrow(output->get_element_type(),
+               scratch.m_outputs[i]->get_data_ptr<const float>(),
+               output->get_data_ptr(),
+               output->get_element_count());
+    }
+}
+
+runtime::interpreter::INTExecutable::Loop::Window::Window(const Shape& shape,
+                                                         const element::Type& type,
+                                                         int64_t axis,
+                                                         int64_t part_size,
+                                                         int64_t start,
+                                                         int64_t stride)
+{
+    size_t window_axis = axis < 0 ? axis + shape.size() : axis;
+    m_outer = shape_size(Shape(shape.begin(), shape.begin() + window_axis));
+    m_dim = shape.at(window_axis);
+    m_part_size = part_size;
+    m_inner_bytes = shape_size(Shape(shape.begin() + window_axis + 1, shape.end())) * type.size();
+    m_start = start < 0 ? start + m_dim : start;
+    m_stride = stride;
+}
+
+int64_t runtime::interpreter::INTExecutable::Loop::Window::first(int64_t iteration) const
+{
+    // A negative stride moves backwards from m_start, which is the last index of the first part
+    int64_t first = m_start + iteration * m_stride;
+    return m_stride < 0 ? first - static_cast<int64_t>(m_part_size) + 1 : first;
+}
+
+void runtime::interpreter::INTExecutable::Loop::Window::copy(int64_t iteration,
+                                                             char* full,
+                                                             char* part,
+                                                             bool into_full) const
+{
+    size_t part_bytes = m_part_size * m_inner_bytes;
+    size_t first_index = first(iteration);
+    for (size_t outer = 0; outer < m_outer; ++outer)
+    {
+        char* full_part = full + (outer * m_dim + first_index) * m_inner_bytes;
+        char* slice = part + outer * part_bytes;
+        if (into_full)
+        {
+            memcpy(full_part, slice, part_bytes);
+        }
+        else
+        {
+            memcpy(slice, full_part, part_bytes);
+        }
+    }
+}
 
-        // get op type
-        element::Type type;
-        if (is_type<op::Convert>(op) || is_type<op::Quantize>(op) || is_type<op::Dequantize>(op) ||
-            is_type<op::ArgMin>(op) || is_type<op::ArgMax>(op))
+shared_ptr<runtime::interpreter::INTExecutable::Loop>
+    runtime::interpreter::INTExecutable::build_loop(const op::TensorIterator& tensor_iterator)
+{
+    auto unsupported = [&tensor_iterator](const string& reason) {
+        return unsupported_op("TensorIterator '" + tensor_iterator.get_name() + "' " + reason);
+    };
+    auto loop = make_shared<Loop>();
+    loop->m_num_iterations = tensor_iterator.get_num_iterations();
+    if (loop->m_num_iterations < 0)
+    {
+        throw unsupported("has no sliced input that sets the number of iterations");
+    }
+    for (const Output<const Node>& output : tensor_iterator.outputs())
+    {
+        if (output.get_partial_shape().is_dynamic())
         {
-            type = op->get_input_element_type(0);
+            throw unsupported("has outputs of dynamic shape");
+        }
+    }
+    auto check_window = [&](const Loop::Window& window) {
+        for (int64_t iteration : {int64_t{0}, loop->m_num_iterations - 1})
+        {
+            int64_t first = window.first(iteration);
+            if (loop->m_num_iterations > 0 &&
+                (first < 0 || first + window.m_part_size > window.m_dim))
+            {
+                throw unsupported("has a slice outside of its tensor");
+            }
         }
-        else if (is_type<op::Equal>(op) || is_type<op::Greater>(op) || is_type<op::GreaterEq>(op) ||
-                 is_type<op::Less>(op) || is_type<op::LessEq>(op) || is_type<op::NotEqual>(op))
+    };
+
+    auto body = tensor_iterator.get_body();
+    vector<bool> bound(body->get_parameters().size(), false);
+    for (auto& description : tensor_iterator.get_input_descriptions())
+    {
+        size_t input = description->m_input_index;
+        size_t parameter = description->m_body_parameter_index;
+        bound.at(parameter) = true;
+        if (auto slice = as_type_ptr<op::TensorIterator::SliceInputDescription>(description))
         {
-            // Get the type of the second input, not the first
-            // All BinaryElementwiseComparision ops have the same type for inputs
-            // Select has bool for first input and the type we are interested in for the second
-            type = op->get_input_element_type(1);
+            Loop::Window window(tensor_iterator.get_input_shape(input),
+                                tensor_iterator.get_input_element_type(input),
+                                slice->m_axis,
+                                slice->m_part_size,
+                                slice->m_start,
+                                slice->m_stride);
+            check_window(window);
+            loop->m_sliced_inputs.push_back({input, parameter, window});
         }
-        else if (is_type<op::TopK>(op))
+        else if (auto merged =
+                     as_type_ptr<op::TensorIterator::MergedInputDescription>(description))
         {
-            type = op->get_output_element_type(1);
+            loop->m_merged_inputs.push_back({input, parameter, merged->m_body_value_index});
         }
         else
         {
-            type = op->get_output_element_type(0);
+            loop->m_invariant_inputs.push_back({input, parameter});
         }
+    }
+    if (find(bound.begin(), bound.end(), false) != bound.end())
+    {
+        throw unsupported("has an unbound body parameter");
+    }
 
-        if (m_performance_counters_enabled)
+    // Results that feed anything but a single contiguous concatenation need their own storage
+    vector<size_t> result_uses(body->get_results().size(), 0);
+    for (const Loop::MergedInput& merged : loop->m_merged_inputs)
+    {
+        result_uses.at(merged.m_result)++;
+    }
+    for (auto& description : tensor_iterator.get_output_descriptions())
+    {
+        result_uses.at(description->m_body_value_index)++;
+    }
+    for (auto& description : tensor_iterator.get_output_descriptions())
+    {
+        size_t result = description->m_body_value_index;
+        size_t output = description->m_output_index;
+        if (auto concat =
+                as_type_ptr<op::TensorIterator::ConcatOutputDescription>(description))
         {
-            m_timer_map[op].start();
+            Loop::Window window(tensor_iterator.get_output_shape(output),
+                                tensor_iterator.get_output_element_type(output),
+                                concat->m_axis,
+                                concat->m_part_size,
+                                concat->m_start,
+                                concat->m_stride);
+            check_window(window);
+            bool in_place = window.m_outer == 1 && result_uses[result] == 1;
+            loop->m_concat_outputs.push_back({result, output, window, in_place});
         }
-        generate_calls(type, *op.get(), op_outputs, op_inputs);
-        if (m_performance_counters_enabled)
+        else if (auto iteration =
+                     as_type_ptr<op::TensorIterator::BodyOutputDescription>(description))
         {
-            m_timer_map[op].stop();
+            int64_t index = iteration->m_iteration < 0
+                                ? loop->m_num_iterations + iteration->m_iteration
+                                : iteration->m_iteration;
+            if (index < 0 || index >= loop->m_num_iterations)
+            {
+                throw unsupported("reads the value of an iteration it doesn't run");
+            }
+            loop->m_iteration_outputs.push_back({result, output, index});
         }
-        if (m_nan_check_enabled)
+    }
+
+    loop->m_body =
+        compile_loop_body(make_shared<Function>(body->get_results(), body->get_parameters()));
+    return loop;
+}
+
+shared_ptr<runtime::interpreter::INTExecutable>
+    runtime::interpreter::INTExecutable::compile_loop_body(const shared_ptr<Function>& body) const
+{
+    return make_shared<INTExecutable>(body, m_performance_counters_enabled);
+}
+
+void runtime::interpreter::INTExecutable::bind_loop_scratch(const Loop& loop, LoopScratch& scratch)
+{
+    for (auto& result : loop.m_body->get_results())
+    {
+        scratch.m_results.push_back(
+            {make_shared<HostTensor>(result->get_element_type(), result->get_shape()),
+             make_shared<HostTensor>(result->get_element_type(), result->get_shape())});
+    }
+    const ParameterVector& parameters = loop.m_body->get_parameters();
+    scratch.m_parameters.resize(parameters.size());
+    for (const Loop::SlicedInput& sliced : loop.m_sliced_inputs)
+    {
+        if (sliced.m_window.m_outer != 1)
         {
-            perform_nan_check(op_outputs, op.get());
+            auto parameter = parameters.at(sliced.m_parameter);
+            scratch.m_parameters[sliced.m_parameter] =
+                make_shared<HostTensor>(parameter->get_element_type(), parameter->get_shape());
         }
     }
+}
 
-    return true;
+void runtime::interpreter::INTExecutable::run_loop(const Loop& loop,
+                                                   LoopScratch& scratch,
+                                                   const vector<shared_ptr<HostTensor>>& out,
+                                                   const vector<shared_ptr<HostTensor>>& args)
+{
+    const ParameterVector& parameters = loop.m_body->get_parameters();
+    const ResultVector& results = loop.m_body->get_results();
+    vector<shared_ptr<runtime::Tensor>> body_inputs(parameters.size());
+    vector<shared_ptr<runtime::Tensor>> body_outputs(results.size());
+    for (const Loop::InvariantInput& invariant : loop.m_invariant_inputs)
+    {
+        body_inputs[invariant.m_parameter] = args[invariant.m_input];
+    }
+
+    for (int64_t iteration = 0; iteration < loop.m_num_iterations; ++iteration)
+    {
+        size_t current = iteration % 2;
+        for (const Loop::SlicedInput& sliced : loop.m_sliced_inputs)
+        {
+            char* data = args[sliced.m_input]->get_data_ptr<char>();
+            const Loop::Window& window = sliced.m_window;
+            if (window.m_outer == 1)
+            {
+                auto& parameter = parameters[sliced.m_parameter];
+                body_inputs[sliced.m_parameter] = make_shared<HostTensor>(
+                    parameter->get_element_type(),
+                    parameter->get_shape(),
+                    data + window.first(iteration) * window.m_inner_bytes);
+            }
+            else
+            {
+                shared_ptr<HostTensor>& slice = scratch.m_parameters[sliced.m_parameter];
+                window.copy(iteration, data, slice->get_data_ptr<char>(), false);
+                body_inputs[sliced.m_parameter] = slice;
+            }
+        }
+        for (const Loop::MergedInput& merged : loop.m_merged_inputs)
+        {
+            body_inputs[merged.m_parameter] =
+                iteration == 0 ? args[merged.m_input]
+                               : scratch.m_results[merged.m_result][1 - current];
+        }
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            body_outputs[i] = scratch.m_results[i][current];
+        }
+        for (const Loop::ConcatOutput& concat : loop.m_concat_outputs)
+        {
+            if (concat.m_in_place)
+            {
+                const Loop::Window& window = concat.m_window;
+                auto& result = results[concat.m_result];
+                body_outputs[concat.m_result] = make_shared<HostTensor>(
+                    result->get_element_type(),
+                    result->get_shape(),
+                    out[concat.m_output]->get_data_ptr<char>() +
+                        window.first(iteration) * window.m_inner_bytes);
+            }
+        }
+
+        loop.m_body->call(body_outputs, body_inputs);
+
+        for (const Loop::ConcatOutput& concat : loop.m_concat_outputs)
+        {
+            if (!concat.m_in_place)
+            {
+                concat.m_window.copy(
+                    iteration,
+                    out[concat.m_output]->get_data_ptr<char>(),
+                    scratch.m_results[concat.m_result][current]->get_data_ptr<char>(),
+                    true);
+            }
+        }
+        for (const Loop::IterationOutput& output : loop.m_iteration_outputs)
+        {
+            if (output.m_iteration == iteration)
+            {
+                memcpy(out[output.m_output]->get_data_ptr(),
+                       scratch.m_results[output.m_result][current]->get_data_ptr(),
+                       out[output.m_output]->get_size_in_bytes());
+            }
+        }
+    }
+}
+
+void runtime::interpreter::INTExecutable::run_steps_parallel(MemoryArena& arena)
+{
+    size_t step_count = m_call_steps.size();
+    unique_ptr<atomic<size_t>[]> pending(new atomic<size_t>[step_count]);
+    for (size_t i = 0; i < step_count; ++i)
+    {
+        pending[i] = m_step_dependency_counts[i];
+    }
+    atomic<size_t> remaining{step_count};
+    atomic<bool> failed{false};
+    exception_ptr error;
+    mutex error_mutex;
+
+    ThreadPool* pool = m_thread_pool.get();
+    function<void(size_t)> run = [&](size_t step_index) {
+        // After a failure the remaining steps are only retired so that the call can return
+        if (!failed)
+        {
+            try
+            {
+                run_step(step_index, arena);
+            }
+            catch (...)
+            {
+                lock_guard<mutex> lock(error_mutex);
+                if (!error)
+                {
+                    error = current_exception();
+                }
+                failed = true;
+            }
+        }
+        for (size_t successor : m_step_successors[step_index])
+        {
+            if (--pending[successor] == 0)
+            {
+                pool->submit([&run, successor]() { run(successor); });
+            }
+        }
+        // Nothing captured by reference may be touched once the last step is retired
+        ThreadPool* current_pool = pool;
+        if (--remaining == 0)
+        {
+            current_pool->notify();
+        }
+    };
+
+    for (size_t i = 0; i < step_count; ++i)
+    {
+        if (m_step_dependency_counts[i] == 0)
+        {
+            pool->submit([&run, i]() { run(i); });
+        }
+    }
+    pool->run_until([&remaining]() { return remaining == 0; });
+
+    if (error)
+    {
+        rethrow_exception(error);
+    }
 }
 
 void runtime::interpreter::INTExecutable::generate_calls(const element::Type& type,
@@ -233,28 +1396,14 @@ void runtime::interpreter::INTExecutable::generate_calls(const element::Type& ty
                                                          const vector<shared_ptr<HostTensor>>& out,
                                                          const vector<shared_ptr<HostTensor>>& in)
 {
-    stringstream ss;
-    switch (type)
+    Kernel kernel = get_kernel(type);
+    if (!kernel)
     {
-    case element::Type_t::boolean: op_engine<char>(op, out, in); break;
-    case element::Type_t::f32: op_engine<float>(op, out, in); break;
-    case element::Type_t::f64: op_engine<double>(op, out, in); break;
-    case element::Type_t::i8: op_engine<int8_t>(op, out, in); break;
-    case element::Type_t::i16: op_engine<int16_t>(op, out, in); break;
-    case element::Type_t::i32: op_engine<int32_t>(op, out, in); break;
-    case element::Type_t::i64: op_engine<int64_t>(op, out, in); break;
-    case element::Type_t::u8: op_engine<uint8_t>(op, out, in); break;
-    case element::Type_t::u16: op_engine<uint16_t>(op, out, in); break;
-    case element::Type_t::u32: op_engine<uint32_t>(op, out, in); break;
-    case element::Type_t::u64: op_engine<uint64_t>(op, out, in); break;
-    case element::Type_t::undefined:
-    case element::Type_t::dynamic:
-    case element::Type_t::u1:
-    case element::Type_t::bf16:
-    case element::Type_t::f16:
+        stringstream ss;
         ss << "unsupported element type " << type << " op " << op.get_name();
         throw ngraph_error(ss.str());
     }
+    (this->*kernel)(get_typeid(op), op, out, in);
 }
 
 void runtime::interpreter::INTExecutable::set_nan_check(bool enable)
@@ -19,14 +19,18 @@
 #include <initializer_list>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include "ngraph/op/experimental/compiled_kernel.hpp"
 #include "ngraph/ops.hpp"
 #include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/chrome_trace.hpp"
 #include "ngraph/runtime/host_tensor.hpp"
+#include "ngraph/runtime/interpreter/int_thread_pool.hpp"
 #ifdef INTERPRETER_USE_HYBRID
 #include "ngraph/runtime/hybrid/op/function_call.hpp"
 #endif
@@ -186,6 +190,300 @@ protected:
     std::unordered_map<const Node*, std::shared_ptr<State>> m_states;
     std::set<std::string> m_unsupported_op_name_list;
 
+    using Kernel = void (INTExecutable::*)(OP_TYPEID,
+                                           const Node&,
+                                           const std::vector<std::shared_ptr<HostTensor>>&,
+                                           const std::vector<std::shared_ptr<HostTensor>>&);
+
+    /// \brief Blocked execution plan of an op::CompiledKernel built by pass::ElementwiseFusion.
+    /// The kernel's ops run one block of elements at a time on scratch buffers that stay in
+    /// cache, so only the kernel's inputs and outputs pass through memory.
+    struct FusedKernel
+    {
+        /// \brief Copies a block of a kernel input into a scratch buffer. Inputs of fused
+        /// Broadcasts are expanded on the way.
+        struct Load
+        {
+            size_t m_input;
+            size_t m_buffer;
+            size_t m_element_size;
+            /// input element stride of every output axis, empty if the input is not broadcast
+            std::vector<size_t> m_broadcast_strides;
+            /// half-precision inputs are widened to the f32 buffer on the way
+            element::Type m_type;
+        };
+        /// \brief One fused op, cloned with inputs of the block and tail shapes so that the
+        /// regular kernels can run it on scratch buffers
+        struct Stage
+        {
+            std::shared_ptr<Node> m_block_node;
+            std::shared_ptr<Node> m_tail_node;
+            OP_TYPEID m_type_id;
+            element::Type m_type;
+            Kernel m_kernel;
+            std::vector<size_t> m_inputs;
+            size_t m_output;
+        };
+        /// \brief Copies a block of a buffer into a kernel output, rounding to m_type if the
+        /// output is half precision
+        struct Store
+        {
+            size_t m_buffer;
+            size_t m_output;
+            element::Type m_type;
+        };
+
+        Shape m_shape;
+        size_t m_block_size;
+        std::vector<element::Type> m_buffer_types;
+        std::vector<Load> m_loads;
+        std::vector<Stage> m_stages;
+        std::vector<Store> m_stores;
+    };
+
+    /// \brief Scratch buffers of a FusedKernel, bound to the stage arguments for full blocks
+    /// and for the final partial block
+    struct FusedScratch
+    {
+        AlignedBuffer m_buffer;
+        std::vector<char*> m_buffers;
+        std::vector<std::vector<std::shared_ptr<HostTensor>>> m_block_inputs;
+        std::vector<std::vector<std::shared_ptr<HostTensor>>> m_block_outputs;
+        std::vector<std::vector<std::shared_ptr<HostTensor>>> m_tail_inputs;
+        std::vector<std::vector<std::shared_ptr<HostTensor>>> m_tail_outputs;
+    };
+
+    /// \brief Execution plan of a TensorIterator. The body is compiled once into its own
+    /// executable, which is called for every iteration on views of the loop's tensors.
+    struct Loop
+    {
+        /// \brief The part of a tensor that a sliced input or concatenated output moves
+        /// through, `m_part_size` indices along an axis
+        struct Window
+        {
+            Window(const Shape& shape,
+                   const element::Type& type,
+                   int64_t axis,
+                   int64_t part_size,
+                   int64_t start,
+                   int64_t stride);
+
+            /// \brief First index along the axis covered in `iteration`
+            int64_t first(int64_t iteration) const;
+            /// \brief Copy the part covered in `iteration` between `full` and `part`
+            void copy(int64_t iteration, char* full, char* part, bool into_full) const;
+
+            /// number of blocks before the axis, the window is contiguous if this is 1
+            size_t m_outer;
+            size_t m_dim;
+            size_t m_part_size;
+            /// bytes of one index along the axis
+            size_t m_inner_bytes;
+            int64_t m_start;
+            int64_t m_stride;
+        };
+        struct SlicedInput
+        {
+            size_t m_input;
+            size_t m_parameter;
+            Window m_window;
+        };
+        /// \brief Bound to the loop input on the first iteration and to a body result after
+        struct MergedInput
+        {
+            size_t m_input;
+            size_t m_parameter;
+            size_t m_result;
+        };
+        struct InvariantInput
+        {
+            size_t m_input;
+            size_t m_parameter;
+        };
+        struct ConcatOutput
+        {
+            size_t m_result;
+            size_t m_output;
+            Window m_window;
+            /// the body writes its result straight into the output
+            bool m_in_place;
+        };
+        struct IterationOutput
+        {
+            size_t m_result;
+            size_t m_output;
+            int64_t m_iteration;
+        };
+
+        std::shared_ptr<INTExecutable> m_body;
+        int64_t m_num_iterations;
+        std::vector<SlicedInput> m_sliced_inputs;
+        std::vector<MergedInput> m_merged_inputs;
+        std::vector<InvariantInput> m_invariant_inputs;
+        std::vector<ConcatOutput> m_concat_outputs;
+        std::vector<IterationOutput> m_iteration_outputs;
+    };
+
+    /// \brief Body tensors of a Loop that don't alias the loop's own tensors
+    struct LoopScratch
+    {
+        /// two per body result, a merged input reads one while the body writes the other
+        std::vector<std::vector<std::shared_ptr<HostTensor>>> m_results;
+        /// copies of non-contiguous slices, nullptr for the other parameters
+        std::vector<std::shared_ptr<HostTensor>> m_parameters;
+    };
+
+    /// \brief One entry of the dispatch table. Everything that only depends on the graph is
+    /// resolved once so a call just walks the table.
+    struct CallStep
+    {
+        std::shared_ptr<Node> m_node;
+        OP_TYPEID m_type_id;
+        element::Type m_type;
+        /// nullptr when no kernel exists for m_type; generate_calls reports the error
+        Kernel m_kernel;
+        std::vector<descriptor::Tensor*> m_inputs;
+        std::vector<descriptor::Tensor*> m_outputs;
+        stopwatch* m_timer;
+        /// name of the op's events in the trace ring buffer
+        std::shared_ptr<runtime::event::Recorder::Name> m_trace_name;
+        /// set for fused elementwise chains, which are run by run_fused_kernel
+        std::shared_ptr<FusedKernel> m_fused_kernel;
+        /// set for TensorIterators, which are run by run_loop
+        std::shared_ptr<Loop> m_loop;
+        /// for an AllReduceWait, the step of the AllReduceStart it waits for
+        size_t m_start_step;
+        /// set for steps on half-precision tensors that run on the f32 kernels, which are
+        /// given f32 copies of the m_widened_inputs and m_widened_outputs
+        bool m_widened;
+        std::vector<size_t> m_widened_inputs;
+        std::vector<size_t> m_widened_outputs;
+    };
+
+    /// \brief The f32 copies of the half-precision tensors of a widened step
+    struct WidenedScratch
+    {
+        std::vector<std::shared_ptr<HostTensor>> m_inputs;
+        std::vector<std::shared_ptr<HostTensor>> m_outputs;
+    };
+
+    /// \brief A position in the dispatch table where a call's input or output tensor is bound.
+    struct ExternalBinding
+    {
+        /// index into the call's inputs, or outputs if m_is_result
+        size_t m_index;
+        bool m_is_result;
+        size_t m_step;
+        size_t m_position;
+    };
+
+    /// \brief Backing storage for the intermediate tensors of a single call. The tensors are
+    /// views into m_buffer at the offsets assigned by pass::MemoryLayout, pre-bound to the
+    /// argument lists of every CallStep.
+    struct MemoryArena
+    {
+        AlignedBuffer m_buffer;
+        std::vector<std::vector<std::shared_ptr<HostTensor>>> m_step_inputs;
+        std::vector<std::vector<std::shared_ptr<HostTensor>>> m_step_outputs;
+        /// indexed by step, empty for steps without a fused kernel
+        std::vector<FusedScratch> m_fused_scratch;
+        /// indexed by step, empty for steps without a loop
+        std::vector<LoopScratch> m_loop_scratch;
+        /// indexed by step, the all-reduce an AllReduceStart step has started
+        std::vector<std::shared_ptr<DistributedInterface::Request>> m_all_reduce_requests;
+        /// backs the WidenedScratch of all steps, which overlap unless steps run in parallel
+        AlignedBuffer m_widened_buffer;
+        /// indexed by step, empty for steps that aren't widened
+        std::vector<WidenedScratch> m_widened_scratch;
+    };
+
+    /// \brief Assign arena offsets to all intermediate tensors of m_function and bind the
+    /// constant outputs to the constants' own data. Requires pass::Liveness to have been run.
+    void build_memory_plan();
+
+    /// \brief Resolve every executable node into m_call_steps. Called lazily on the first call
+    /// so that derived executables can supply their kernels through get_kernel.
+    void build_call_steps();
+
+    /// \brief Run m_call_steps[step_index] on the tensors bound in `arena`.
+    void run_step(size_t step_index, MemoryArena& arena);
+
+    /// \brief Build the blocked execution plan of a kernel from pass::ElementwiseFusion.
+    std::shared_ptr<FusedKernel> build_fused_kernel(const op::CompiledKernel& kernel);
+
+    /// \brief Allocate the scratch buffers of `fused` and bind them to its stages.
+    void bind_fused_scratch(const FusedKernel& fused, FusedScratch& scratch) const;
+
+    /// \brief Run a fused kernel block by block.
+    void run_fused_kernel(const FusedKernel& fused,
+                          FusedScratch& scratch,
+                          const std::vector<std::shared_ptr<HostTensor>>& out,
+                          const std::vector<std::shared_ptr<HostTensor>>& args);
+
+    /// \brief Allocate the f32 copies of the widened steps in `arena`.
+    void bind_widened_scratch(MemoryArena& arena) const;
+
+    /// \brief Run a widened step on f32 copies of its half-precision tensors.
+    ///
+    /// The copies hold whole tensors because the f32 kernels take whole tensors; only fused
+    /// elementwise chains widen block by block. When steps run one at a time their copies share
+    /// memory, so the extra memory is that of the largest widened step.
+    void run_widened(const CallStep& step,
+                     const WidenedScratch& scratch,
+                     const std::vector<std::shared_ptr<HostTensor>>& out,
+                     const std::vector<std::shared_ptr<HostTensor>>& args);
+
+    /// \brief Run all steps on m_thread_pool, starting each one as soon as the steps it
+    /// depends on have finished.
+    void run_steps_parallel(MemoryArena& arena);
+
+    /// \brief Compile the body of a TensorIterator and plan how its tensors are bound.
+    std::shared_ptr<Loop> build_loop(const op::TensorIterator& tensor_iterator);
+
+    /// \brief The executable that runs a loop body. Derived backends return their own
+    /// executable type so bodies run on the same kernels.
+    virtual std::shared_ptr<INTExecutable>
+        compile_loop_body(const std::shared_ptr<Function>& body) const;
+
+    /// \brief Allocate the body tensors of `loop` that can't be views.
+    static void bind_loop_scratch(const Loop& loop, LoopScratch& scratch);
+
+    /// \brief Run a TensorIterator by calling its body once per iteration. Copied windows and
+    /// results use the buffers of `scratch`, contiguous windows are wrapped in a new view on
+    /// every iteration.
+    static void run_loop(const Loop& loop,
+                         LoopScratch& scratch,
+                         const std::vector<std::shared_ptr<HostTensor>>& out,
+                         const std::vector<std::shared_ptr<HostTensor>>& args);
+
+    /// \brief Take an arena from the free list, creating one if none is available. The arena
+    /// is returned to the free list when the last reference is released, so concurrent calls
+    /// each get their own storage.
+    std::shared_ptr<MemoryArena> acquire_memory_arena();
+
+    /// \brief The element type that selects the kernel instantiation for a node.
+    static element::Type get_dispatch_type(const Node& node, OP_TYPEID type_id);
+
+    /// \brief The kernel that runs nodes dispatched on element type `type`, or nullptr if
+    /// there is none.
+    virtual Kernel get_kernel(const element::Type& type) const;
+
+    size_t m_memory_pool_size = 0;
+    std::unordered_map<descriptor::Tensor*, std::shared_ptr<HostTensor>> m_constant_tensors;
+    std::vector<std::unique_ptr<MemoryArena>> m_free_arenas;
+    std::mutex m_arena_mutex;
+    std::vector<CallStep> m_call_steps;
+    std::vector<ExternalBinding> m_external_bindings;
+    std::once_flag m_call_steps_flag;
+
+    /// Number of threads used to run independent ops concurrently. Set from
+    /// NGRAPH_INTERPRETER_THREADS, values below 2 run ops sequentially in m_nodes order.
+    size_t m_thread_count = 1;
+    std::shared_ptr<ThreadPool> m_thread_pool;
+    std::vector<std::vector<size_t>> m_step_successors;
+    std::vector<size_t> m_step_dependency_counts;
+    std::mutex m_states_mutex;
+
     static OP_TYPEID get_typeid(const Node& node);
 
     static void perform_nan_check(const std::vector<std::shared_ptr<HostTensor>>&,
@@ -197,7 +495,8 @@ protected:
                                 const std::vector<std::shared_ptr<HostTensor>>& inputs);
 
     template <typename T>
-    void op_engine(const Node& node,
+    void op_engine(OP_TYPEID type_id,
+                   const Node& node,
                    const std::vector<std::shared_ptr<HostTensor>>& out,
                    const std::vector<std::shared_ptr<HostTensor>>& args)
     {
@@ -209,7 +508,7 @@ protected:
 #pragma GCC diagnostic error "-Wswitch"
 #pragma GCC diagnostic error "-Wswitch-enum"
 #endif
-        switch (get_typeid(node))
+        switch (type_id)
         {
         case OP_TYPEID::Abs:
         {
@@ -371,6 +670,7 @@ protected:
         case OP_TYPEID::GenerateMask:
         {
             bool use_seed = static_cast<bool>(args[2]->get_data_ptr<const int32_t>()[0]);
+            std::unique_lock<std::mutex> states_lock(m_states_mutex);
             if (m_states.count(&node) == 0)
             {
                 const op::GenerateMask* gm = static_cast<const op::GenerateMask*>(&node);
@@ -381,6 +681,7 @@ protected:
 
             bool training = static_cast<bool>(args[0]->get_data_ptr<const T>()[0]);
             auto state = static_cast<BernoulliRNGState*>(m_states.at(&node).get());
+            states_lock.unlock();
             size_t element_count = shape_size(node.get_output_shape(0));
             if (!use_seed)
             {
@@ -606,11 +907,19 @@ protected:
                                       out[0]->get_data_ptr<uint64_t>(),
                                       element_count);
                 break;
+            case element::Type_t::bf16:
+                reference::convert<T>(args[0]->get_data_ptr<const T>(),
+                                      out[0]->get_data_ptr<bfloat16>(),
+                                      element_count);
+                break;
+            case element::Type_t::f16:
+                reference::convert<T>(args[0]->get_data_ptr<const T>(),
+                                      out[0]->get_data_ptr<float16>(),
+                                      element_count);
+                break;
             case element::Type_t::undefined:
             case element::Type_t::dynamic:
             case element::Type_t::u1:
-            case element::Type_t::bf16:
-            case element::Type_t::f16:
                 ss << "unsupported element type " << type << " op Convert";
                 throw std::runtime_error(ss.str());
             }
@@ -1489,12 +1798,14 @@ protected:
             // static output shapes anyway.
             bool use_fixed_seed = static_cast<bool>(args[3]->get_data_ptr<const char>()[0]);
 
+            std::unique_lock<std::mutex> states_lock(m_states_mutex);
             if (m_states.count(&node) == 0)
             {
                 m_states[&node] = std::unique_ptr<UniformRNGState>(new UniformRNGState());
             }
 
             auto state = static_cast<UniformRNGState*>(m_states.at(&node).get());
+            states_lock.unlock();
             size_t element_count = shape_size(node.get_output_shape(0));
             if (!use_fixed_seed)
             {
@@ -1885,8 +2196,13 @@ protected:
         case OP_TYPEID::Squeeze:
         case OP_TYPEID::Stack:
         case OP_TYPEID::Unsqueeze:
-        // Tensor Iterator not yet supported
+        // Fused kernels are run by run_fused_kernel
+        case OP_TYPEID::CompiledKernel:
+        // Loops are run by run_loop
         case OP_TYPEID::TensorIterator:
+        // Asynchronous all-reduces keep their requests in the memory arena, see run_step
+        case OP_TYPEID::AllReduceStart:
+        case OP_TYPEID::AllReduceWait:
         case OP_TYPEID::UnknownOp:
             throw unsupported_op("Unsupported op '" + node.description() + "'");
 #if defined(__GNUC__) && !(__GNUC__ == 4 && __GNUC_MINOR__ == 8)
@@ -0,0 +1,167 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <map>
+
+#include "ngraph/runtime/interpreter/int_thread_pool.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace
+{
+    // The pool and queue the current thread works on, if it is a worker
+    thread_local const runtime::interpreter::ThreadPool* s_current_pool = nullptr;
+    thread_local size_t s_current_queue = 0;
+}
+
+runtime::interpreter::ThreadPool::ThreadPool(size_t thread_count)
+{
+    // One queue per worker plus one shared by all other threads
+    for (size_t i = 0; i <= thread_count; i++)
+    {
+        m_queues.emplace_back(new WorkQueue());
+    }
+    for (size_t i = 0; i < thread_count; i++)
+    {
+        m_threads.emplace_back(&ThreadPool::worker, this, i);
+    }
+}
+
+runtime::interpreter::ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_condition.notify_all();
+    for (thread& t : m_threads)
+    {
+        t.join();
+    }
+}
+
+shared_ptr<runtime::interpreter::ThreadPool>
+    runtime::interpreter::ThreadPool::get_shared(size_t thread_count)
+{
+    static mutex s_pools_mutex;
+    static map<size_t, weak_ptr<ThreadPool>> s_pools;
+
+    lock_guard<mutex> lock(s_pools_mutex);
+    shared_ptr<ThreadPool> pool = s_pools[thread_count].lock();
+    if (!pool)
+    {
+        pool = make_shared<ThreadPool>(thread_count);
+        s_pools[thread_count] = pool;
+    }
+    return pool;
+}
+
+size_t runtime::interpreter::ThreadPool::get_queue_index() const
+{
+    return s_current_pool == this ? s_current_queue : m_threads.size();
+}
+
+void runtime::interpreter::ThreadPool::submit(Task task)
+{
+    WorkQueue& queue = *m_queues[get_queue_index()];
+    {
+        lock_guard<mutex> lock(queue.m_mutex);
+        queue.m_tasks.push_back(move(task));
+    }
+    {
+        lock_guard<mutex> lock(m_mutex);
+        ++m_pending;
+    }
+    m_condition.notify_one();
+}
+
+bool runtime::interpreter::ThreadPool::try_pop(size_t queue_index, Task& task)
+{
+    // Newest task from our own queue first, it is most likely to be cache hot
+    {
+        WorkQueue& queue = *m_queues[queue_index];
+        lock_guard<mutex> lock(queue.m_mutex);
+        if (!queue.m_tasks.empty())
+        {
+            task = move(queue.m_tasks.back());
+            queue.m_tasks.pop_back();
+            --m_pending;
+            return true;
+        }
+    }
+    // Otherwise steal the oldest task from someone else
+    for (size_t i = 1; i < m_queues.size(); i++)
+    {
+        WorkQueue& queue = *m_queues[(queue_index + i) % m_queues.size()];
+        lock_guard<mutex> lock(queue.m_mutex);
+        if (!queue.m_tasks.empty())
+        {
+            task = move(queue.m_tasks.front());
+            queue.m_tasks.pop_front();
+            --m_pending;
+            return true;
+        }
+    }
+    return false;
+}
+
+void runtime::interpreter::ThreadPool::worker(size_t queue_index)
+{
+    s_current_pool = this;
+    s_current_queue = queue_index;
+    Task task;
+    while (true)
+    {
+        if (try_pop(queue_index, task))
+        {
+            task();
+            task = nullptr;
+            continue;
+        }
+        unique_lock<mutex> lock(m_mutex);
+        m_condition.wait(lock, [this]() { return m_stop || m_pending > 0; });
+        if (m_stop)
+        {
+            break;
+        }
+    }
+}
+
+void runtime::interpreter::ThreadPool::run_until(const function<bool()>& done)
+{
+    size_t queue_index = get_queue_index();
+    Task task;
+    while (!done())
+    {
+        if (try_pop(queue_index, task))
+        {
+            task();
+            task = nullptr;
+            continue;
+        }
+        unique_lock<mutex> lock(m_mutex);
+        m_condition.wait(lock, [this, &done]() { return m_pending > 0 || done(); });
+    }
+}
+
+void runtime::interpreter::ThreadPool::notify()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+    }
+    m_condition.notify_all();
+}
@@ -0,0 +1,86 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace interpreter
+        {
+            class ThreadPool;
+        }
+    }
+}
+
+/// \brief A work-stealing thread pool used by the INTERPRETER to run independent ops
+/// concurrently. Every worker owns a queue; tasks submitted from a worker go to its own queue
+/// and idle workers steal from the others. Threads that are not workers share one extra
+/// queue and help run tasks while they wait in run_until.
+class ngraph::runtime::interpreter::ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t thread_count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t get_thread_count() const { return m_threads.size(); }
+    /// \brief Queue a task for execution
+    void submit(Task task);
+
+    /// \brief Run queued tasks on the calling thread until done() returns true. Whoever makes
+    /// done() true must call notify() afterwards.
+    void run_until(const std::function<bool()>& done);
+
+    /// \brief Wake up threads blocked in run_until
+    void notify();
+
+    /// \brief Get a pool with `thread_count` workers that is shared by all of its users. The
+    /// pool is destroyed when the last user releases it.
+    static std::shared_ptr<ThreadPool> get_shared(size_t thread_count);
+
+private:
+    struct WorkQueue
+    {
+        std::mutex m_mutex;
+        std::deque<Task> m_tasks;
+    };
+
+    size_t get_queue_index() const;
+    bool try_pop(size_t queue_index, Task& task);
+    void worker(size_t queue_index);
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::atomic<size_t> m_pending{0};
+    bool m_stop = false;
+};
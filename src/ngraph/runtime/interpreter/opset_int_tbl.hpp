@@ -16,6 +16,8 @@
 
 #define ID_SUFFIX(NAME) NAME
 #include "ngraph/opsets/opset0_tbl.hpp"
+// Elementwise chains grouped by pass::ElementwiseFusion
+NGRAPH_OP(CompiledKernel, op)
 #undef ID_SUFFIX
 
 #define ID_SUFFIX(NAME) NAME##_v1
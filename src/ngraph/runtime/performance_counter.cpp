@@ -0,0 +1,233 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <map>
+
+#include "ngraph/op/avg_pool.hpp"
+#include "ngraph/op/convolution.hpp"
+#include "ngraph/op/dot.hpp"
+#include "ngraph/op/experimental/batch_mat_mul.hpp"
+#include "ngraph/op/experimental/compiled_kernel.hpp"
+#include "ngraph/op/fused/group_conv.hpp"
+#include "ngraph/op/fused/matmul.hpp"
+#include "ngraph/op/max_pool.hpp"
+#include "ngraph/op/util/arithmetic_reduction.hpp"
+#include "ngraph/runtime/performance_counter.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+static size_t tensor_bytes(const element::Type& type, const PartialShape& shape)
+{
+    return shape.is_static() && type.is_static() ? shape_size(shape.to_shape()) * type.size() : 0;
+}
+
+static double per_microsecond(size_t amount, size_t microseconds)
+{
+    // amount per microsecond is thousands of amount per second
+    return microseconds == 0 ? 0 : static_cast<double>(amount) / microseconds / 1000;
+}
+
+static double per_byte(size_t flops, size_t bytes)
+{
+    return bytes == 0 ? 0 : static_cast<double>(flops) / bytes;
+}
+
+runtime::PerformanceCounter::PerformanceCounter(const shared_ptr<const Node>& n,
+                                                size_t us,
+                                                size_t calls)
+    : m_node(n)
+    , m_total_microseconds(us)
+    , m_call_count(calls)
+    , m_bytes_read(0)
+    , m_bytes_written(0)
+    , m_flops(0)
+{
+    if (n == nullptr)
+    {
+        return;
+    }
+    for (const Input<const Node>& input : n->inputs())
+    {
+        m_bytes_read += tensor_bytes(input.get_element_type(), input.get_partial_shape());
+    }
+    for (const Output<const Node>& output : n->outputs())
+    {
+        m_bytes_written += tensor_bytes(output.get_element_type(), output.get_partial_shape());
+    }
+    m_flops = estimate_flops(*n);
+}
+
+double runtime::PerformanceCounter::gflops_per_second() const
+{
+    return per_microsecond(m_flops * m_call_count, m_total_microseconds);
+}
+
+double runtime::PerformanceCounter::gigabytes_per_second() const
+{
+    return per_microsecond((m_bytes_read + m_bytes_written) * m_call_count, m_total_microseconds);
+}
+
+double runtime::PerformanceCounter::arithmetic_intensity() const
+{
+    return per_byte(m_flops, m_bytes_read + m_bytes_written);
+}
+
+double runtime::PerformanceSummary::gflops_per_second() const
+{
+    return per_microsecond(total_flops, total_microseconds);
+}
+
+double runtime::PerformanceSummary::gigabytes_per_second() const
+{
+    return per_microsecond(total_bytes_read + total_bytes_written, total_microseconds);
+}
+
+double runtime::PerformanceSummary::arithmetic_intensity() const
+{
+    return per_byte(total_flops, total_bytes_read + total_bytes_written);
+}
+
+size_t runtime::estimate_flops(const Node& node)
+{
+    for (const Output<const Node>& output : node.outputs())
+    {
+        if (output.get_partial_shape().is_dynamic())
+        {
+            return 0;
+        }
+    }
+    for (const Input<const Node>& input : node.inputs())
+    {
+        if (input.get_partial_shape().is_dynamic())
+        {
+            return 0;
+        }
+    }
+    if (node.get_output_size() == 0)
+    {
+        return 0;
+    }
+
+    if (auto kernel = as_type<const op::CompiledKernel>(&node))
+    {
+        size_t flops = 0;
+        for (const shared_ptr<Node>& kernel_node : kernel->get_node_list())
+        {
+            flops += estimate_flops(*kernel_node);
+        }
+        return flops;
+    }
+
+    size_t output_size = shape_size(node.get_output_shape(0));
+    if (auto dot = as_type<const op::v0::Dot>(&node))
+    {
+        const Shape& arg0_shape = node.get_input_shape(0);
+        size_t terms = 1;
+        for (size_t i = arg0_shape.size() - dot->get_reduction_axes_count(); i < arg0_shape.size();
+             i++)
+        {
+            terms *= arg0_shape[i];
+        }
+        return 2 * output_size * terms;
+    }
+    if (auto matmul = as_type<const op::v0::MatMul>(&node))
+    {
+        const Shape& arg0_shape = node.get_input_shape(0);
+        if (arg0_shape.empty())
+        {
+            return output_size;
+        }
+        size_t rank = arg0_shape.size();
+        size_t terms = matmul->get_transpose_a() && rank > 1 ? arg0_shape[rank - 2]
+                                                              : arg0_shape[rank - 1];
+        return 2 * output_size * terms;
+    }
+    if (is_type<const op::BatchMatMul>(&node))
+    {
+        return 2 * output_size * node.get_input_shape(0).back();
+    }
+    if (is_type<const op::v0::Convolution>(&node) || is_type<const op::v1::Convolution>(&node) ||
+        is_type<const op::v0::GroupConvolution>(&node) ||
+        is_type<const op::v1::GroupConvolution>(&node))
+    {
+        // Each output element sums over the filter elements of its output channel
+        const Shape& output_shape = node.get_output_shape(0);
+        size_t output_channels = output_shape.size() > 1 ? output_shape[1] : 1;
+        if (output_channels == 0)
+        {
+            return 0;
+        }
+        return 2 * output_size * (shape_size(node.get_input_shape(1)) / output_channels);
+    }
+    if (auto pool = as_type<const op::v0::AvgPool>(&node))
+    {
+        return output_size * shape_size(pool->get_window_shape());
+    }
+    if (auto pool = as_type<const op::v1::AvgPool>(&node))
+    {
+        return output_size * shape_size(pool->get_kernel());
+    }
+    if (auto pool = as_type<const op::v0::MaxPool>(&node))
+    {
+        return output_size * shape_size(pool->get_window_shape());
+    }
+    if (auto pool = as_type<const op::v1::MaxPool>(&node))
+    {
+        return output_size * shape_size(pool->get_kernel());
+    }
+    if (dynamic_cast<const op::util::ArithmeticReduction*>(&node) != nullptr)
+    {
+        return shape_size(node.get_input_shape(0));
+    }
+    if (node.is_unary_elementwise_arithmetic() || node.is_binary_elementwise_arithmetic() ||
+        node.is_binary_elementwise_comparison() || node.is_binary_elementwise_logical())
+    {
+        return output_size;
+    }
+    return 0;
+}
+
+vector<runtime::PerformanceSummary>
+    runtime::summarize_by_op_type(const vector<PerformanceCounter>& counters)
+{
+    map<string, PerformanceSummary> summaries;
+    for (const PerformanceCounter& counter : counters)
+    {
+        string op_type = counter.get_node() ? counter.get_node()->description() : "";
+        PerformanceSummary& summary = summaries[op_type];
+        summary.op_type = op_type;
+        summary.op_count++;
+        summary.call_count += counter.call_count();
+        summary.total_microseconds += counter.total_microseconds();
+        summary.total_bytes_read += counter.bytes_read() * counter.call_count();
+        summary.total_bytes_written += counter.bytes_written() * counter.call_count();
+        summary.total_flops += counter.flops() * counter.call_count();
+    }
+
+    vector<PerformanceSummary> result;
+    for (auto& summary : summaries)
+    {
+        result.push_back(summary.second);
+    }
+    stable_sort(result.begin(),
+                result.end(),
+                [](const PerformanceSummary& a, const PerformanceSummary& b) {
+                    return a.total_microseconds > b.total_microseconds;
+                });
+    return result;
+}
@@ -18,6 +18,7 @@
 
 #include <cstddef>
 #include <string>
+#include <vector>
 
 #include "ngraph/node.hpp"
 
@@ -25,15 +26,16 @@ namespace ngraph
 {
     namespace runtime
     {
+        /// \brief Execution statistics of one op of an Executable.
+        ///
+        /// Besides the time measured by the backend, a counter carries estimates of the bytes an
+        /// op reads and writes and of the arithmetic operations it performs per call, taken from
+        /// the shapes of the node. They give the achieved throughput of the op, to be compared
+        /// with the peak memory bandwidth and compute rate of the device.
         class NGRAPH_API PerformanceCounter
         {
         public:
-            PerformanceCounter(const std::shared_ptr<const Node>& n, size_t us, size_t calls)
-                : m_node(n)
-                , m_total_microseconds(us)
-                , m_call_count(calls)
-            {
-            }
+            PerformanceCounter(const std::shared_ptr<const Node>& n, size_t us, size_t calls);
             std::shared_ptr<const Node> get_node() const { return m_node; }
             size_t total_microseconds() const { return m_total_microseconds; }
             size_t microseconds() const
@@ -41,9 +43,55 @@ namespace ngraph
                 return m_call_count == 0 ? 0 : m_total_microseconds / m_call_count;
             }
             size_t call_count() const { return m_call_count; }
+            /// \brief Estimated bytes of the inputs read by one call
+            size_t bytes_read() const { return m_bytes_read; }
+            /// \brief Estimated bytes of the outputs written by one call
+            size_t bytes_written() const { return m_bytes_written; }
+            /// \brief Estimated arithmetic operations of one call, see estimate_flops
+            size_t flops() const { return m_flops; }
+            /// \brief Achieved GFLOP/s over all calls, 0 if no time was measured
+            double gflops_per_second() const;
+            /// \brief Achieved memory traffic in GB/s over all calls, 0 if no time was measured
+            double gigabytes_per_second() const;
+            /// \brief FLOPs per byte moved, the x coordinate of the op in a roofline plot
+            double arithmetic_intensity() const;
+
             std::shared_ptr<const Node> m_node;
             size_t m_total_microseconds;
             size_t m_call_count;
+            size_t m_bytes_read;
+            size_t m_bytes_written;
+            size_t m_flops;
         };
+
+        /// \brief Statistics of all the ops of one type, see summarize_by_op_type
+        struct NGRAPH_API PerformanceSummary
+        {
+            std::string op_type;
+            size_t op_count = 0;
+            size_t call_count = 0;
+            size_t total_microseconds = 0;
+            size_t total_bytes_read = 0;
+            size_t total_bytes_written = 0;
+            size_t total_flops = 0;
+
+            double gflops_per_second() const;
+            double gigabytes_per_second() const;
+            double arithmetic_intensity() const;
+        };
+
+        /// \brief Estimate the arithmetic operations of one execution of `node`.
+        ///
+        /// Contractions (Dot, MatMul, BatchMatMul, convolutions) count a multiply and an add per
+        /// term, pooling one operation per window element, reductions one per input element and
+        /// elementwise ops one per output element. Data movement ops and ops whose shapes are
+        /// not static count 0.
+        NGRAPH_API
+        size_t estimate_flops(const Node& node);
+
+        /// \brief Total the counters of each op type, by decreasing total time
+        NGRAPH_API
+        std::vector<PerformanceSummary>
+            summarize_by_op_type(const std::vector<PerformanceCounter>& counters);
     }
 }
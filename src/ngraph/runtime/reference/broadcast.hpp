@@ -16,9 +16,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/axis_set.hpp"
+#include "ngraph/check.hpp"
+#include "ngraph/strided_walk.hpp"
 #include "ngraph/shape_util.hpp"
 
 namespace ngraph
@@ -53,15 +56,41 @@ namespace ngraph
                         adjusted_axes.insert(axis);
                     }
                 }
-                CoordinateTransform input_transform(adjusted_in_shape);
-                CoordinateTransform output_transform(out_shape);
-
-                for (const Coordinate& output_coord : output_transform)
+                // Every output axis that is not broadcast walks the next remaining input axis;
+                // broadcast axes repeat the input with a zero stride.
+                std::vector<std::ptrdiff_t> in_dense_strides =
+                    StridedWalk::dense_strides(adjusted_in_shape);
+                std::vector<std::ptrdiff_t> in_strides(out_shape.size(), 0);
+                size_t in_axis = 0;
+                for (size_t axis = 0; axis < out_shape.size(); ++axis)
                 {
-                    Coordinate input_coord = reduce(output_coord, adjusted_axes);
-                    out[output_transform.index(output_coord)] =
-                        arg[input_transform.index(input_coord)];
+                    if (adjusted_axes.count(axis) == 0)
+                    {
+                        NGRAPH_CHECK(in_axis < adjusted_in_shape.size() &&
+                                     adjusted_in_shape[in_axis] == out_shape[axis]);
+                        in_strides[axis] = in_dense_strides[in_axis++];
+                    }
                 }
+                NGRAPH_CHECK(in_axis == adjusted_in_shape.size());
+
+                StridedWalk walk(out_shape, {in_strides, StridedWalk::dense_strides(out_shape)});
+                const size_t run_length = walk.get_run_length();
+                const std::ptrdiff_t in_stride = walk.get_run_stride(0);
+                walk.for_each_run([&](const std::ptrdiff_t* offsets) {
+                    const T* src = arg + offsets[0];
+                    T* dst = out + offsets[1];
+                    if (in_stride == 0)
+                    {
+                        std::fill(dst, dst + run_length, *src);
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < run_length; i++)
+                        {
+                            dst[i] = src[static_cast<std::ptrdiff_t>(i) * in_stride];
+                        }
+                    }
+                });
             }
         }
     }
@@ -23,6 +23,7 @@
 #include "ngraph/axis_vector.hpp"
 #include "ngraph/coordinate_transform.hpp"
 #include "ngraph/runtime/reference/reverse.hpp"
+#include "ngraph/strided_walk.hpp"
 #include "ngraph/util.hpp"
 
 namespace ngraph
@@ -65,7 +66,7 @@ namespace ngraph
                                      const Strides& stride,
                                      const Strides& filter_dilation,
                                      const CoordinateDiff& in_pad_below,
-                                     const CoordinateDiff& in_pad_above,
+                                     const CoordinateDiff& /* in_pad_above */,
                                      const Strides& in_dilation,
                                      size_t in_batch_axis,
                                      size_t in_channel_axis,
@@ -99,6 +100,12 @@ namespace ngraph
                 // At the outermost level we will walk over every out coordinate O.
                 CoordinateTransform out_transform(out_shape);
 
+                std::vector<std::ptrdiff_t> in_strides = StridedWalk::dense_strides(in_shape);
+                std::vector<std::ptrdiff_t> filter_strides =
+                    StridedWalk::dense_strides(filter_shape);
+                std::ptrdiff_t in_channel_stride = in_strides[in_channel_axis];
+                std::ptrdiff_t filter_in_channel_stride = filter_strides[filter_in_channel_axis];
+
                 for (const Coordinate& out_coord : out_transform)
                 {
                     // Our out coordinate O will have the form:
@@ -127,57 +134,8 @@ namespace ngraph
                     //   (1,l_1,...,l_n).
                     //
                     // Note that we are iterating within the *padded* and *dilated* in batch, so
-                    // further down we must check the current coordinate is in the pad or dilation
-                    // gap.
-
-                    size_t n_spatial_dimensions = in_shape.size() - 2;
-                    size_t n_in_channels = in_shape[in_channel_axis];
-
-                    Coordinate in_transform_start(2 + n_spatial_dimensions);
-                    Coordinate in_transform_end(2 + n_spatial_dimensions);
-                    Strides in_transform_movement_strides(2 + n_spatial_dimensions, 1);
-                    CoordinateDiff in_transform_pad_below(2 + n_spatial_dimensions, 0);
-                    CoordinateDiff in_transform_pad_above(2 + n_spatial_dimensions, 0);
-                    Strides in_transform_dilation_strides(2 + n_spatial_dimensions, 1);
-
-                    in_transform_start[in_batch_axis] = batch_index;
-                    in_transform_end[in_batch_axis] = batch_index + 1;
-                    in_transform_start[in_channel_axis] = 0;
-                    in_transform_end[in_channel_axis] = 1;
-
-                    for (size_t i = 2; i < n_spatial_dimensions + 2; i++)
-                    {
-                        size_t filter_dilation_stride = filter_dilation[i - 2];
-                        size_t filter_movement_stride = stride[i - 2];
-                        std::ptrdiff_t below_pad = in_pad_below[i - 2];
-                        std::ptrdiff_t above_pad = in_pad_above[i - 2];
-                        size_t in_dilation_stride = in_dilation[i - 2];
-
-                        in_transform_start[i] = filter_movement_stride * out_coord[i];
-                        in_transform_end[i] = in_transform_start[i] +
-                                              (filter_shape[i] - 1) * filter_dilation_stride + 1;
-                        in_transform_movement_strides[i] = filter_dilation_stride;
-                        in_transform_pad_below[i] = below_pad;
-                        in_transform_pad_above[i] = above_pad;
-                        in_transform_dilation_strides[i] = in_dilation_stride;
-                    }
-
-                    AxisVector in_transform_axis_order(2 + n_spatial_dimensions);
-                    for (size_t i = 0; i < in_transform_axis_order.size(); i++)
-                    {
-                        in_transform_axis_order[i] = i;
-                    }
-                    CoordinateTransform in_transform(in_shape,
-                                                     in_transform_start,
-                                                     in_transform_end,
-                                                     in_transform_movement_strides,
-                                                     in_transform_axis_order,
-                                                     in_transform_pad_below,
-                                                     in_transform_pad_above,
-                                                     in_transform_dilation_strides);
-
-                    // Simultaneously with iterating I, for the filter we need to iterate the
-                    // coordinate:
+                    // only some of these coordinates map to a real in element. Simultaneously,
+                    // for the filter we iterate the coordinate:
                     //
                     //   F
                     //
@@ -191,23 +149,72 @@ namespace ngraph
                     //      filter_dims_n)
                     //
                     // with unit stride.
+                    //
+                    // Along each spatial axis the filter taps that land on a real in element
+                    // form an arithmetic progression, so the surviving (I,F) pairs are exactly
+                    // a strided walk over both tensors and nothing else needs to be visited.
 
-                    Shape filter_transform_start(2 + n_spatial_dimensions);
-                    Shape filter_transform_end(2 + n_spatial_dimensions);
+                    size_t n_spatial_dimensions = in_shape.size() - 2;
+                    size_t n_in_channels = in_shape[in_channel_axis];
 
-                    filter_transform_start[filter_out_channel_axis] = out_channel;
-                    filter_transform_end[filter_out_channel_axis] = out_channel + 1;
-                    filter_transform_start[filter_in_channel_axis] = 0;
-                    filter_transform_end[filter_in_channel_axis] = 1;
+                    Shape tap_shape(n_spatial_dimensions);
+                    std::vector<std::ptrdiff_t> in_tap_strides(n_spatial_dimensions);
+                    std::vector<std::ptrdiff_t> filter_tap_strides(n_spatial_dimensions);
+                    std::ptrdiff_t in_offset =
+                        static_cast<std::ptrdiff_t>(batch_index) * in_strides[in_batch_axis];
+                    std::ptrdiff_t filter_offset = static_cast<std::ptrdiff_t>(out_channel) *
+                                                   filter_strides[filter_out_channel_axis];
 
                     for (size_t i = 2; i < n_spatial_dimensions + 2; i++)
                     {
-                        filter_transform_start[i] = 0;
-                        filter_transform_end[i] = filter_shape[i];
-                    }
+                        std::ptrdiff_t filter_dilation_stride = filter_dilation[i - 2];
+                        std::ptrdiff_t in_dilation_stride = in_dilation[i - 2];
+                        std::ptrdiff_t in_length = static_cast<std::ptrdiff_t>(in_shape[i]);
+                        std::ptrdiff_t filter_length =
+                            static_cast<std::ptrdiff_t>(filter_shape[i]);
+
+                        // Position of tap 0 in the dilated, unpadded in.
+                        std::ptrdiff_t first =
+                            static_cast<std::ptrdiff_t>(stride[i - 2] * out_coord[i]) -
+                            in_pad_below[i - 2];
+                        auto is_source = [&](std::ptrdiff_t j) {
+                            std::ptrdiff_t q = first + j * filter_dilation_stride;
+                            return q >= 0 && q % in_dilation_stride == 0 &&
+                                   q / in_dilation_stride < in_length;
+                        };
+
+                        std::ptrdiff_t j0 = 0;
+                        while (j0 < filter_length && !is_source(j0))
+                        {
+                            j0++;
+                        }
+                        std::ptrdiff_t a = filter_dilation_stride;
+                        std::ptrdiff_t b = in_dilation_stride;
+                        while (b != 0)
+                        {
+                            std::ptrdiff_t r = a % b;
+                            a = b;
+                            b = r;
+                        }
+                        std::ptrdiff_t tap_step = in_dilation_stride / a;
+                        size_t tap_count = 0;
+                        for (std::ptrdiff_t j = j0; j < filter_length && is_source(j);
+                             j += tap_step)
+                        {
+                            tap_count++;
+                        }
 
-                    CoordinateTransform filter_transform(
-                        filter_shape, filter_transform_start, filter_transform_end);
+                        tap_shape[i - 2] = tap_count;
+                        in_tap_strides[i - 2] =
+                            tap_step * filter_dilation_stride / in_dilation_stride * in_strides[i];
+                        filter_tap_strides[i - 2] = tap_step * filter_strides[i];
+                        if (tap_count > 0)
+                        {
+                            in_offset += (first + j0 * filter_dilation_stride) /
+                                         in_dilation_stride * in_strides[i];
+                            filter_offset += j0 * filter_strides[i];
+                        }
+                    }
 
                     // As we go, we sum up:
                     //
@@ -215,23 +222,19 @@ namespace ngraph
 
                     ACCUMULATION result = 0;
 
-                    CoordinateTransform::Iterator in_it = in_transform.begin();
-                    CoordinateTransform::Iterator filter_it = filter_transform.begin();
-                    CoordinateTransform::Iterator in_it_end = in_transform.end();
-                    CoordinateTransform::Iterator filter_it_end = filter_transform.end();
-
-                    size_t in_channel_stride = row_major_strides(in_shape).at(in_channel_axis);
-                    size_t filter_in_channel_stride =
-                        row_major_strides(filter_shape).at(filter_in_channel_axis);
-
-                    while (in_it != in_it_end && filter_it != filter_it_end)
-                    {
-                        const Coordinate& in_coord = *in_it;
-                        if (in_transform.has_source_coordinate(in_coord))
+                    StridedWalk taps(tap_shape,
+                                     {in_tap_strides, filter_tap_strides},
+                                     {in_offset, filter_offset});
+                    const size_t run_length = taps.get_run_length();
+                    const std::ptrdiff_t in_run_stride = taps.get_run_stride(0);
+                    const std::ptrdiff_t filter_run_stride = taps.get_run_stride(1);
+                    taps.for_each_run([&](const std::ptrdiff_t* offsets) {
+                        for (size_t tap = 0; tap < run_length; tap++)
                         {
-                            size_t in_idx = in_transform.index(in_coord);
-                            const Coordinate& filter_coord = *filter_it;
-                            size_t filter_idx = filter_transform.index(filter_coord);
+                            std::ptrdiff_t in_idx =
+                                offsets[0] + static_cast<std::ptrdiff_t>(tap) * in_run_stride;
+                            std::ptrdiff_t filter_idx =
+                                offsets[1] + static_cast<std::ptrdiff_t>(tap) * filter_run_stride;
                             for (size_t in_channel = 0; in_channel < n_in_channels; ++in_channel)
                             {
                                 ACCUMULATION in_v = static_cast<ACCUMULATION>(in[in_idx]);
@@ -246,9 +249,7 @@ namespace ngraph
                                 filter_idx += filter_in_channel_stride;
                             }
                         }
-                        ++in_it;
-                        ++filter_it;
-                    }
+                    });
                     if (is_quantized)
                     {
                         float scale = *input_scale * *filter_scale / *output_scale;
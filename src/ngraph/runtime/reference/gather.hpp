@@ -16,10 +16,9 @@
 
 #pragma once
 
-#include <numeric>
-
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/check.hpp"
 #include "ngraph/runtime/reference/gather_nd.hpp"
+#include "ngraph/strided_walk.hpp"
 
 namespace ngraph
 {
@@ -72,103 +71,47 @@ namespace ngraph
                 }
                 indices_prime_shape.emplace_back(1);
 
-                // Create a CoordinateTransform for "out" that visits the outer "axis" dimensions
-                size_t out_ndim = static_cast<size_t>(out_shape.size());
-                Coordinate out_outer_start_corner(out_ndim, 0);
-                Coordinate out_outer_end_corner(out_shape);
-                for (size_t i = axis; i < out_ndim; i++)
-                {
-                    out_outer_end_corner[i] = 1;
-                }
-                Strides out_outer_strides(out_ndim, 1);
-                AxisVector out_outer_axis_order(out_ndim);
-                std::iota(out_outer_axis_order.begin(), out_outer_axis_order.end(), 0);
-                CoordinateTransform out_outer_transform(out_shape,
-                                                        out_outer_start_corner,
-                                                        out_outer_end_corner,
-                                                        out_outer_strides,
-                                                        out_outer_axis_order);
-
-                // Create a CoordinateTransform for "params" that visits the outer "axis" dimensions
-                size_t params_ndim = static_cast<size_t>(params_shape.size());
-                Coordinate params_outer_start_corner(params_ndim, 0);
-                Coordinate params_outer_end_corner(params_shape);
-                for (size_t i = axis; i < params_ndim; i++)
+                // The outer "axis" dimensions of params and out, and all but the last dimension
+                // of indices, are dense row-major prefixes, so every sub-problem starts at a
+                // fixed multiple of the corresponding sub-problem size. Walk the pairs
+                // (params_index, indices_index) and keep the three offsets in step.
+                size_t outer_count = 1;
+                for (size_t i = 0; i < axis; i++)
                 {
-                    params_outer_end_corner[i] = 1;
+                    NGRAPH_CHECK(params_shape[i] == out_shape[i]);
+                    outer_count *= params_shape[i];
                 }
-                Strides params_outer_strides(params_ndim, 1);
-                AxisVector params_outer_axis_order(params_ndim);
-                std::iota(params_outer_axis_order.begin(), params_outer_axis_order.end(), 0);
-                CoordinateTransform params_outer_transform(params_shape,
-                                                           params_outer_start_corner,
-                                                           params_outer_end_corner,
-                                                           params_outer_strides,
-                                                           params_outer_axis_order);
-
-                // Create a CoordinateTransform for "indices" that visits only the first element
-                // along inner most axis
-                Coordinate indices_outer_start_corner(indices_ndim, 0);
-                Coordinate indices_outer_end_corner(indices_shape);
-                if (indices_ndim > 0)
+                size_t indices_outer_count = 1;
+                for (size_t i = 0; i + 1 < indices_ndim; i++)
                 {
-                    indices_outer_end_corner[indices_ndim - 1] = 1;
+                    indices_outer_count *= indices_shape[i];
                 }
-                Strides indices_outer_strides(indices_ndim, 1);
-                AxisVector indices_outer_axis_order(indices_ndim);
-                std::iota(indices_outer_axis_order.begin(), indices_outer_axis_order.end(), 0);
-                CoordinateTransform indices_outer_transform(indices_shape,
-                                                            indices_outer_start_corner,
-                                                            indices_outer_end_corner,
-                                                            indices_outer_strides,
-                                                            indices_outer_axis_order);
+                std::ptrdiff_t params_prime_size = shape_size(params_prime_shape);
+                std::ptrdiff_t out_prime_size = shape_size(out_prime_shape);
+                std::ptrdiff_t indices_prime_size = indices_ndim > 0 ? indices_shape.back() : 1;
 
-                // Create an inner CoordinateTransfrom for "out"
-                size_t out_inner_ndim = out_ndim - axis;
-                Shape out_inner_shape(out_shape);
-                out_inner_shape.erase(out_inner_shape.begin(), out_inner_shape.begin() + axis);
-                Coordinate out_inner_start_corner(out_inner_ndim, 0);
-                Coordinate out_inner_end_corner(out_inner_shape);
-                if (indices_ndim > 0)
-                {
-                    out_inner_end_corner[indices_ndim - 1] = 1;
-                }
-                for (size_t i = indices_ndim; i < out_inner_ndim; i++)
-                {
-                    out_inner_end_corner[i] = 1;
-                }
-                Strides out_inner_strides(out_inner_ndim, 1);
-                AxisVector out_inner_axis_order(out_inner_ndim);
-                std::iota(out_inner_axis_order.begin(), out_inner_axis_order.end(), 0);
-                CoordinateTransform out_inner_transform(out_inner_shape,
-                                                        out_inner_start_corner,
-                                                        out_inner_end_corner,
-                                                        out_inner_strides,
-                                                        out_inner_axis_order);
-
-                auto out_outer_coord_iter = out_outer_transform.begin();
-                for (const Coordinate& params_outer_coord : params_outer_transform)
-                {
-                    const T* params_prime =
-                        &params[params_outer_transform.index(params_outer_coord)];
-                    T* out_outer = &out[out_outer_transform.index(*out_outer_coord_iter)];
-
-                    auto out_inner_coord_iter = out_inner_transform.begin();
-                    for (const Coordinate& indices_outer_coord : indices_outer_transform)
+                StridedWalk walk(Shape{outer_count, indices_outer_count},
+                                 {{params_prime_size, 0},
+                                  {0, indices_prime_size},
+                                  {out_prime_size * static_cast<std::ptrdiff_t>(
+                                                        indices_outer_count),
+                                   out_prime_size}});
+                const size_t run_length = walk.get_run_length();
+                const std::ptrdiff_t params_stride = walk.get_run_stride(0);
+                const std::ptrdiff_t indices_stride = walk.get_run_stride(1);
+                const std::ptrdiff_t out_stride = walk.get_run_stride(2);
+                walk.for_each_run([&](const std::ptrdiff_t* offsets) {
+                    for (size_t i = 0; i < run_length; i++)
                     {
-                        const U* indices_prime =
-                            &indices[indices_outer_transform.index(indices_outer_coord)];
-                        T* out_prime = &out_outer[out_inner_transform.index(*out_inner_coord_iter)];
-                        gather_nd<T, U>(params_prime,
-                                        indices_prime,
-                                        out_prime,
+                        std::ptrdiff_t step = static_cast<std::ptrdiff_t>(i);
+                        gather_nd<T, U>(params + offsets[0] + step * params_stride,
+                                        indices + offsets[1] + step * indices_stride,
+                                        out + offsets[2] + step * out_stride,
                                         params_prime_shape,
                                         indices_prime_shape,
                                         out_prime_shape);
-                        out_inner_coord_iter++;
                     }
-                    out_outer_coord_iter++;
-                }
+                });
             }
         }
     }
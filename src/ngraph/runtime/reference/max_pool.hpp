@@ -16,10 +16,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
-#include <numeric>
+#include <limits>
 
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/strided_walk.hpp"
 
 namespace ngraph
 {
@@ -36,87 +38,61 @@ namespace ngraph
                                    const Shape& window_shape,
                                    const Strides& window_movement_strides,
                                    const Shape& padding_below,
-                                   const Shape& padding_above)
+                                   const Shape& /* padding_above */)
             {
-                CoordinateTransform out_transform(out_shape);
-
-                for (const Coordinate& out_coord : out_transform)
-                {
-                    out[out_transform.index(out_coord)] = 0;
-                }
+                std::fill(out, out + shape_size(out_shape), T(0));
 
                 CoordinateTransform delta_transform(delta_shape);
 
+                size_t n_image_dimensions = out_shape.size() - 2;
+                std::vector<std::ptrdiff_t> out_strides = StridedWalk::dense_strides(out_shape);
+                std::vector<std::ptrdiff_t> window_strides(out_strides.begin() + 2,
+                                                           out_strides.end());
+
                 for (const Coordinate& delta_coord : delta_transform)
                 {
-                    size_t img_index = delta_coord[0];
-                    size_t channel = delta_coord[1];
-
-                    size_t n_image_dimensions = out_shape.size() - 2;
-                    Coordinate source_window_transform_start(2 + n_image_dimensions);
-                    Coordinate source_window_transform_end(2 + n_image_dimensions);
-                    Strides source_window_transform_source_strides(2 + n_image_dimensions, 1);
-                    AxisVector source_window_transform_source_axis_order(2 + n_image_dimensions);
-                    CoordinateDiff source_window_transform_padding_below(2 + n_image_dimensions);
-                    CoordinateDiff source_window_transform_padding_above(2 + n_image_dimensions);
-
-                    source_window_transform_start[0] = img_index;
-                    source_window_transform_end[0] = img_index + 1;
-                    source_window_transform_start[1] = channel;
-                    source_window_transform_end[1] = channel + 1;
-                    source_window_transform_padding_below[0] = 0;
-                    source_window_transform_padding_below[1] = 0;
-                    source_window_transform_padding_above[0] = 0;
-                    source_window_transform_padding_above[1] = 0;
-
-                    for (size_t i = 2; i < n_image_dimensions + 2; i++)
+                    // Clip the window over the padded forward input to the unpadded input;
+                    // padding never holds the maximum.
+                    Shape window_extent(n_image_dimensions);
+                    std::ptrdiff_t window_offset =
+                        delta_coord[0] * out_strides[0] + delta_coord[1] * out_strides[1];
+
+                    for (size_t i = 0; i < n_image_dimensions; i++)
                     {
-                        size_t window_shape_this_dim = window_shape[i - 2];
-                        size_t movement_stride = window_movement_strides[i - 2];
-
-                        source_window_transform_start[i] = movement_stride * delta_coord[i];
-                        source_window_transform_end[i] =
-                            source_window_transform_start[i] + window_shape_this_dim;
-                        source_window_transform_padding_below[i] = padding_below[i - 2];
-                        source_window_transform_padding_above[i] = padding_above[i - 2];
+                        std::ptrdiff_t begin =
+                            static_cast<std::ptrdiff_t>(window_movement_strides[i] *
+                                                        delta_coord[i + 2]) -
+                            static_cast<std::ptrdiff_t>(padding_below[i]);
+                        std::ptrdiff_t end = begin + static_cast<std::ptrdiff_t>(window_shape[i]);
+                        begin = std::max<std::ptrdiff_t>(begin, 0);
+                        end = std::min<std::ptrdiff_t>(end, out_shape[i + 2]);
+                        window_extent[i] = end > begin ? static_cast<size_t>(end - begin) : 0;
+                        window_offset += begin * window_strides[i];
                     }
-                    std::iota(begin(source_window_transform_source_axis_order),
-                              end(source_window_transform_source_axis_order),
-                              0);
-
-                    CoordinateTransform source_window_transform(
-                        out_shape,
-                        source_window_transform_start,
-                        source_window_transform_end,
-                        source_window_transform_source_strides,
-                        source_window_transform_source_axis_order,
-                        source_window_transform_padding_below,
-                        source_window_transform_padding_above);
-
-                    Coordinate argmax_coord;
-                    bool argmax_coord_valid = false;
+
+                    std::ptrdiff_t argmax_index = -1;
                     T max_val = 0; // just initializing to keep compiler happy, this 0 is ignored
 
-                    for (const Coordinate& source_window_coord : source_window_transform)
-                    {
-                        if (source_window_transform.has_source_coordinate(source_window_coord))
+                    StridedWalk window(window_extent, {window_strides}, {window_offset});
+                    const size_t run_length = window.get_run_length();
+                    const std::ptrdiff_t run_stride = window.get_run_stride(0);
+                    window.for_each_run([&](const std::ptrdiff_t* offsets) {
+                        std::ptrdiff_t index = offsets[0];
+                        for (size_t j = 0; j < run_length; j++)
                         {
-                            T candidate =
-                                arg_forward[source_window_transform.index(source_window_coord)];
-
-                            if (!argmax_coord_valid || candidate > max_val)
+                            T candidate = arg_forward[index];
+                            if (argmax_index < 0 || candidate > max_val)
                             {
                                 max_val = candidate;
-                                argmax_coord = source_window_coord;
-                                argmax_coord_valid = true;
+                                argmax_index = index;
                             }
+                            index += run_stride;
                         }
-                    }
+                    });
 
-                    if (argmax_coord_valid)
+                    if (argmax_index >= 0)
                     {
-                        out[source_window_transform.index(argmax_coord)] +=
-                            delta[delta_transform.index(delta_coord)];
+                        out[argmax_index] += delta[delta_transform.index(delta_coord)];
                     }
                 }
             }
@@ -129,93 +105,64 @@ namespace ngraph
                           const Shape& window_shape,
                           const Strides& window_movement_strides,
                           const Shape& padding_below,
-                          const Shape& padding_above)
+                          const Shape& /* padding_above */)
             {
                 // At the outermost level we will walk over every output coordinate O.
                 CoordinateTransform output_transform(out_shape);
 
+                size_t n_spatial_dimensions = arg_shape.size() - 2;
+                std::vector<std::ptrdiff_t> arg_strides = StridedWalk::dense_strides(arg_shape);
+                std::vector<std::ptrdiff_t> window_strides(arg_strides.begin() + 2,
+                                                           arg_strides.end());
+
                 for (const Coordinate& out_coord : output_transform)
                 {
                     // Our output coordinate O will have the form:
                     //
                     //   (N,chan,i_1,...,i_n)
-
-                    size_t batch_index = out_coord[0];
-                    size_t channel = out_coord[1];
-
-                    // For the input data we need to iterate the coordinate:
-                    //
-                    //   I:
-                    //
-                    // over the range (noninclusive on the right):
                     //
-                    //   (N,chan,s_1*i_1,s_2*i_2,...,s_n*i_n) ->
+                    // and the window over the *padded* input starts at
                     //
-                    //     (N+1,chan+1,s_1*i_1 + window_shape_1,...,s_n*i_n + window_shape_n)
+                    //   (N,chan,s_1*i_1,s_2*i_2,...,s_n*i_n)
                     //
-                    // with unit stride.
-                    //
-                    // We iterate this over the *padded* data, so below we will need to check for
-                    // coordinates that fall in the padding area.
-
-                    size_t n_spatial_dimensions = arg_shape.size() - 2;
-
-                    Coordinate input_batch_transform_start(2 + n_spatial_dimensions);
-                    Coordinate input_batch_transform_end(2 + n_spatial_dimensions);
-                    Strides input_batch_transform_source_strides(2 + n_spatial_dimensions, 1);
-                    AxisVector input_batch_transform_source_axis_order(2 + n_spatial_dimensions);
-                    CoordinateDiff input_batch_transform_padding_below(2 + n_spatial_dimensions);
-                    CoordinateDiff input_batch_transform_padding_above(2 + n_spatial_dimensions);
-
-                    input_batch_transform_start[0] = batch_index;
-                    input_batch_transform_end[0] = batch_index + 1;
-                    input_batch_transform_start[1] = channel;
-                    input_batch_transform_end[1] = channel + 1;
-                    input_batch_transform_padding_below[0] = 0;
-                    input_batch_transform_padding_below[1] = 0;
-                    input_batch_transform_padding_above[0] = 0;
-                    input_batch_transform_padding_above[1] = 0;
-
-                    for (size_t i = 2; i < n_spatial_dimensions + 2; i++)
-                    {
-                        size_t window_shape_this_dim = window_shape[i - 2];
-                        size_t movement_stride = window_movement_strides[i - 2];
-
-                        input_batch_transform_start[i] = movement_stride * out_coord[i];
-                        input_batch_transform_end[i] =
-                            input_batch_transform_start[i] + window_shape_this_dim;
-                        input_batch_transform_padding_below[i] = padding_below[i - 2];
-                        input_batch_transform_padding_above[i] = padding_above[i - 2];
-                    }
+                    // with extent window_shape. Only the part of the window that lies inside
+                    // the unpadded input can change the result, so clip the window to the
+                    // input and walk what is left.
+
+                    Shape window_extent(n_spatial_dimensions);
+                    std::ptrdiff_t window_offset =
+                        out_coord[0] * arg_strides[0] + out_coord[1] * arg_strides[1];
 
-                    for (size_t i = 0; i < arg_shape.size(); i++)
+                    for (size_t i = 0; i < n_spatial_dimensions; i++)
                     {
-                        input_batch_transform_source_axis_order[i] = i;
+                        std::ptrdiff_t begin =
+                            static_cast<std::ptrdiff_t>(window_movement_strides[i] *
+                                                        out_coord[i + 2]) -
+                            static_cast<std::ptrdiff_t>(padding_below[i]);
+                        std::ptrdiff_t end = begin + static_cast<std::ptrdiff_t>(window_shape[i]);
+                        begin = std::max<std::ptrdiff_t>(begin, 0);
+                        end = std::min<std::ptrdiff_t>(end, arg_shape[i + 2]);
+                        window_extent[i] = end > begin ? static_cast<size_t>(end - begin) : 0;
+                        window_offset += begin * window_strides[i];
                     }
 
-                    CoordinateTransform input_batch_transform(
-                        arg_shape,
-                        input_batch_transform_start,
-                        input_batch_transform_end,
-                        input_batch_transform_source_strides,
-                        input_batch_transform_source_axis_order,
-                        input_batch_transform_padding_below,
-                        input_batch_transform_padding_above);
-
                     // As we go, we compute the maximum value:
                     //
                     //   output[O] = max(output[O],arg[I])
 
                     T result = std::numeric_limits<T>::lowest();
 
-                    for (const Coordinate& input_batch_coord : input_batch_transform)
-                    {
-                        if (input_batch_transform.has_source_coordinate(input_batch_coord))
+                    StridedWalk window(window_extent, {window_strides}, {window_offset});
+                    const size_t run_length = window.get_run_length();
+                    const std::ptrdiff_t run_stride = window.get_run_stride(0);
+                    window.for_each_run([&](const std::ptrdiff_t* offsets) {
+                        const T* x = arg + offsets[0];
+                        for (size_t j = 0; j < run_length; j++)
                         {
-                            T x = arg[input_batch_transform.index(input_batch_coord)];
-                            result = x > result ? x : result;
+                            result = x[0] > result ? x[0] : result;
+                            x += run_stride;
                         }
-                    }
+                    });
 
                     out[output_transform.index(out_coord)] = result;
                 }
@@ -16,11 +16,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 
-#include "ngraph/axis_vector.hpp"
 #include "ngraph/check.hpp"
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/coordinate_diff.hpp"
+#include "ngraph/strided_walk.hpp"
 #include "ngraph/op/pad.hpp" // for op::PadMode
 
 namespace ngraph
@@ -29,6 +30,84 @@ namespace ngraph
     {
         namespace reference
         {
+            // The helpers below map a coordinate c of the padded output along one axis to the
+            // coordinate of the input element it copies.
+            inline ptrdiff_t edge_pad_source(size_t c, ptrdiff_t below, ptrdiff_t arg_length)
+            {
+                // Truncate out-of-bound coordinates.
+                ptrdiff_t source = static_cast<ptrdiff_t>(c) - below;
+                return std::min(std::max<ptrdiff_t>(source, 0), arg_length - 1);
+            }
+
+            inline ptrdiff_t reflect_pad_source(size_t c, ptrdiff_t below, ptrdiff_t arg_length)
+            {
+                // clang-format off
+                // The algorithm here is a bit complicated because if the padding is
+                // bigger than the tensor, we may reflect multiple times.
+                //
+                // Example:
+                //
+                // Input shape:     [2]
+                // Padding:         6 below, 6 above
+                // Output shape:    [14]
+                //
+                // Input:                       a b
+                // Expected output: a b a b a b a b a b a b a b
+                //
+                // Computation for coordinate 13 of output:
+                //
+                //         . . . . . . a b . . . . .[.] -> (oob above by 6 spaces, so reflection is at top-6)
+                //         .[.]. . . . a b . . . . . .  -> (oob below by 5 spaces, so reflection is at bottom+5)
+                //         . . . . . . a b . . .[.]. .  -> (oob above by 4 spaces, so reflection is at top-4)
+                //         . . .[.]. . a b . . . . . .  -> (oob below by 3 spaces, so reflection is at bottom+3)
+                //         . . . . . . a b .[.]. . . .  -> (oob above by 2 spaces, so reflection is at top-2)
+                //         . . . . .[.]a b . . . . . .  -> (oob below by 1 space,  so reflection is at bottom+1)
+                //         . . . . . . a[b]. . . . . .  -> (no longer oob, so copy from here)
+                //
+                // Note that this algorithm works because REFLECT padding only makes sense
+                // if each dim is >= 2.
+                // clang-format on
+                ptrdiff_t new_dim = static_cast<ptrdiff_t>(c);
+                bool done_reflecting = false;
+
+                while (!done_reflecting)
+                {
+                    if (new_dim < below)
+                    {
+                        ptrdiff_t distance_oob = below - new_dim;
+                        new_dim = below + distance_oob;
+                    }
+                    else if (new_dim >= below + arg_length)
+                    {
+                        ptrdiff_t distance_oob = new_dim - below - (arg_length - 1);
+                        new_dim = below + arg_length - distance_oob - 1;
+                    }
+                    else
+                    {
+                        done_reflecting = true;
+                    }
+                }
+                return new_dim - below;
+            }
+
+            inline ptrdiff_t symmetric_pad_source(size_t c,
+                                                  ptrdiff_t below,
+                                                  ptrdiff_t above,
+                                                  ptrdiff_t arg_length)
+            {
+                ptrdiff_t pos = below - (static_cast<ptrdiff_t>(c) + 1);
+                if (pos >= 0)
+                {
+                    return pos;
+                }
+                pos = -(pos + 1);
+                if (pos < arg_length)
+                {
+                    return pos;
+                }
+                return arg_length + above - pos;
+            }
+
             template <typename T>
             void pad(const T* arg0,
                      const T* arg1,
@@ -39,164 +118,132 @@ namespace ngraph
                      const CoordinateDiff& padding_above,
                      op::PadMode pad_mode)
             {
-                Coordinate input_start(arg0_shape.size(), 0); // start at (0,0,...,0)
-                Coordinate input_end = out_shape; // end at (d'0,d'1,...,d'n), the outer corner of
-                                                  // the post-padding shape
-
-                Strides input_strides(arg0_shape.size(), 1);
-
-                AxisVector input_axis_order(arg0_shape.size());
-                for (size_t i = 0; i < arg0_shape.size(); i++)
+                const size_t rank = arg0_shape.size();
+                NGRAPH_CHECK(out_shape.size() == rank && padding_below.size() == rank &&
+                             padding_above.size() == rank);
+                for (size_t i = 0; i < rank; i++)
                 {
-                    input_axis_order[i] = i;
+                    NGRAPH_CHECK(padding_below[i] + static_cast<ptrdiff_t>(arg0_shape[i]) +
+                                     padding_above[i] ==
+                                 static_cast<ptrdiff_t>(out_shape[i]));
                 }
 
-                CoordinateTransform input_transform(arg0_shape,
-                                                    input_start,
-                                                    input_end,
-                                                    input_strides,
-                                                    input_axis_order,
-                                                    padding_below,
-                                                    padding_above);
-                CoordinateTransform output_transform(out_shape);
-
-                CoordinateTransform::Iterator output_it = output_transform.begin();
+                std::vector<ptrdiff_t> arg0_strides = StridedWalk::dense_strides(arg0_shape);
+                std::vector<ptrdiff_t> out_strides = StridedWalk::dense_strides(out_shape);
 
-                NGRAPH_CHECK(shape_size(input_transform.get_target_shape()) ==
-                             shape_size(output_transform.get_target_shape()));
-
-                for (const Coordinate& in_coord : input_transform)
+                if (pad_mode == op::PadMode::CONSTANT)
                 {
-                    const Coordinate& out_coord = *output_it;
-
-                    T v(0);
-
-                    switch (pad_mode)
+                    // Fill everything with the pad value, then copy the part of the input that
+                    // survives (negative padding crops) into the interior.
+                    std::fill(out, out + shape_size(out_shape), *arg1);
+
+                    Shape interior_shape(rank);
+                    ptrdiff_t arg0_offset = 0;
+                    ptrdiff_t out_offset = 0;
+                    for (size_t i = 0; i < rank; i++)
                     {
-                    case op::PadMode::CONSTANT:
-                        // If the coordinate is out of bounds, substitute *arg1.
-                        v = input_transform.has_source_coordinate(in_coord)
-                                ? arg0[input_transform.index(in_coord)]
-                                : *arg1;
-                        break;
-                    case op::PadMode::EDGE:
-                    {
-                        Coordinate c = in_coord; // have to copy because in_coord is const
+                        ptrdiff_t out_begin = std::max<ptrdiff_t>(padding_below[i], 0);
+                        ptrdiff_t out_end =
+                            std::min<ptrdiff_t>(padding_below[i] + arg0_shape[i], out_shape[i]);
+                        interior_shape[i] =
+                            out_end > out_begin ? static_cast<size_t>(out_end - out_begin) : 0;
+                        arg0_offset += (out_begin - padding_below[i]) * arg0_strides[i];
+                        out_offset += out_begin * out_strides[i];
+                    }
 
-                        // Truncate each out-of-bound dimension.
-                        for (size_t i = 0; i < c.size(); i++)
+                    StridedWalk walk(
+                        interior_shape, {arg0_strides, out_strides}, {arg0_offset, out_offset});
+                    const size_t run_length = walk.get_run_length();
+                    const ptrdiff_t arg0_stride = walk.get_run_stride(0);
+                    const ptrdiff_t out_stride = walk.get_run_stride(1);
+                    walk.for_each_run([&](const ptrdiff_t* offsets) {
+                        for (size_t i = 0; i < run_length; i++)
                         {
-                            if (static_cast<ptrdiff_t>(c[i]) < padding_below[i])
-                            {
-                                c[i] = padding_below[i];
-                            }
-
-                            if (static_cast<ptrdiff_t>(c[i]) >=
-                                (padding_below[i] + static_cast<ptrdiff_t>(arg0_shape[i])))
-                            {
-                                c[i] = static_cast<size_t>(
-                                    padding_below[i] + static_cast<ptrdiff_t>(arg0_shape[i]) - 1);
-                            }
+                            ptrdiff_t step = static_cast<ptrdiff_t>(i);
+                            out[offsets[1] + step * out_stride] =
+                                arg0[offsets[0] + step * arg0_stride];
                         }
-                        v = arg0[input_transform.index(c)];
-                        break;
-                    }
-                    case op::PadMode::REFLECT:
+                    });
+                    return;
+                }
+
+                // For the remaining modes every output coordinate reads from an input
+                // coordinate that is computed independently per axis, so build one lookup
+                // table per axis holding the input offset for each output position along it.
+                std::vector<std::vector<ptrdiff_t>> source_offsets(rank);
+                for (size_t i = 0; i < rank; i++)
+                {
+                    NGRAPH_CHECK(arg0_shape[i] > 0 || out_shape[i] == 0);
+                    source_offsets[i].resize(out_shape[i]);
+                    for (size_t c = 0; c < out_shape[i]; c++)
                     {
-                        // clang-format off
-                        // The algorithm here is a bit complicated because if the padding is
-                        // bigger than the tensor, we may reflect multiple times.
-                        //
-                        // Example:
-                        //
-                        // Input shape:     [2]
-                        // Padding:         6 below, 6 above
-                        // Output shape:    [14]
-                        //
-                        // Input:                       a b
-                        // Expected output: a b a b a b a b a b a b a b
-                        //
-                        // Computation for coordinate 13 of output:
-                        //
-                        //         . . . . . . a b . . . . .[.] -> (oob above by 6 spaces, so reflection is at top-6)
-                        //         .[.]. . . . a b . . . . . .  -> (oob below by 5 spaces, so reflection is at bottom+5)
-                        //         . . . . . . a b . . .[.]. .  -> (oob above by 4 spaces, so reflection is at top-4)
-                        //         . . .[.]. . a b . . . . . .  -> (oob below by 3 spaces, so reflection is at bottom+3)
-                        //         . . . . . . a b .[.]. . . .  -> (oob above by 2 spaces, so reflection is at top-2)
-                        //         . . . . .[.]a b . . . . . .  -> (oob below by 1 space,  so reflection is at bottom+1)
-                        //         . . . . . . a[b]. . . . . .  -> (no longer oob, so copy from here)
-                        //
-                        // Note that this algorithm works because REFLECT padding only makes sense
-                        // if each dim is >= 2.
-                        // clang-format on
-                        Coordinate c = in_coord; // have to copy because in_coord is const
-
-                        for (size_t i = 0; i < c.size(); i++)
+                        ptrdiff_t source = 0;
+                        switch (pad_mode)
                         {
-                            ptrdiff_t new_dim = c[i];
-                            bool done_reflecting = false;
-
-                            while (!done_reflecting)
-                            {
-                                if (new_dim < padding_below[i])
-                                {
-                                    ptrdiff_t distance_oob = padding_below[i] - new_dim;
-                                    new_dim = padding_below[i] + distance_oob;
-                                }
-                                else if (new_dim >=
-                                         padding_below[i] + static_cast<ptrdiff_t>(arg0_shape[i]))
-                                {
-                                    ptrdiff_t distance_oob =
-                                        new_dim - padding_below[i] -
-                                        (static_cast<ptrdiff_t>(arg0_shape[i]) - 1);
-                                    new_dim = padding_below[i] +
-                                              static_cast<ptrdiff_t>(arg0_shape[i]) - distance_oob -
-                                              1;
-                                }
-                                else
-                                {
-                                    done_reflecting = true;
-                                }
-                            }
-
-                            c[i] = static_cast<size_t>(new_dim);
+                        case op::PadMode::CONSTANT: break;
+                        case op::PadMode::EDGE:
+                            source = edge_pad_source(
+                                c, padding_below[i], static_cast<ptrdiff_t>(arg0_shape[i]));
+                            break;
+                        case op::PadMode::REFLECT:
+                            source = reflect_pad_source(
+                                c, padding_below[i], static_cast<ptrdiff_t>(arg0_shape[i]));
+                            break;
+                        case op::PadMode::SYMMETRIC:
+                            source = symmetric_pad_source(c,
+                                                          padding_below[i],
+                                                          padding_above[i],
+                                                          static_cast<ptrdiff_t>(arg0_shape[i]));
+                            break;
                         }
-                        v = arg0[input_transform.index(c)];
-                        break;
+                        NGRAPH_CHECK(source >= 0 && source < static_cast<ptrdiff_t>(arg0_shape[i]));
+                        source_offsets[i][c] = source * arg0_strides[i];
+                    }
+                }
+
+                if (shape_size(out_shape) == 0)
+                {
+                    return;
+                }
+                if (rank == 0)
+                {
+                    out[0] = arg0[0];
+                    return;
+                }
+
+                // Odometer over the outer output axes; partial_offsets[i] is the input offset
+                // contributed by axes [0, i), so only the axes that tick need recomputing.
+                std::vector<size_t> counters(rank - 1, 0);
+                std::vector<ptrdiff_t> partial_offsets(rank, 0);
+                for (size_t i = 0; i + 1 < rank; i++)
+                {
+                    partial_offsets[i + 1] = partial_offsets[i] + source_offsets[i][0];
+                }
+                const std::vector<ptrdiff_t>& inner_offsets = source_offsets[rank - 1];
+                T* dst = out;
+                while (true)
+                {
+                    const T* src = arg0 + partial_offsets[rank - 1];
+                    for (ptrdiff_t offset : inner_offsets)
+                    {
+                        *dst++ = src[offset];
                     }
-                    case op::PadMode::SYMMETRIC:
+
+                    size_t axis = rank - 1;
+                    while (axis > 0 && ++counters[axis - 1] == out_shape[axis - 1])
                     {
-                        Coordinate c = in_coord; // have to copy because in_coord is const
-                        for (size_t i = 0; i < c.size(); i++)
-                        {
-                            ptrdiff_t pos = padding_below[i] - (c[i] + 1);
-                            if (pos >= 0)
-                            {
-                                c[i] = static_cast<size_t>(pos + padding_below[i]);
-                            }
-                            else
-                            {
-                                pos = -(pos + 1);
-                                ptrdiff_t src_dim = static_cast<ptrdiff_t>(arg0_shape[i]);
-                                if (pos < src_dim)
-                                {
-                                    c[i] = static_cast<size_t>(pos + padding_below[i]);
-                                }
-                                else
-                                {
-                                    c[i] = static_cast<size_t>(padding_below[i] + src_dim +
-                                                               padding_above[i] - pos);
-                                }
-                            }
-                        }
-                        v = arg0[input_transform.index(c)];
-                        break;
+                        counters[axis - 1] = 0;
+                        --axis;
                     }
+                    if (axis == 0)
+                    {
+                        return;
+                    }
+                    for (size_t i = axis - 1; i + 1 < rank; i++)
+                    {
+                        partial_offsets[i + 1] =
+                            partial_offsets[i] + source_offsets[i][counters[i]];
                     }
-
-                    out[output_transform.index(out_coord)] = v;
-
-                    ++output_it;
                 }
             }
         }
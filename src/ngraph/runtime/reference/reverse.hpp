@@ -18,7 +18,9 @@
 
 #include <cmath>
 
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/axis_set.hpp"
+#include "ngraph/check.hpp"
+#include "ngraph/strided_walk.hpp"
 
 namespace ngraph
 {
@@ -35,23 +37,32 @@ namespace ngraph
             {
                 // In fact arg_shape == out_shape, but we'll use both for stylistic consistency with
                 // other kernels.
-                CoordinateTransform arg_transform(arg_shape);
-                CoordinateTransform output_transform(out_shape);
-
-                for (Coordinate out_coord : output_transform)
+                std::vector<std::ptrdiff_t> arg_strides = StridedWalk::dense_strides(arg_shape);
+                std::ptrdiff_t arg_offset = 0;
+                for (size_t axis : reversed_axes)
                 {
-                    Coordinate arg_coord = out_coord;
-
-                    for (size_t i = 0; i < arg_coord.size(); i++)
+                    NGRAPH_CHECK(axis < arg_shape.size());
+                    if (arg_shape[axis] > 0)
                     {
-                        if (reversed_axes.count(i) != 0)
-                        {
-                            arg_coord[i] = arg_shape[i] - arg_coord[i] - 1;
-                        }
+                        arg_offset +=
+                            static_cast<std::ptrdiff_t>(arg_shape[axis] - 1) * arg_strides[axis];
                     }
-
-                    out[output_transform.index(out_coord)] = arg[arg_transform.index(arg_coord)];
+                    arg_strides[axis] = -arg_strides[axis];
                 }
+
+                StridedWalk walk(out_shape,
+                                 {arg_strides, StridedWalk::dense_strides(out_shape)},
+                                 {arg_offset, 0});
+                const size_t run_length = walk.get_run_length();
+                const std::ptrdiff_t arg_stride = walk.get_run_stride(0);
+                walk.for_each_run([&](const std::ptrdiff_t* offsets) {
+                    const T* src = arg + offsets[0];
+                    T* dst = out + offsets[1];
+                    for (size_t i = 0; i < run_length; i++)
+                    {
+                        dst[i] = src[static_cast<std::ptrdiff_t>(i) * arg_stride];
+                    }
+                });
             }
         }
     }
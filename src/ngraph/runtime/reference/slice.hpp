@@ -16,10 +16,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 
 #include "ngraph/check.hpp"
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/coordinate.hpp"
+#include "ngraph/strided_walk.hpp"
+#include "ngraph/strides.hpp"
 
 namespace ngraph
 {
@@ -36,22 +39,48 @@ namespace ngraph
                        const Strides& strides,
                        const Shape& out_shape)
             {
-                CoordinateTransform input_transform(arg_shape, lower_bounds, upper_bounds, strides);
-                CoordinateTransform output_transform(out_shape);
+                NGRAPH_CHECK(lower_bounds.size() == arg_shape.size() &&
+                             upper_bounds.size() == arg_shape.size() &&
+                             strides.size() == arg_shape.size());
 
-                CoordinateTransform::Iterator output_it = output_transform.begin();
-
-                NGRAPH_CHECK(shape_size(input_transform.get_target_shape()) ==
-                             shape_size(output_transform.get_target_shape()));
-
-                for (const Coordinate& in_coord : input_transform)
+                // The output is written densely in row-major order, so only the slice itself
+                // needs to be described; out_shape may have a different rank (e.g. when the
+                // caller folds a reshape into the slice).
+                Shape slice_shape(arg_shape.size());
+                std::vector<std::ptrdiff_t> arg_strides = StridedWalk::dense_strides(arg_shape);
+                std::ptrdiff_t arg_offset = 0;
+                for (size_t i = 0; i < arg_shape.size(); i++)
                 {
-                    const Coordinate& out_coord = *output_it;
+                    NGRAPH_CHECK(lower_bounds[i] <= upper_bounds[i] &&
+                                 upper_bounds[i] <= arg_shape[i] && strides[i] > 0);
+                    slice_shape[i] = (upper_bounds[i] - lower_bounds[i] + strides[i] - 1) /
+                                     strides[i];
+                    arg_offset += static_cast<std::ptrdiff_t>(lower_bounds[i]) * arg_strides[i];
+                    arg_strides[i] *= static_cast<std::ptrdiff_t>(strides[i]);
+                }
 
-                    out[output_transform.index(out_coord)] = arg[input_transform.index(in_coord)];
+                NGRAPH_CHECK(shape_size(slice_shape) == shape_size(out_shape));
 
-                    ++output_it;
-                }
+                StridedWalk walk(slice_shape,
+                                 {arg_strides, StridedWalk::dense_strides(slice_shape)},
+                                 {arg_offset, 0});
+                const size_t run_length = walk.get_run_length();
+                const std::ptrdiff_t arg_stride = walk.get_run_stride(0);
+                walk.for_each_run([&](const std::ptrdiff_t* offsets) {
+                    const T* src = arg + offsets[0];
+                    T* dst = out + offsets[1];
+                    if (arg_stride == 1)
+                    {
+                        std::copy(src, src + run_length, dst);
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < run_length; i++)
+                        {
+                            dst[i] = src[i * arg_stride];
+                        }
+                    }
+                });
             }
         }
     }
@@ -16,10 +16,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/axis_set.hpp"
+#include "ngraph/check.hpp"
 #include "ngraph/shape_util.hpp"
+#include "ngraph/strided_walk.hpp"
 #include "ngraph/type/bfloat16.hpp"
 #include "ngraph/type/float16.hpp"
 
@@ -59,36 +62,52 @@ namespace ngraph
                      const Shape& out_shape,
                      const AxisSet& reduction_axes)
             {
-                CoordinateTransform output_transform(out_shape);
-                std::vector<T> cs(shape_size(out_shape));
+                std::fill(out, out + shape_size(out_shape), T(0));
+                std::vector<T> cs(shape_size(out_shape), T(0));
 
-                for (const Coordinate& output_coord : output_transform)
+                // Walk the input in row-major order; reduced axes leave the output offset
+                // unchanged, so every output element accumulates its inputs in the same order
+                // as a coordinate-by-coordinate traversal.
+                std::vector<std::ptrdiff_t> out_dense_strides =
+                    StridedWalk::dense_strides(out_shape);
+                std::vector<std::ptrdiff_t> out_strides(in_shape.size(), 0);
+                size_t out_axis = 0;
+                for (size_t axis = 0; axis < in_shape.size(); ++axis)
                 {
-                    out[output_transform.index(output_coord)] = 0;
-                    cs[output_transform.index(output_coord)] = 0;
-                }
-
-                CoordinateTransform input_transform(in_shape);
-
-                for (const Coordinate& input_coord : input_transform)
-                {
-                    Coordinate output_coord = reduce(input_coord, reduction_axes);
-
-                    T x = arg[input_transform.index(input_coord)];
-                    T& z = out[output_transform.index(output_coord)];
-
-                    if (is_finite(x) && is_finite(z))
+                    if (reduction_axes.count(axis) == 0)
                     {
-                        T& c = cs[output_transform.index(output_coord)];
-                        T t = z + (x - c);
-                        c = (t - z) - (x - c);
-                        z = t;
+                        NGRAPH_CHECK(out_axis < out_shape.size() &&
+                                     out_shape[out_axis] == in_shape[axis]);
+                        out_strides[axis] = out_dense_strides[out_axis++];
                     }
-                    else
+                }
+                NGRAPH_CHECK(out_axis == out_shape.size());
+
+                StridedWalk walk(in_shape, {StridedWalk::dense_strides(in_shape), out_strides});
+                const size_t run_length = walk.get_run_length();
+                const std::ptrdiff_t out_stride = walk.get_run_stride(1);
+                walk.for_each_run([&](const std::ptrdiff_t* offsets) {
+                    const T* src = arg + offsets[0];
+                    for (size_t i = 0; i < run_length; i++)
                     {
-                        z = z + x;
+                        std::ptrdiff_t out_index =
+                            offsets[1] + static_cast<std::ptrdiff_t>(i) * out_stride;
+                        T x = src[i];
+                        T& z = out[out_index];
+
+                        if (is_finite(x) && is_finite(z))
+                        {
+                            T& c = cs[out_index];
+                            T t = z + (x - c);
+                            c = (t - z) - (x - c);
+                            z = t;
+                        }
+                        else
+                        {
+                            z = z + x;
+                        }
                     }
-                }
+                });
             }
         }
     }
@@ -14,9 +14,11 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
 #include <fstream>
 #include <functional>
 #include <queue>
+#include <sstream>
 #include <stack>
 
 #include "ngraph/cpio.hpp"
@@ -34,6 +36,7 @@ using namespace ngraph;
 using namespace std;
 using json = nlohmann::json;
 using const_data_callback_t = shared_ptr<Node>(const string&, const element::Type&, const Shape&);
+using const_blob_callback_t = shared_ptr<Node>(size_t, const element::Type&, const Shape&);
 
 static bool s_serialize_output_shapes_enabled = getenv_bool("NGRAPH_SERIALIZER_OUTPUT_SHAPES");
 
@@ -111,6 +114,9 @@ public:
         m_binary_constant_data = binary_constant_data;
     }
 
+    // If set, constants are written as an index into blobs instead of as value strings.
+    void set_constant_blobs(vector<const op::Constant*>* blobs) { m_constant_blobs = blobs; }
+
     json serialize_function(const Function& function);
     json serialize_output(const Output<Node>& output);
     json serialize_parameter_vector(const ParameterVector& parameters);
@@ -126,6 +132,7 @@ protected:
     size_t m_indent{0};
     bool m_serialize_output_shapes{false};
     bool m_binary_constant_data{false};
+    vector<const op::Constant*>* m_constant_blobs{nullptr};
     json m_json_nodes;
 };
 
@@ -137,6 +144,12 @@ public:
         m_const_data_callback = const_data_callback;
     }
 
+    // Creates the constants that were serialized as blob indices.
+    void set_const_blob_callback(function<const_blob_callback_t> const_blob_callback)
+    {
+        m_const_blob_callback = const_blob_callback;
+    }
+
     shared_ptr<Function> deserialize_function(json j);
     Output<Node> deserialize_output(json j);
     OutputVector deserialize_output_vector(json j);
@@ -153,6 +166,7 @@ protected:
     unordered_map<string, shared_ptr<Node>> m_node_map;
     unordered_map<string, shared_ptr<Function>> m_function_map;
     function<const_data_callback_t> m_const_data_callback;
+    function<const_blob_callback_t> m_const_blob_callback;
 };
 
 static string
@@ -360,10 +374,173 @@ std::string ngraph::serialize(std::shared_ptr<ngraph::Function> func, size_t ind
     return ::serialize(func, indent, false);
 }
 
+// Binary format written by serialize_binary; all integers are 64-bit little endian.
+//
+//     magic                      "NGRAPHB\0"
+//     version                    1
+//     graph offset, size         the JSON node table; constants refer to blobs by index
+//     blob table offset, count
+//     graph
+//     blob table                 offset and size of every blob
+//     blobs                      constant data, each at an offset that is a multiple of 64
+static const char s_binary_magic[8] = {'N', 'G', 'R', 'A', 'P', 'H', 'B', '\0'};
+static const uint64_t s_binary_version = 1;
+static const uint64_t s_binary_alignment = 64;
+static const size_t s_binary_header_size = sizeof(s_binary_magic) + 5 * sizeof(uint64_t);
+
+static void write_u64(ostream& out, uint64_t value)
+{
+    char bytes[8];
+    for (size_t i = 0; i < 8; i++)
+    {
+        bytes[i] = static_cast<char>(value >> (8 * i));
+    }
+    out.write(bytes, 8);
+}
+
+static uint64_t read_u64(const char* bytes)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; i++)
+    {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(bytes[i])) << (8 * i);
+    }
+    return value;
+}
+
+static bool is_binary_model(const char* data, size_t size)
+{
+    return size >= s_binary_header_size &&
+           equal(s_binary_magic, s_binary_magic + sizeof(s_binary_magic), data);
+}
+
+static bool is_binary_model(istream& in)
+{
+    auto offset = in.tellg();
+    char magic[sizeof(s_binary_magic)];
+    in.read(magic, sizeof(magic));
+    bool rc = in.gcount() == sizeof(magic) &&
+              equal(s_binary_magic, s_binary_magic + sizeof(s_binary_magic), magic);
+    in.clear();
+    in.seekg(offset);
+    return rc;
+}
+
+void ngraph::serialize_binary(ostream& out, shared_ptr<ngraph::Function> func)
+{
+    JSONSerializer serializer;
+    vector<const op::Constant*> blobs;
+    serializer.set_constant_blobs(&blobs);
+    serializer.set_serialize_output_shapes(s_serialize_output_shapes_enabled);
+    json j;
+    j.push_back(serializer.serialize_function(*func));
+    string graph = j.dump();
+
+    uint64_t graph_offset = s_binary_header_size;
+    uint64_t table_offset = graph_offset + graph.size();
+    uint64_t offset = table_offset + 2 * sizeof(uint64_t) * blobs.size();
+    vector<pair<uint64_t, uint64_t>> table;
+    for (const op::Constant* constant : blobs)
+    {
+        offset = (offset + s_binary_alignment - 1) / s_binary_alignment * s_binary_alignment;
+        uint64_t size = shape_size(constant->get_shape()) * constant->get_element_type().size();
+        table.push_back({offset, size});
+        offset += size;
+    }
+
+    out.write(s_binary_magic, sizeof(s_binary_magic));
+    write_u64(out, s_binary_version);
+    write_u64(out, graph_offset);
+    write_u64(out, graph.size());
+    write_u64(out, table_offset);
+    write_u64(out, blobs.size());
+    out.write(graph.data(), graph.size());
+    for (auto& entry : table)
+    {
+        write_u64(out, entry.first);
+        write_u64(out, entry.second);
+    }
+    static const char padding[s_binary_alignment] = {};
+    uint64_t position = table_offset + 2 * sizeof(uint64_t) * blobs.size();
+    for (size_t i = 0; i < blobs.size(); i++)
+    {
+        out.write(padding, table[i].first - position);
+        out.write(static_cast<const char*>(blobs[i]->get_data_ptr()), table[i].second);
+        position = table[i].first + table[i].second;
+    }
+}
+
+void ngraph::serialize_binary(const string& path, shared_ptr<ngraph::Function> func)
+{
+    ofstream out(path, ios_base::binary | ios_base::out);
+    serialize_binary(out, func);
+}
+
+// Constants are created over slices of file, which they keep alive.
+static shared_ptr<Function> deserialize_binary(shared_ptr<runtime::AlignedBuffer> file)
+{
+    const char* data = file->get_ptr<char>();
+    uint64_t size = file->size();
+    NGRAPH_CHECK(is_binary_model(data, size), "Not a binary nGraph model");
+    auto header_field = [&](size_t index) {
+        return read_u64(data + sizeof(s_binary_magic) + index * sizeof(uint64_t));
+    };
+    NGRAPH_CHECK(header_field(0) == s_binary_version,
+                 "Unsupported binary model version ",
+                 header_field(0));
+    uint64_t graph_offset = header_field(1);
+    uint64_t graph_size = header_field(2);
+    uint64_t table_offset = header_field(3);
+    uint64_t blob_count = header_field(4);
+    NGRAPH_CHECK(graph_offset <= size && graph_size <= size - graph_offset &&
+                     table_offset <= size &&
+                     blob_count <= (size - table_offset) / (2 * sizeof(uint64_t)),
+                 "Truncated binary model");
+
+    json js = json::parse(data + graph_offset, data + graph_offset + graph_size);
+    JSONDeserializer deserializer;
+    deserializer.set_const_blob_callback(
+        [&](size_t blob, const element::Type& et, const Shape& shape) -> shared_ptr<Node> {
+            NGRAPH_CHECK(blob < blob_count, "Binary model has no constant blob ", blob);
+            const char* entry = data + table_offset + 2 * sizeof(uint64_t) * blob;
+            uint64_t offset = read_u64(entry);
+            uint64_t blob_size = read_u64(entry + sizeof(uint64_t));
+            NGRAPH_CHECK(offset <= size && blob_size <= size - offset &&
+                             blob_size == shape_size(shape) * et.size(),
+                         "Constant blob ",
+                         blob,
+                         " of the binary model is corrupt");
+            auto buffer = make_shared<runtime::AlignedBuffer>(
+                const_cast<char*>(data) + offset, blob_size, file);
+            return make_shared<op::Constant>(et, shape, buffer);
+        });
+    shared_ptr<Function> rc;
+    for (json func : js)
+    {
+        rc = deserializer.deserialize_function(func);
+    }
+    return rc;
+}
+
+shared_ptr<ngraph::Function> ngraph::deserialize_binary(const string& path)
+{
+    return ::deserialize_binary(file_util::map_file(path));
+}
+
 shared_ptr<ngraph::Function> ngraph::deserialize(istream& in)
 {
     shared_ptr<Function> rc;
-    if (cpio::is_cpio(in))
+    if (is_binary_model(in))
+    {
+        // A stream cannot be mapped; read it once and let the constants share the copy.
+        std::stringstream ss;
+        ss << in.rdbuf();
+        string contents = ss.str();
+        auto buffer = make_shared<runtime::AlignedBuffer>(contents.size());
+        copy(contents.begin(), contents.end(), buffer->get_ptr<char>());
+        rc = ::deserialize_binary(buffer);
+    }
+    else if (cpio::is_cpio(in))
     {
         cpio::Reader reader(in);
         vector<cpio::FileInfo> file_info = reader.get_file_info();
@@ -416,7 +593,15 @@ shared_ptr<ngraph::Function> ngraph::deserialize(const string& s)
     {
         // s is a file and not a json string
         ifstream in(s, ios_base::binary | ios_base::in);
-        rc = deserialize(in);
+        if (is_binary_model(in))
+        {
+            in.close();
+            rc = deserialize_binary(s);
+        }
+        else
+        {
+            rc = deserialize(in);
+        }
     }
     else
     {
@@ -825,6 +1010,17 @@ shared_ptr<Node> JSONDeserializer::deserialize_node(json node_js)
             node = make_shared<op::AllReduce>(args[0]);
             break;
         }
+        case OP_TYPEID::AllReduceStart:
+        {
+            auto reduce_type = as_enum<reduction::Type>(node_js.at("reduce_type").get<string>());
+            node = make_shared<op::AllReduceStart>(args[0], reduce_type);
+            break;
+        }
+        case OP_TYPEID::AllReduceWait:
+        {
+            node = make_shared<op::AllReduceWait>(args[0]);
+            break;
+        }
         case OP_TYPEID::And:
         {
             node = make_shared<op::And>(
@@ -1045,6 +1241,14 @@ shared_ptr<Node> JSONDeserializer::deserialize_node(json node_js)
                 has_key(node_js, "element_type") ? node_js : node_js.at("value_type");
             auto element_type = read_element_type(type_node_js.at("element_type"));
             auto shape = type_node_js.at("shape");
+            if (has_key(node_js, "blob"))
+            {
+                NGRAPH_CHECK(m_const_blob_callback, "Constant data is not available");
+                node = m_const_blob_callback(node_js.at("blob").get<size_t>(),
+                                             element_type,
+                                             Shape(shape.get<vector<size_t>>()));
+                break;
+            }
             auto value = node_js.at("value").get<vector<string>>();
             node = make_shared<op::Constant>(element_type, shape, value);
             break;
@@ -1364,7 +1568,33 @@ shared_ptr<Node> JSONDeserializer::deserialize_node(json node_js)
                 args[0], args[1], args[2], args[3], resize_method, extrapolation_value);
             break;
         }
-        case OP_TYPEID::CompiledKernel: { break;
+        case OP_TYPEID::CompiledKernel:
+        {
+            // The kernel's nodes are connected to dummy parameters instead of the kernel's
+            // arguments, they all have to be deserialized before the kernel refers to them
+            NodeVector kernel_nodes;
+            for (json jnode : node_js["kernel_nodes"])
+            {
+                auto kernel_node = deserialize_node(jnode);
+                if (!is_type<op::Parameter>(kernel_node))
+                {
+                    kernel_nodes.push_back(kernel_node);
+                }
+            }
+            NodeVector kernel_outputs;
+            for (json jout : node_js["kernel_outputs"])
+            {
+                kernel_outputs.push_back(m_node_map.at(jout.get<string>()));
+            }
+            auto kernel = make_shared<op::CompiledKernel>(
+                kernel_nodes, kernel_outputs, as_node_vector(args));
+            for (json jin : node_js["input_map"])
+            {
+                kernel->insert_to_input_map(m_node_map.at(jin.at("node").get<string>()),
+                                            jin.at("index").get<size_t>());
+            }
+            node = kernel;
+            break;
         }
         case OP_TYPEID::CTCGreedyDecoder: { break;
         }
@@ -3189,6 +3419,14 @@ json JSONSerializer::serialize_node(const Node& n)
     }
     case OP_TYPEID::AllReduce: { break;
     }
+    case OP_TYPEID::AllReduceStart:
+    {
+        auto tmp = static_cast<const op::AllReduceStart*>(&n);
+        node["reduce_type"] = as_string(tmp->get_reduce_type());
+        break;
+    }
+    case OP_TYPEID::AllReduceWait: { break;
+    }
     case OP_TYPEID::And:
     {
         auto tmp = static_cast<const op::And*>(&n);
@@ -3347,7 +3585,13 @@ json JSONSerializer::serialize_node(const Node& n)
     case OP_TYPEID::Constant:
     {
         auto tmp = static_cast<const op::Constant*>(&n);
-        if (tmp->get_all_data_elements_bitwise_identical() && shape_size(tmp->get_shape()) > 0)
+        if (m_constant_blobs)
+        {
+            node["blob"] = m_constant_blobs->size();
+            m_constant_blobs->push_back(tmp);
+        }
+        else if (tmp->get_all_data_elements_bitwise_identical() &&
+                 shape_size(tmp->get_shape()) > 0)
         {
             vector<string> vs;
             vs.push_back(tmp->convert_value_to_string(0));
@@ -3520,7 +3764,33 @@ json JSONSerializer::serialize_node(const Node& n)
     }
     case OP_TYPEID::CTCGreedyDecoder: { break;
     }
-    case OP_TYPEID::CompiledKernel: { break;
+    case OP_TYPEID::CompiledKernel:
+    {
+        auto tmp = static_cast<const op::CompiledKernel*>(&n);
+        // Serializer assumes node inputs are already serialized, the topological order puts
+        // the dummy parameters of the kernel's nodes first
+        json kernel_nodes = json::array();
+        for (auto kernel_node : topological_sort(tmp->get_node_list()))
+        {
+            kernel_nodes.push_back(serialize_node(*kernel_node));
+        }
+        node["kernel_nodes"] = kernel_nodes;
+        json kernel_outputs = json::array();
+        for (auto kernel_output : tmp->get_kernel_outputs())
+        {
+            kernel_outputs.push_back(kernel_output->get_name());
+        }
+        node["kernel_outputs"] = kernel_outputs;
+        json input_map = json::array();
+        for (auto& entry : tmp->get_input_map())
+        {
+            json jin;
+            jin["node"] = entry.first->get_name();
+            jin["index"] = entry.second;
+            input_map.push_back(jin);
+        }
+        node["input_map"] = input_map;
+        break;
     }
     case OP_TYPEID::DetectionOutput: { break;
     }
@@ -48,12 +48,31 @@ namespace ngraph
     ///    indent level specified.
     void serialize(std::ostream& out, std::shared_ptr<ngraph::Function> func, size_t indent = 0);
 
+    /// \brief Serialize a Function to a binary file
+    ///
+    /// The file holds the node table followed by the raw data of every constant, each at a
+    /// 64-byte aligned offset, so that deserialize_binary can use the data where it lies.
+    /// \param path The path to the output file
+    /// \param func The Function to serialize
+    void serialize_binary(const std::string& path, std::shared_ptr<ngraph::Function> func);
+
+    /// \brief Serialize a Function to a binary stream; see serialize_binary(path, func).
+    void serialize_binary(std::ostream& out, std::shared_ptr<ngraph::Function> func);
+
+    /// \brief Deserialize a Function written by serialize_binary
+    ///
+    /// The file is memory mapped and every Constant refers to its data inside the mapping
+    /// instead of holding a copy. The mapping is released with the last of those constants.
+    /// \param path The path to the binary file
+    std::shared_ptr<ngraph::Function> deserialize_binary(const std::string& path);
+
     /// \brief Deserialize a Function
-    /// \param in An isteam to the input data
+    /// \param in An isteam to the input data, in json, cpio or binary format
     std::shared_ptr<ngraph::Function> deserialize(std::istream& in);
 
     /// \brief Deserialize a Function
-    /// \param str The json formatted string to deseriailze.
+    /// \param str The json formatted string to deseriailze, or the path of a file in any
+    ///        format; binary files are mapped as by deserialize_binary.
     std::shared_ptr<ngraph::Function> deserialize(const std::string& str);
 
     /// \brief If enabled adds output shapes to the serialized graph
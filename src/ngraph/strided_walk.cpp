@@ -0,0 +1,121 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+
+#include "ngraph/check.hpp"
+#include "ngraph/strided_walk.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+StridedWalk::StridedWalk(const Shape& shape,
+                         const vector<vector<ptrdiff_t>>& strides,
+                         const vector<ptrdiff_t>& offsets)
+    : m_operand_count(strides.size())
+    , m_offsets(offsets.empty() ? vector<ptrdiff_t>(strides.size(), 0) : offsets)
+{
+    NGRAPH_CHECK(m_operand_count > 0, "StridedWalk needs at least one operand");
+    NGRAPH_CHECK(m_offsets.size() == m_operand_count,
+                 "StridedWalk got ",
+                 m_offsets.size(),
+                 " offsets for ",
+                 m_operand_count,
+                 " operands");
+    for (const vector<ptrdiff_t>& operand_strides : strides)
+    {
+        NGRAPH_CHECK(operand_strides.size() == shape.size(),
+                     "StridedWalk operand strides do not match the rank of ",
+                     shape);
+    }
+
+    if (shape_size(shape) == 0)
+    {
+        return;
+    }
+
+    // Unit axes contribute nothing to the walk. Going from the innermost axis outwards, an
+    // axis is folded into the one inside it when every operand steps over the inner axis
+    // exactly once per step of the outer axis.
+    vector<size_t> axes;
+    for (size_t i = 0; i < shape.size(); i++)
+    {
+        if (shape[i] != 1)
+        {
+            axes.push_back(i);
+        }
+    }
+
+    const size_t n = m_operand_count;
+    vector<size_t> extents;
+    vector<ptrdiff_t> axis_strides;
+    for (auto it = axes.rbegin(); it != axes.rend(); ++it)
+    {
+        size_t axis = *it;
+        bool mergeable = !extents.empty();
+        for (size_t k = 0; mergeable && k < n; k++)
+        {
+            ptrdiff_t inner_stride = axis_strides[(extents.size() - 1) * n + k];
+            mergeable =
+                strides[k][axis] == inner_stride * static_cast<ptrdiff_t>(extents.back());
+        }
+        if (mergeable)
+        {
+            extents.back() *= shape[axis];
+        }
+        else
+        {
+            extents.push_back(shape[axis]);
+            for (size_t k = 0; k < n; k++)
+            {
+                axis_strides.push_back(strides[k][axis]);
+            }
+        }
+    }
+    if (extents.empty())
+    {
+        extents.push_back(1);
+        axis_strides.assign(n, 0);
+    }
+
+    // The loops above built everything innermost-first.
+    m_shape.assign(extents.rbegin(), extents.rend());
+    m_strides.resize(axis_strides.size());
+    for (size_t j = 0; j < extents.size(); j++)
+    {
+        size_t axis = extents.size() - 1 - j;
+        copy(axis_strides.begin() + j * n,
+             axis_strides.begin() + (j + 1) * n,
+             m_strides.begin() + axis * n);
+    }
+}
+
+vector<ptrdiff_t> StridedWalk::dense_strides(const Shape& shape)
+{
+    vector<ptrdiff_t> strides(shape.size());
+    ptrdiff_t stride = 1;
+    for (size_t i = shape.size(); i-- > 0;)
+    {
+        strides[i] = stride;
+        stride *= static_cast<ptrdiff_t>(shape[i]);
+    }
+    return strides;
+}
+
+size_t StridedWalk::get_run_count() const
+{
+    return m_shape.empty() ? 0 : shape_size(m_shape) / m_shape.back();
+}
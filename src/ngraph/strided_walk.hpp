@@ -0,0 +1,126 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "ngraph/ngraph_visibility.hpp"
+#include "ngraph/shape.hpp"
+
+namespace ngraph
+{
+    /// \brief Walks a row-major index space while keeping the flat element offsets of one or
+    ///        more operands up to date incrementally.
+    ///
+    /// Every operand is described by a starting offset and a signed element stride for each
+    /// axis of the index space; a stride of 0 repeats elements (broadcast, reduction) and a
+    /// negative stride walks an axis backwards (reverse). Axes of length 1 are dropped and
+    /// neighbouring axes that advance every operand uniformly are merged, so the innermost
+    /// axis -- the "run" -- is as long as possible. The order in which elements are visited is
+    /// always plain row-major order of the index space, so kernels ported from
+    /// CoordinateTransform produce bit-identical results.
+    ///
+    /// Example (a transposing copy):
+    ///
+    ///     StridedWalk walk({rows, cols}, {{1, rows}, {cols, 1}});
+    ///     walk.for_each_run([&](const std::ptrdiff_t* offsets) {
+    ///         for (size_t i = 0; i < walk.get_run_length(); i++)
+    ///             out[offsets[1] + i] = in[offsets[0] + i * walk.get_run_stride(0)];
+    ///     });
+    class NGRAPH_API StridedWalk
+    {
+    public:
+        /// \param shape The index space to walk.
+        /// \param strides strides[k][i] is the stride of operand k along axis i of shape.
+        /// \param offsets The flat offset of each operand at the origin of the index space;
+        ///        all zero if empty.
+        StridedWalk(const Shape& shape,
+                    const std::vector<std::vector<std::ptrdiff_t>>& strides,
+                    const std::vector<std::ptrdiff_t>& offsets = {});
+
+        /// \brief Signed row-major element strides of a dense tensor with the given shape.
+        static std::vector<std::ptrdiff_t> dense_strides(const Shape& shape);
+
+        size_t get_operand_count() const { return m_operand_count; }
+        /// \brief The shape after dropping unit axes and merging compatible ones; empty if
+        ///        the index space has no elements.
+        const Shape& get_collapsed_shape() const { return m_shape; }
+        /// \brief Number of elements visited by each call of the for_each_run callback.
+        size_t get_run_length() const { return m_shape.empty() ? 0 : m_shape.back(); }
+        /// \brief Number of times for_each_run invokes its callback.
+        size_t get_run_count() const;
+        /// \brief Distance between consecutive elements of operand k inside a run; 0 if the
+        ///        index space has no elements.
+        std::ptrdiff_t get_run_stride(size_t k) const
+        {
+            return m_shape.empty() ? 0 : m_strides[(m_shape.size() - 1) * m_operand_count + k];
+        }
+        /// \brief True if operand k is visited at consecutive addresses inside a run.
+        bool is_contiguous_run(size_t k) const { return get_run_stride(k) == 1; }
+        /// \brief Calls f(const std::ptrdiff_t* offsets) at the start of every run, in
+        ///        row-major order; offsets[k] is the flat offset of operand k.
+        template <typename F>
+        void for_each_run(F&& f) const
+        {
+            if (m_shape.empty())
+            {
+                return;
+            }
+            const size_t n = m_operand_count;
+            const size_t outer_axes = m_shape.size() - 1;
+            std::vector<std::ptrdiff_t> offsets(m_offsets);
+            std::vector<size_t> counters(outer_axes, 0);
+            while (true)
+            {
+                f(static_cast<const std::ptrdiff_t*>(offsets.data()));
+
+                size_t axis = outer_axes;
+                while (true)
+                {
+                    if (axis == 0)
+                    {
+                        return;
+                    }
+                    --axis;
+                    const std::ptrdiff_t* axis_strides = &m_strides[axis * n];
+                    if (++counters[axis] < m_shape[axis])
+                    {
+                        for (size_t k = 0; k < n; k++)
+                        {
+                            offsets[k] += axis_strides[k];
+                        }
+                        break;
+                    }
+                    counters[axis] = 0;
+                    for (size_t k = 0; k < n; k++)
+                    {
+                        offsets[k] -=
+                            axis_strides[k] * static_cast<std::ptrdiff_t>(m_shape[axis] - 1);
+                    }
+                }
+            }
+        }
+
+    private:
+        size_t m_operand_count;
+        Shape m_shape;
+        // m_strides[axis * m_operand_count + k] is the stride of operand k along axis.
+        std::vector<std::ptrdiff_t> m_strides;
+        std::vector<std::ptrdiff_t> m_offsets;
+    };
+}
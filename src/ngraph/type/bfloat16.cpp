@@ -34,6 +34,9 @@
 #include <cmath>
 #include <iostream>
 #include <limits>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 #include "ngraph/type/bfloat16.hpp"
 
@@ -117,3 +120,66 @@ uint16_t bfloat16::to_bits() const
 {
     return m_value;
 }
+
+void bfloat16::to_float(const bfloat16* source, float* target, size_t count)
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        __m256i bits = _mm256_slli_epi32(_mm256_cvtepu16_epi32(half), 16);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), bits);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        target[i] = static_cast<float>(source[i]);
+    }
+}
+
+void bfloat16::from_float(const float* source, bfloat16* target, size_t count)
+{
+    size_t i = 0;
+#if defined(__AVX512BF16__)
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256bh half = _mm512_cvtneps_pbh(_mm512_loadu_ps(source + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), (__m256i)half);
+    }
+#elif defined(__AVX2__)
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i rounding = _mm256_set1_epi32(0x7FFF);
+    const __m256i magnitude = _mm256_set1_epi32(0x7FFFFFFF);
+    const __m256i infinity = _mm256_set1_epi32(0x7F800000);
+    const __m256i quiet = _mm256_set1_epi32(0x40);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+        __m256i odd = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+        __m256i rounded =
+            _mm256_srli_epi32(_mm256_add_epi32(bits, _mm256_add_epi32(rounding, odd)), 16);
+        __m256i nan = _mm256_cmpgt_epi32(_mm256_and_si256(bits, magnitude), infinity);
+        __m256i quieted = _mm256_or_si256(_mm256_srli_epi32(bits, 16), quiet);
+        __m256i half = _mm256_blendv_epi8(rounded, quieted, nan);
+        // Packing works within 128 bit lanes, so the lower half of each lane is gathered after
+        half = _mm256_permute4x64_epi64(_mm256_packus_epi32(half, half), 0xD8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i), _mm256_castsi256_si128(half));
+    }
+#endif
+    // Unlike bfloat16(float), which truncates when the kept fraction is even, this rounds to
+    // nearest even like the AVX-512 BF16 instructions, which also flush subnormals to zero
+    for (; i < count; ++i)
+    {
+        uint32_t bits = F32(source[i]).i;
+        if ((bits & 0x7FFFFFFF) > 0x7F800000)
+        {
+            target[i] = from_bits(static_cast<uint16_t>((bits >> 16) | 0x40));
+        }
+        else
+        {
+            uint32_t odd = (bits >> 16) & 1;
+            target[i] = from_bits(static_cast<uint16_t>((bits + 0x7FFF + odd) >> 16));
+        }
+    }
+}
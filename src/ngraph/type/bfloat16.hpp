@@ -65,6 +65,11 @@ namespace ngraph
 
         static std::vector<float> to_float_vector(const std::vector<bfloat16>&);
         static std::vector<bfloat16> from_float_vector(const std::vector<float>&);
+        /// \brief Convert `count` values to float, with AVX2 when the build targets it
+        static void to_float(const bfloat16* source, float* target, size_t count);
+        /// \brief Convert `count` floats, rounding to nearest even, with AVX-512 BF16 or AVX2
+        /// when the build targets them
+        static void from_float(const float* source, bfloat16* target, size_t count);
         static constexpr bfloat16 from_bits(uint16_t bits) { return bfloat16(bits, true); }
         uint16_t to_bits() const;
         friend std::ostream& operator<<(std::ostream& out, const bfloat16& obj)
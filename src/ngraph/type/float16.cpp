@@ -34,6 +34,9 @@
 #include <cmath>
 #include <iostream>
 #include <limits>
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
 
 #include "ngraph/type/float16.hpp"
 
@@ -170,3 +173,62 @@ uint16_t float16::to_bits() const
 {
     return m_value;
 }
+
+void float16::to_float(const float16* source, float* target, size_t count)
+{
+    size_t i = 0;
+#if defined(__F16C__)
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        _mm256_storeu_ps(target + i, _mm256_cvtph_ps(half));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        target[i] = static_cast<float>(source[i]);
+    }
+}
+
+void float16::from_float(const float* source, float16* target, size_t count)
+{
+    size_t i = 0;
+#if defined(__F16C__)
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i), half);
+    }
+#endif
+    // Unlike float16(float), which rounds halfway cases up, this matches F16C bit for bit
+    const uint32_t f16_overflow = (127 + 16) << 23;
+    const uint32_t f32_infinity = 0xFF << 23;
+    const uint32_t min_normal = (127 - 14) << 23;
+    // Adding this aligns the fraction of a subnormal result at the bottom of the float, where
+    // the FPU rounds it to nearest even
+    const float subnormal_magic = F32(static_cast<uint32_t>((127 - 15 + 23 - 10 + 1) << 23)).f;
+    for (; i < count; ++i)
+    {
+        uint32_t bits = F32(source[i]).i;
+        uint32_t sign = bits & 0x80000000;
+        bits ^= sign;
+        uint16_t half;
+        if (bits >= f16_overflow)
+        {
+            // Infinity, or a quiet NaN
+            half = bits > f32_infinity ? 0x7E00 : 0x7C00;
+        }
+        else if (bits < min_normal)
+        {
+            half = static_cast<uint16_t>(F32(F32(bits).f + subnormal_magic).i -
+                                         F32(subnormal_magic).i);
+        }
+        else
+        {
+            uint32_t odd = (bits >> 13) & 1;
+            bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFF + odd;
+            half = static_cast<uint16_t>(bits >> 13);
+        }
+        target[i] = from_bits(static_cast<uint16_t>(half | (sign >> 16)));
+    }
+}
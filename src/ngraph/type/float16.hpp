@@ -58,6 +58,11 @@ namespace ngraph
         bool operator>=(const float16& other) const;
         operator float() const;
 
+        /// \brief Convert `count` values to float, with F16C when the build targets it
+        static void to_float(const float16* source, float* target, size_t count);
+        /// \brief Convert `count` floats, rounding to nearest even, with F16C when the build
+        /// targets it
+        static void from_float(const float* source, float16* target, size_t count);
         static constexpr float16 from_bits(uint16_t bits) { return float16(bits, true); }
         uint16_t to_bits() const;
         friend std::ostream& operator<<(std::ostream& out, const float16& obj)
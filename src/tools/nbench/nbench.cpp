@@ -154,6 +154,25 @@ void print_times(const multimap<size_t, string>& timing)
     }
 }
 
+void print_throughput(const vector<runtime::PerformanceSummary>& summaries)
+{
+    int name_width = 0;
+    for (const runtime::PerformanceSummary& summary : summaries)
+    {
+        name_width = max(name_width, static_cast<int>(summary.op_type.size()));
+    }
+    cout << setw(name_width + 2) << left << "op" << setw(14) << right << "time(us)"
+         << setw(12) << "GFLOP/s" << setw(12) << "GB/s" << setw(12) << "FLOP/byte\n";
+    for (const runtime::PerformanceSummary& summary : summaries)
+    {
+        cout << setw(name_width + 2) << left << summary.op_type << setw(14) << right
+             << summary.total_microseconds << fixed << setprecision(2) << setw(12)
+             << summary.gflops_per_second() << setw(12) << summary.gigabytes_per_second()
+             << setw(12) << summary.arithmetic_intensity() << "\n";
+    }
+    cout.unsetf(ios_base::floatfield);
+}
+
 void print_results(vector<PerfShape> perf_data, bool timing_detail)
 {
     sort(perf_data.begin(), perf_data.end(), [](const PerfShape& p1, const PerfShape& p2) {
@@ -169,6 +188,10 @@ void print_results(vector<PerfShape> perf_data, bool timing_detail)
 
         cout << "\n---- Aggregate times per op type/shape/count ----\n";
         print_times(timing_details);
+
+        cout << "\n---- Throughput per op type ----\n";
+        print_throughput(runtime::summarize_by_op_type(
+            vector<runtime::PerformanceCounter>(perf_data.begin(), perf_data.end())));
     }
 }
 
@@ -0,0 +1,219 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/all_reduce_bucketing.hpp"
+#include "ngraph/pass/manager.hpp"
+#include "util/all_close_f.hpp"
+#include "util/test_tools.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+static shared_ptr<Node> find_start(shared_ptr<Function> f, const Shape& shape)
+{
+    for (auto node : f->get_ops())
+    {
+        if (is_type<op::AllReduceStart>(node) && node->get_output_shape(0) == shape)
+        {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+TEST(all_reduce_bucketing, buckets_by_size)
+{
+    // Four gradients of 64 bytes in buckets of 128 bytes
+    ParameterVector params;
+    NodeVector results;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        auto param = make_shared<op::Parameter>(element::f32, Shape{4, 4});
+        params.push_back(param);
+        results.push_back(make_shared<op::AllReduce>(param));
+    }
+    auto f = make_shared<Function>(results, params);
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::AllReduceBucketing>(128);
+    pass_manager.run_passes(f);
+
+    EXPECT_EQ(count_ops_of_type<op::AllReduce>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::AllReduceStart>(f), 2);
+    EXPECT_EQ(count_ops_of_type<op::AllReduceWait>(f), 2);
+    EXPECT_EQ(count_ops_of_type<op::Concat>(f), 2);
+    EXPECT_EQ(count_ops_of_type<op::Slice>(f), 4);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(f->get_output_shape(i), (Shape{4, 4}));
+    }
+
+    // The first bucket is waited for after the second has started
+    size_t overlapped = 0;
+    for (auto node : f->get_ops())
+    {
+        if (is_type<op::AllReduceWait>(node))
+        {
+            for (auto& dependency : node->get_control_dependencies())
+            {
+                EXPECT_TRUE(is_type<op::AllReduceStart>(dependency));
+                EXPECT_NE(dependency, node->get_input_node_shared_ptr(0));
+                overlapped++;
+            }
+        }
+    }
+    EXPECT_EQ(overlapped, 1);
+}
+
+TEST(all_reduce_bucketing, large_gradient_alone)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{64});
+    auto B = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto C = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto f = make_shared<Function>(NodeVector{make_shared<op::AllReduce>(A),
+                                              make_shared<op::AllReduce>(B),
+                                              make_shared<op::AllReduce>(C)},
+                                   ParameterVector{A, B, C});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::AllReduceBucketing>(32);
+    pass_manager.run_passes(f);
+
+    EXPECT_EQ(count_ops_of_type<op::AllReduceStart>(f), 2);
+    EXPECT_NE(find_start(f, Shape{64}), nullptr);
+    EXPECT_NE(find_start(f, Shape{4}), nullptr);
+}
+
+TEST(all_reduce_bucketing, types_and_reductions_apart)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto B = make_shared<op::Parameter>(element::f64, Shape{2});
+    auto C = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto D = make_shared<op::Parameter>(element::f32, Shape{3});
+    auto f = make_shared<Function>(
+        NodeVector{make_shared<op::AllReduce>(A),
+                   make_shared<op::AllReduce>(B),
+                   make_shared<op::AllReduce>(C, reduction::Type::MAX),
+                   make_shared<op::AllReduce>(D)},
+        ParameterVector{A, B, C, D});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::AllReduceBucketing>();
+    pass_manager.run_passes(f);
+
+    EXPECT_EQ(count_ops_of_type<op::AllReduceStart>(f), 3);
+    auto sum = find_start(f, Shape{5});
+    ASSERT_NE(sum, nullptr);
+    EXPECT_EQ(sum->get_element_type(), element::f32);
+    EXPECT_EQ(as_type_ptr<op::AllReduceStart>(sum)->get_reduce_type(), reduction::Type::SUM);
+}
+
+TEST(all_reduce_bucketing, dependent_all_reduces)
+{
+    // The second all-reduce needs the result of the first, so they cannot share a bucket
+    auto A = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto B = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto first = make_shared<op::AllReduce>(A);
+    auto second = make_shared<op::AllReduce>(first * B);
+    auto f = make_shared<Function>(NodeVector{first, second}, ParameterVector{A, B});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::AllReduceBucketing>();
+    pass_manager.run_passes(f);
+
+    EXPECT_EQ(count_ops_of_type<op::AllReduceStart>(f), 2);
+    EXPECT_EQ(count_ops_of_type<op::Concat>(f), 0);
+    for (auto node : f->get_ops())
+    {
+        if (is_type<op::AllReduceWait>(node))
+        {
+            EXPECT_TRUE(node->get_control_dependencies().empty());
+        }
+    }
+}
+
+#if defined(NGRAPH_INTERPRETER_ENABLE) && !defined(_WIN32) &&                                     \
+    !defined(NGRAPH_DISTRIBUTED_OMPI_ENABLE) && !defined(NGRAPH_DISTRIBUTED_MLSL_ENABLE)
+#include <unistd.h>
+
+#include "ngraph/distributed/null.hpp"
+#include "ngraph/distributed/shared_memory.hpp"
+
+namespace
+{
+    // Puts the null interface back when a test ends, also after a failed assertion
+    class ResetDistributedInterface
+    {
+    public:
+        ~ResetDistributedInterface()
+        {
+            set_distributed_interface(
+                unique_ptr<DistributedInterface>(new distributed::NullDistributedInterface()));
+        }
+    };
+}
+
+TEST(all_reduce_bucketing, interpreter)
+{
+    ResetDistributedInterface reset_distributed_interface;
+    // A single rank reduces to its own values, which checks the slicing back into tensors
+    set_distributed_interface(unique_ptr<DistributedInterface>(
+        new distributed::SharedMemoryDistributedInterface(
+            "ngraph-bucketing-test-" + to_string(getpid()), 0, 1)));
+
+    auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3});
+    auto B = make_shared<op::Parameter>(element::f32, Shape{});
+    auto C = make_shared<op::Parameter>(element::f32, Shape{4});
+    auto D = make_shared<op::Parameter>(element::f32, Shape{2});
+    auto f = make_shared<Function>(NodeVector{make_shared<op::AllReduce>(A + A),
+                                              make_shared<op::AllReduce>(B),
+                                              make_shared<op::AllReduce>(C),
+                                              make_shared<op::AllReduce>(D)},
+                                   ParameterVector{A, B, C, D});
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::AllReduceBucketing>(32);
+    pass_manager.run_passes(f);
+    ASSERT_EQ(count_ops_of_type<op::AllReduceStart>(f), 2);
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    vector<vector<float>> inputs{{1, 2, 3, 4, 5, 6}, {7}, {8, 9, 10, 11}, {12, 13}};
+    vector<vector<float>> expected{{2, 4, 6, 8, 10, 12}, {7}, {8, 9, 10, 11}, {12, 13}};
+    vector<shared_ptr<runtime::Tensor>> args;
+    vector<shared_ptr<runtime::Tensor>> results;
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        args.push_back(backend->create_tensor(element::f32, f->get_parameters()[i]->get_shape()));
+        copy_data(args.back(), inputs[i]);
+        results.push_back(backend->create_tensor(element::f32, f->get_output_shape(i)));
+    }
+    auto handle = backend->compile(f);
+    // Twice, so the second call reuses the requests of the first
+    for (size_t call = 0; call < 2; ++call)
+    {
+        handle->call_with_validate(results, args);
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            EXPECT_TRUE(test::all_close_f(expected[i], read_vector<float>(results[i])));
+        }
+    }
+}
+#endif
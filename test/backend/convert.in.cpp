@@ -169,3 +169,45 @@ NGRAPH_TEST(${BACKEND_NAME}, convert_bf16_float32)
                              1.5f}),
               read_vector<float>(result));
 }
+
+NGRAPH_TEST(${BACKEND_NAME}, convert_float32_f16)
+{
+    Shape shape_a{3, 5};
+    vector<float> a_data = {0.5f, 1.5f, -2.25f, 65504.f, 1e-3f, 3.f, 0.f, -0.f,
+                            100.f, 1.f / 3, 7.f, 8.f, 9.f, 10.f, 11.f};
+
+    auto A = make_shared<op::Parameter>(element::f32, shape_a);
+    auto convert = make_shared<op::Convert>(A, element::f16);
+    auto f = make_shared<Function>(NodeVector{convert}, ParameterVector{A});
+    auto backend = runtime::Backend::create("${BACKEND_NAME}");
+    auto a = backend->create_tensor(element::f32, shape_a);
+    copy_data(a, a_data);
+    auto result = backend->create_tensor(element::f16, shape_a);
+    auto handle = backend->compile(f);
+    handle->call_with_validate({result}, {a});
+    vector<float16> expected;
+    for (float value : a_data)
+    {
+        expected.push_back(float16(value));
+    }
+    EXPECT_EQ(expected, read_vector<float16>(result));
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, convert_f16_float32)
+{
+    Shape shape_a{3, 5};
+    vector<float16> a_data = {
+        0.5, 1.5, -2.25, 65504, 0.125, 3, 0, -1, 100, 0.25, 7, 8, 9, 10, 11};
+
+    auto A = make_shared<op::Parameter>(element::f16, shape_a);
+    auto convert = make_shared<op::Convert>(A, element::f32);
+    auto f = make_shared<Function>(NodeVector{convert}, ParameterVector{A});
+    auto backend = runtime::Backend::create("${BACKEND_NAME}");
+    auto a = backend->create_tensor(element::f16, shape_a);
+    copy_data(a, a_data);
+    auto result = backend->create_tensor(element::f32, shape_a);
+    auto handle = backend->compile(f);
+    handle->call_with_validate({result}, {a});
+    EXPECT_EQ((vector<float>{0.5, 1.5, -2.25, 65504, 0.125, 3, 0, -1, 100, 0.25, 7, 8, 9, 10, 11}),
+              read_vector<float>(result));
+}
@@ -15,6 +15,7 @@
 //*****************************************************************************
 
 #include <fstream>
+#include <numeric>
 #include <sstream>
 
 #include "gtest/gtest.h"
@@ -22,6 +23,8 @@
 #include "ngraph/distributed.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/ngraph.hpp"
+#include "ngraph/pass/all_reduce_bucketing.hpp"
+#include "ngraph/pass/manager.hpp"
 #include "ngraph/serializer.hpp"
 #include "util/all_close_f.hpp"
 #include "util/random.hpp"
@@ -115,6 +118,47 @@ NGRAPH_TEST(${BACKEND_NAME}, allreduce_prod)
 }
 #endif
 
+NGRAPH_TEST(${BACKEND_NAME}, allreduce_bucketed)
+{
+    auto comm_size = get_distributed_interface()->get_size();
+    if (comm_size > 1)
+    {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{2, 2});
+        auto B = make_shared<op::Parameter>(element::f32, Shape{3});
+        auto C = make_shared<op::Parameter>(element::f32, Shape{5});
+        auto f = make_shared<Function>(NodeVector{make_shared<op::AllReduce>(A),
+                                                  make_shared<op::AllReduce>(B),
+                                                  make_shared<op::AllReduce>(C)},
+                                       ParameterVector{A, B, C});
+        // Buckets of 32 bytes put A and B together and C on its own
+        pass::Manager pass_manager;
+        pass_manager.register_pass<pass::AllReduceBucketing>(32);
+        pass_manager.run_passes(f);
+
+        auto backend = runtime::Backend::create("${BACKEND_NAME}");
+        vector<shared_ptr<runtime::Tensor>> args;
+        vector<shared_ptr<runtime::Tensor>> results;
+        vector<vector<float>> expected;
+        for (auto param : f->get_parameters())
+        {
+            vector<float> v(shape_size(param->get_shape()));
+            iota(v.begin(), v.end(), 1);
+            args.push_back(backend->create_tensor(element::f32, param->get_shape()));
+            copy_data(args.back(), v);
+            results.push_back(backend->create_tensor(element::f32, param->get_shape()));
+            transform(v.begin(), v.end(), v.begin(), [=](float x) { return x * comm_size; });
+            expected.push_back(v);
+        }
+
+        auto handle = backend->compile(f);
+        handle->call_with_validate(results, args);
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            EXPECT_TRUE(test::all_close_f(expected[i], read_vector<float>(results[i])));
+        }
+    }
+}
+
 NGRAPH_TEST(${BACKEND_NAME}, broadcastdistributed)
 {
     auto shape = Shape{2, 2};
@@ -16,6 +16,7 @@
 
 #include "gtest/gtest.h"
 #include "ngraph/ngraph.hpp"
+#include "ngraph/runtime/dynamic/dynamic_backend.hpp"
 #include "util/all_close_f.hpp"
 #include "util/test_control.hpp"
 #include "util/test_tools.hpp"
@@ -292,3 +293,166 @@ NGRAPH_TEST(${BACKEND_NAME}, dynamic_reverse_shape)
                         Shape{8, 2, 8, 2},
                         Shape{2, 3, 4, 5, 2}});
 }
+
+NGRAPH_TEST(${BACKEND_NAME}, dynamic_bucketed_lengths)
+{
+    // f(a,b) = (a*a+a, b+b) with shapes {?,3}; the leading dimension is bucketed to powers of
+    // two and both results are sliced back to it.
+    auto a = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic(), 3});
+    auto b = make_shared<op::Parameter>(element::i32, PartialShape{Dimension::dynamic(), 3});
+    auto f = make_shared<Function>(NodeVector{a * a + a, b + b}, ParameterVector{a, b});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}", true);
+    auto ex = backend->compile(f);
+    auto dynamic_ex = dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(ex);
+    if (!dynamic_ex)
+    {
+        // The backend supports dynamic shapes natively; there is nothing to bucket.
+        return;
+    }
+
+    runtime::dynamic::BucketPolicy policy;
+    policy.add_power_of_two(0, 0);
+    policy.add_power_of_two(1, 0);
+    policy.add_output_slice(0, 0, 0, 0);
+    policy.add_output_slice(1, 0, 1, 0);
+    dynamic_ex->set_bucket_policy(policy);
+
+    auto t_r0 = backend->create_dynamic_tensor(element::f32, PartialShape{Dimension::dynamic(), 3});
+    auto t_r1 = backend->create_dynamic_tensor(element::i32, PartialShape{Dimension::dynamic(), 3});
+
+    for (size_t length : {1, 3, 4, 5, 9, 7})
+    {
+        vector<float> a_values(length * 3);
+        vector<int32_t> b_values(length * 3);
+        vector<float> expected_r0(length * 3);
+        vector<int32_t> expected_r1(length * 3);
+        for (size_t i = 0; i < length * 3; i++)
+        {
+            a_values[i] = i;
+            b_values[i] = -static_cast<int32_t>(i);
+            expected_r0[i] = a_values[i] * a_values[i] + a_values[i];
+            expected_r1[i] = 2 * b_values[i];
+        }
+
+        auto t_a = backend->create_tensor(element::f32, Shape{length, 3});
+        auto t_b = backend->create_tensor(element::i32, Shape{length, 3});
+        copy_data(t_a, a_values);
+        copy_data(t_b, b_values);
+
+        ex->call_with_validate({t_r0, t_r1}, {t_a, t_b});
+
+        ASSERT_EQ(t_r0->get_shape(), (Shape{length, 3}));
+        ASSERT_EQ(t_r1->get_shape(), (Shape{length, 3}));
+        EXPECT_TRUE(test::all_close_f(read_vector<float>(t_r0), expected_r0));
+        EXPECT_EQ(read_vector<int32_t>(t_r1), expected_r1);
+    }
+
+    // Lengths 1, 3, 4, 5, 9 and 7 fall into the buckets 1, 4, 8 and 16.
+    EXPECT_EQ(dynamic_ex->get_cached_executable_count(), 4);
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, dynamic_bucket_policy_power_of_two_min_size)
+{
+    runtime::dynamic::BucketPolicy policy;
+    policy.add_power_of_two(0, 0, 5);
+
+    // The minimum of 5 is rounded up to 8, so every bucket is a power of two.
+    EXPECT_EQ(policy.get_bucket(0, 0, 1), 8);
+    EXPECT_EQ(policy.get_bucket(0, 0, 8), 8);
+    EXPECT_EQ(policy.get_bucket(0, 0, 9), 16);
+    EXPECT_EQ(policy.get_bucket(0, 1, 3), 3);
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, dynamic_background_compilation)
+{
+    auto a = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic()});
+    auto b = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic()});
+    auto f = make_shared<Function>(a * b + a, ParameterVector{a, b});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}", true);
+    auto ex = backend->compile(f);
+    auto dynamic_ex = dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(ex);
+    if (!dynamic_ex)
+    {
+        // The backend supports dynamic shapes natively; nothing is compiled per shape.
+        return;
+    }
+    dynamic_ex->enable_background_compilation();
+
+    auto t_r = backend->create_dynamic_tensor(element::f32, PartialShape{Dimension::dynamic()});
+
+    // The first round is served by the fallback while the shapes compile, the second by the
+    // compiled executables.
+    for (size_t round = 0; round < 2; round++)
+    {
+        for (size_t length : {2, 5, 2, 7})
+        {
+            vector<float> a_values(length);
+            vector<float> b_values(length);
+            vector<float> expected(length);
+            for (size_t i = 0; i < length; i++)
+            {
+                a_values[i] = i + 1;
+                b_values[i] = round + length;
+                expected[i] = a_values[i] * b_values[i] + a_values[i];
+            }
+
+            auto t_a = backend->create_tensor(element::f32, Shape{length});
+            auto t_b = backend->create_tensor(element::f32, Shape{length});
+            copy_data(t_a, a_values);
+            copy_data(t_b, b_values);
+
+            ex->call_with_validate({t_r}, {t_a, t_b});
+
+            ASSERT_EQ(t_r->get_shape(), (Shape{length}));
+            EXPECT_TRUE(test::all_close_f(read_vector<float>(t_r), expected));
+        }
+        dynamic_ex->wait_for_background_compilation();
+        EXPECT_EQ(dynamic_ex->get_cached_executable_count(), 3);
+    }
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, dynamic_background_compilation_larger_bucket)
+{
+    auto a = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic()});
+    auto f = make_shared<Function>(a * a, ParameterVector{a});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}", true);
+    auto ex = backend->compile(f);
+    auto dynamic_ex = dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(ex);
+    if (!dynamic_ex)
+    {
+        return;
+    }
+    runtime::dynamic::BucketPolicy policy;
+    policy.add_power_of_two(0, 0);
+    policy.add_output_slice(0, 0, 0, 0);
+    dynamic_ex->set_bucket_policy(policy);
+    dynamic_ex->enable_background_compilation();
+
+    auto t_r = backend->create_dynamic_tensor(element::f32, PartialShape{Dimension::dynamic()});
+
+    // Length 3 belongs to bucket 4. Bucket 8 is already cached when length 3 comes along, and
+    // serves it while bucket 4 compiles; the second length 3 runs on bucket 4.
+    size_t call_count = 0;
+    for (size_t length : {8, 3, 3})
+    {
+        vector<float> a_values(length);
+        vector<float> expected(length);
+        for (size_t i = 0; i < length; i++)
+        {
+            a_values[i] = i;
+            expected[i] = a_values[i] * a_values[i];
+        }
+        auto t_a = backend->create_tensor(element::f32, Shape{length});
+        copy_data(t_a, a_values);
+
+        ex->call_with_validate({t_r}, {t_a});
+
+        ASSERT_EQ(t_r->get_shape(), (Shape{length}));
+        EXPECT_TRUE(test::all_close_f(read_vector<float>(t_r), expected));
+        dynamic_ex->wait_for_background_compilation();
+        EXPECT_EQ(dynamic_ex->get_cached_executable_count(), ++call_count == 1 ? 1 : 2);
+    }
+}
@@ -15,8 +15,11 @@
 //*****************************************************************************
 
 #include "gtest/gtest.h"
+#include "misc.hpp"
+#include "ngraph/file_util.hpp"
 #include "ngraph/ngraph.hpp"
 #include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/cache.hpp"
 #include "ngraph/util.hpp"
 #include "util/all_close_f.hpp"
 #include "util/test_tools.hpp"
@@ -101,3 +104,158 @@ TEST(backend_api, executable_can_create_tensor)
     EXPECT_TRUE(cpu->executable_can_create_tensors());
 }
 #endif
+
+TEST(backend_api, lru_cache_key)
+{
+    runtime::CacheKey a{2, 3, 4};
+    runtime::CacheKey b{2, 3, 4};
+    runtime::CacheKey c{2, 4, 3};
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.get_hash(), b.get_hash());
+    EXPECT_NE(a, c);
+
+    // Keys longer than the inline storage still compare element-wise.
+    runtime::CacheKey long_a;
+    runtime::CacheKey long_b;
+    for (int64_t i = 0; i < 100; i++)
+    {
+        long_a.push_back(i);
+        long_b.push_back(i == 99 ? -1 : i);
+    }
+    EXPECT_EQ(long_a.size(), 100);
+    EXPECT_EQ(long_a[99], 99);
+    EXPECT_NE(long_a, long_b);
+}
+
+TEST(backend_api, lru_cache_eviction)
+{
+    auto f = make_shared<Function>(ResultVector{}, ParameterVector{});
+    runtime::LRUCache cache(2);
+    EXPECT_EQ(cache.get_capacity(), 2);
+
+    cache.add_entry({1}, nullptr, f);
+    cache.add_entry({2}, nullptr, f);
+    // Touch {1} so that {2} becomes the least recently used entry.
+    EXPECT_EQ(cache.get_cloned_function({1}), f);
+    shared_ptr<runtime::Executable> exec;
+    shared_ptr<Function> func;
+    EXPECT_TRUE(cache.get_entry({1}, exec, func));
+    cache.add_entry({3}, nullptr, f);
+
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_TRUE(cache.is_cached({1}));
+    EXPECT_FALSE(cache.is_cached({2}));
+    EXPECT_TRUE(cache.is_cached({3}));
+    EXPECT_FALSE(cache.get_entry({2}, exec, func));
+    EXPECT_THROW(cache.get_cached_entry({2}), ngraph_error);
+
+    runtime::LRUCache disabled(0);
+    disabled.add_entry({1}, nullptr, f);
+    EXPECT_FALSE(disabled.is_cached({1}));
+}
+
+#ifndef NGRAPH_JSON_DISABLE
+TEST(backend_api, executable_disk_cache)
+{
+    auto make_function = [](const Shape& shape) {
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = make_shared<op::Parameter>(element::f32, shape);
+        return make_shared<Function>(make_shared<op::Add>(A, B), ParameterVector{A, B});
+    };
+    // Separately built graphs differ only in generated names.
+    auto f = make_function(Shape{2, 2});
+    auto g = make_function(Shape{2, 2});
+    string key = runtime::DiskCache::make_key("INTERPRETER", f, nullptr);
+    EXPECT_EQ(runtime::DiskCache::make_key("INTERPRETER", g, nullptr), key);
+    EXPECT_NE(runtime::DiskCache::make_key("CPU", f, nullptr), key);
+    EXPECT_NE(runtime::DiskCache::make_key("INTERPRETER", make_function(Shape{4}), nullptr),
+              key);
+
+    string directory =
+        file_util::path_join(file_util::get_temp_directory_path(), "executable_disk_cache");
+    file_util::remove_directory(directory);
+    set_environment("NGRAPH_EXECUTABLE_CACHE_DIR", directory.c_str(), 1);
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    shared_ptr<runtime::Tensor> a = backend->create_tensor(element::f32, Shape{2, 2});
+    shared_ptr<runtime::Tensor> b = backend->create_tensor(element::f32, Shape{2, 2});
+    shared_ptr<runtime::Tensor> result = backend->create_tensor(element::f32, Shape{2, 2});
+    copy_data<float>(a, {1.f, 2.f, 3.f, 4.f});
+    copy_data<float>(b, {5.f, 6.f, 7.f, 8.f});
+
+    // The first compilation stores the entry, the second one loads it.
+    for (auto function : {f, g})
+    {
+        auto handle = backend->compile(function);
+        ASSERT_NE(handle, nullptr);
+        EXPECT_TRUE(file_util::exists(runtime::DiskCache::get_default()->get_path(key)));
+        handle->call_with_validate({result}, {a, b});
+        EXPECT_TRUE(test::all_close_f(read_vector<float>(result), {6.f, 8.f, 10.f, 12.f}));
+    }
+
+    unset_environment("NGRAPH_EXECUTABLE_CACHE_DIR");
+    EXPECT_EQ(runtime::DiskCache::get_default(), nullptr);
+    file_util::remove_directory(directory);
+}
+#endif
+
+TEST(backend_api, performance_data)
+{
+    Shape shape_a{2, 3};
+    Shape shape_b{3, 4};
+    auto A = make_shared<op::Parameter>(element::f32, shape_a);
+    auto B = make_shared<op::Parameter>(element::f32, shape_b);
+    auto C = make_shared<op::Parameter>(element::f32, Shape{2, 4});
+    auto dot = make_shared<op::Dot>(A, B);
+    auto add = make_shared<op::Add>(dot, C);
+    auto f = make_shared<Function>(add, ParameterVector{A, B, C});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    auto a = backend->create_tensor(element::f32, shape_a);
+    auto b = backend->create_tensor(element::f32, shape_b);
+    auto c = backend->create_tensor(element::f32, Shape{2, 4});
+    auto result = backend->create_tensor(element::f32, Shape{2, 4});
+    copy_data(a, vector<float>(6, 1));
+    copy_data(b, vector<float>(12, 1));
+    copy_data(c, vector<float>(8, 1));
+
+    auto handle = backend->compile(f, true);
+    handle->call_with_validate({result}, {a, b, c});
+    handle->call_with_validate({result}, {a, b, c});
+
+    bool found_dot = false;
+    for (const runtime::PerformanceCounter& counter : handle->get_performance_data())
+    {
+        // The backend may run a copy of the function
+        if (counter.get_node()->description() == "Dot")
+        {
+            found_dot = true;
+            EXPECT_EQ(counter.call_count(), 2);
+            EXPECT_EQ(counter.bytes_read(), (6 + 12) * sizeof(float));
+            EXPECT_EQ(counter.bytes_written(), 8 * sizeof(float));
+            // 2x4 outputs, each a sum of 3 products
+            EXPECT_EQ(counter.flops(), 48);
+            EXPECT_FLOAT_EQ(counter.arithmetic_intensity(), 48.0 / (26 * sizeof(float)));
+        }
+    }
+    EXPECT_TRUE(found_dot);
+    EXPECT_EQ(runtime::estimate_flops(*add), 8);
+    EXPECT_EQ(runtime::estimate_flops(*A), 0);
+
+    vector<runtime::PerformanceSummary> summaries =
+        runtime::summarize_by_op_type(handle->get_performance_data());
+    auto dot_summary = find_if(summaries.begin(),
+                               summaries.end(),
+                               [](const runtime::PerformanceSummary& summary) {
+                                   return summary.op_type == "Dot";
+                               });
+    ASSERT_NE(dot_summary, summaries.end());
+    EXPECT_EQ(dot_summary->op_count, 1);
+    EXPECT_EQ(dot_summary->call_count, 2);
+    EXPECT_EQ(dot_summary->total_flops, 96);
+    EXPECT_EQ(dot_summary->total_bytes_written, 2 * 8 * sizeof(float));
+    for (size_t i = 1; i < summaries.size(); i++)
+    {
+        EXPECT_GE(summaries[i - 1].total_microseconds, summaries[i].total_microseconds);
+    }
+}
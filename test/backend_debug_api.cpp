@@ -23,6 +23,7 @@
 #include "ngraph/log.hpp"
 #include "ngraph/ngraph.hpp"
 #include "ngraph/runtime/interpreter/int_executable.hpp"
+#include "misc.hpp"
 #include "util/test_tools.hpp"
 
 using namespace std;
@@ -74,3 +75,116 @@ TEST(INTERPRETER, nan_check_output)
     ihandle->set_nan_check(true);
     EXPECT_ANY_THROW(handle->call_with_validate({result}, {a, b}));
 }
+
+// Runs a chain deep enough that the memory plan has to recycle intermediate buffers, and
+// returns the number of performance counters
+static size_t run_memory_plan_reuse(bool fusion)
+{
+    Shape shape{4};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = op::Constant::create(element::f32, shape, {1, 1, 1, 1});
+    shared_ptr<Node> node = A;
+    for (size_t i = 0; i < 8; i++)
+    {
+        node = make_shared<op::Add>(make_shared<op::Multiply>(node, B), C);
+    }
+    auto f = make_shared<Function>(NodeVector{node, make_shared<op::Negative>(node)},
+                                   ParameterVector{A, B});
+
+    set_environment("NGRAPH_INTERPRETER_FUSION", fusion ? "1" : "0", 1);
+    shared_ptr<runtime::Backend> backend = runtime::Backend::create("INTERPRETER");
+    shared_ptr<runtime::Executable> handle = backend->compile(f, true);
+    unset_environment("NGRAPH_INTERPRETER_FUSION");
+
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    auto negative = backend->create_tensor(element::f32, shape);
+    copy_data(b, vector<float>{1, 1, 1, 1});
+
+    for (float x : {0.0f, 1.0f, 2.0f})
+    {
+        copy_data(a, vector<float>{x, x, x, x});
+        handle->call_with_validate({result, negative}, {a, b});
+        EXPECT_EQ(read_vector<float>(result), vector<float>(4, x + 8));
+        EXPECT_EQ(read_vector<float>(negative), vector<float>(4, -(x + 8)));
+    }
+    return handle->get_performance_data().size();
+}
+
+TEST(INTERPRETER, memory_plan_reuse)
+{
+    // 8 Multiplies, 8 Adds, the Negative and 2 Results
+    EXPECT_EQ(run_memory_plan_reuse(false), 19);
+}
+
+TEST(INTERPRETER, memory_plan_reuse_fused)
+{
+    // The chain is fused into one kernel, the Negative reads its result
+    EXPECT_EQ(run_memory_plan_reuse(true), 4);
+}
+
+// Runs independent towers of Adds on several threads, and returns the number of performance
+// counters
+static size_t run_parallel_branches(bool fusion)
+{
+    Shape shape{8};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    // Independent towers joined at the end, like an Inception block
+    NodeVector towers;
+    for (size_t i = 0; i < 6; i++)
+    {
+        shared_ptr<Node> tower = A;
+        for (size_t j = 0; j <= i; j++)
+        {
+            tower = make_shared<op::Add>(tower, B);
+        }
+        towers.push_back(tower);
+    }
+    auto f = make_shared<Function>(make_shared<op::Concat>(towers, 0), ParameterVector{A, B});
+
+    set_environment("NGRAPH_INTERPRETER_THREADS", "4", 1);
+    set_environment("NGRAPH_INTERPRETER_FUSION", fusion ? "1" : "0", 1);
+    shared_ptr<runtime::Backend> backend = runtime::Backend::create("INTERPRETER");
+    shared_ptr<runtime::Executable> handle = backend->compile(f, true);
+    unset_environment("NGRAPH_INTERPRETER_FUSION");
+    unset_environment("NGRAPH_INTERPRETER_THREADS");
+
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, Shape{48});
+    copy_data(a, vector<float>(8, 1));
+    copy_data(b, vector<float>(8, 2));
+
+    vector<float> expected;
+    for (size_t i = 0; i < 6; i++)
+    {
+        expected.insert(expected.end(), 8, 1 + 2 * (i + 1));
+    }
+    for (size_t i = 0; i < 10; i++)
+    {
+        handle->call_with_validate({result}, {a, b});
+        EXPECT_EQ(read_vector<float>(result), expected);
+    }
+
+    auto perf_data = handle->get_performance_data();
+    for (const runtime::PerformanceCounter& counter : perf_data)
+    {
+        EXPECT_EQ(counter.call_count(), 10);
+    }
+    return perf_data.size();
+}
+
+TEST(INTERPRETER, parallel_branches)
+{
+    // 21 Adds, the Concat and the Result
+    EXPECT_EQ(run_parallel_branches(false), 23);
+}
+
+TEST(INTERPRETER, parallel_branches_fused)
+{
+    // The single Add, a kernel for each longer tower, the Concat and the Result
+    EXPECT_EQ(run_parallel_branches(true), 8);
+}
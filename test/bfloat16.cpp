@@ -15,14 +15,19 @@
 //*****************************************************************************
 
 #include <climits>
+#include <cmath>
+#include <cstring>
 #include <random>
 
 #include "gtest/gtest.h"
 
 #include "ngraph/log.hpp"
+#include "ngraph/ngraph.hpp"
 #include "ngraph/runtime/aligned_buffer.hpp"
+#include "ngraph/runtime/backend.hpp"
 #include "ngraph/type/bfloat16.hpp"
 #include "util/float_util.hpp"
+#include "util/test_tools.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -259,3 +264,89 @@ TEST(bfloat16, assigns)
         EXPECT_EQ(f32arr[i], bf16arr[i]);
     }
 }
+
+TEST(bfloat16, bulk_conversions)
+{
+    // Every value widens like the scalar conversion. Normal values narrow back to themselves,
+    // subnormals may be flushed to zero by AVX-512 BF16.
+    vector<bfloat16> values;
+    for (uint32_t bits = 0; bits <= 0xFFFF; ++bits)
+    {
+        values.push_back(bfloat16::from_bits(static_cast<uint16_t>(bits)));
+    }
+    vector<float> widened(values.size());
+    bfloat16::to_float(values.data(), widened.data(), values.size());
+    vector<bfloat16> narrowed(values.size());
+    bfloat16::from_float(widened.data(), narrowed.data(), values.size());
+    size_t mismatches = 0;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        float expected = static_cast<float>(values[i]);
+        if (std::isnan(expected))
+        {
+            mismatches += !std::isnan(widened[i]) || !std::isnan(float(narrowed[i]));
+        }
+        else
+        {
+            bool subnormal = (values[i].to_bits() & 0x7F80) == 0;
+            mismatches += widened[i] != expected ||
+                          (!subnormal && narrowed[i].to_bits() != values[i].to_bits());
+        }
+    }
+    EXPECT_EQ(mismatches, 0);
+
+    // Halfway cases round to even, in the vectorized loop and in the scalar one after it
+    vector<uint32_t> halfway{
+        0x3F808000, 0x3F818000, 0x3F808001, 0x7F7FFFFF, 0xBF808000, 0x3F80FFFF, 0x3F800001};
+    vector<uint16_t> expected{0x3F80, 0x3F82, 0x3F81, 0x7F80, 0xBF80, 0x3F81, 0x3F80};
+    vector<float> floats;
+    for (size_t i = 0; i < 3 * halfway.size(); ++i)
+    {
+        float value;
+        memcpy(&value, &halfway[i % halfway.size()], sizeof(value));
+        floats.push_back(value);
+    }
+    vector<bfloat16> rounded(floats.size());
+    bfloat16::from_float(floats.data(), rounded.data(), floats.size());
+    for (size_t i = 0; i < floats.size(); ++i)
+    {
+        EXPECT_EQ(rounded[i].to_bits(), expected[i % expected.size()]) << floats[i];
+    }
+
+    float nan = std::numeric_limits<float>::quiet_NaN();
+    bfloat16 narrowed_nan;
+    bfloat16::from_float(&nan, &narrowed_nan, 1);
+    EXPECT_TRUE(std::isnan(static_cast<float>(narrowed_nan)));
+}
+
+#ifdef NGRAPH_INTERPRETER_ENABLE
+TEST(bfloat16, interpreter_fused_chain)
+{
+    // Spans several fused blocks; every intermediate is an integer that bf16 holds exactly
+    Shape shape{2, 3000};
+    auto A = make_shared<op::Parameter>(element::bf16, shape);
+    auto B = make_shared<op::Parameter>(element::bf16, Shape{});
+    auto sum = make_shared<op::Add>(A, make_shared<op::Broadcast>(B, shape, AxisSet{0, 1}));
+    auto difference = make_shared<op::Subtract>(make_shared<op::Multiply>(sum, A), A);
+    auto f = make_shared<Function>(make_shared<op::Abs>(difference), ParameterVector{A, B});
+    auto backend = runtime::Backend::create("INTERPRETER");
+
+    vector<bfloat16> a_data(shape_size(shape));
+    vector<bfloat16> expected(shape_size(shape));
+    for (size_t i = 0; i < a_data.size(); ++i)
+    {
+        float a = static_cast<float>(i % 7) - 3;
+        a_data[i] = a;
+        expected[i] = std::abs((a + 2) * a - a);
+    }
+    auto a = backend->create_tensor(element::bf16, shape);
+    auto b = backend->create_tensor(element::bf16, Shape{});
+    copy_data(a, a_data);
+    copy_data(b, vector<bfloat16>{2});
+    auto result = backend->create_tensor(element::bf16, shape);
+
+    auto handle = backend->compile(f);
+    handle->call_with_validate({result}, {a, b});
+    EXPECT_EQ(read_vector<bfloat16>(result), expected);
+}
+#endif
@@ -2201,3 +2201,67 @@ TEST(constant_folding, pass_property)
     ASSERT_FALSE(pass->get_property(pass::PassProperty::REQUIRE_STATIC_SHAPE));
     ASSERT_TRUE(pass->get_property(pass::PassProperty::CHANGE_DYNAMIC_STATE));
 }
+
+TEST(constant_folding, parallel_subgraphs)
+{
+    auto shared = op::Constant::create(element::f32, Shape{2, 3}, {1, 2, 3, 4, 5, 6});
+    // Two subgraphs computable from constants, both reading `shared`
+    auto reshape = make_shared<op::Reshape>(shared, AxisVector{1, 0}, Shape{3, 2});
+    auto negative = make_shared<op::Negative>(reshape);
+    auto scalar = op::Constant::create(element::f32, Shape{}, {2});
+    auto broadcast = make_shared<op::Broadcast>(scalar, Shape{2, 3}, AxisSet{0, 1});
+    auto product = make_shared<op::Multiply>(shared, broadcast);
+    auto p0 = make_shared<op::Parameter>(element::f32, Shape{3, 2});
+    auto p1 = make_shared<op::Parameter>(element::f32, Shape{2, 3});
+    auto f = make_shared<Function>(
+        NodeVector{make_shared<op::Add>(negative, p0), make_shared<op::Add>(product, p1)},
+        ParameterVector{p0, p1});
+
+    auto folding = make_shared<pass::ConstantFolding>();
+    folding->set_num_threads(4);
+    ASSERT_TRUE(folding->run_on_function(f));
+
+    ASSERT_EQ(count_ops_of_type<op::Reshape>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Negative>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Broadcast>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Multiply>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Constant>(f), 2);
+
+    auto negated =
+        as_type_ptr<op::Constant>(f->get_results().at(0)->get_argument(0)->get_argument(0));
+    ASSERT_TRUE(negated);
+    ASSERT_EQ((Shape{3, 2}), negated->get_shape());
+    ASSERT_EQ((vector<float>{-1, -4, -2, -5, -3, -6}), negated->get_vector<float>());
+    auto doubled =
+        as_type_ptr<op::Constant>(f->get_results().at(1)->get_argument(0)->get_argument(0));
+    ASSERT_TRUE(doubled);
+    ASSERT_EQ((vector<float>{2, 4, 6, 8, 10, 12}), doubled->get_vector<float>());
+    // The shared constant is left untouched
+    ASSERT_EQ((vector<float>{1, 2, 3, 4, 5, 6}), shared->get_vector<float>());
+}
+
+TEST(constant_folding, max_folded_bytes)
+{
+    auto scalar = op::Constant::create(element::f32, Shape{}, {1});
+    auto broadcast = make_shared<op::Broadcast>(scalar, Shape{1000}, AxisSet{0});
+    auto constant = op::Constant::create(element::f32, Shape{2, 2}, {1, 2, 3, 4});
+    auto reshape = make_shared<op::Reshape>(constant, AxisVector{0, 1}, Shape{4});
+    auto f = make_shared<Function>(NodeVector{broadcast, reshape}, ParameterVector{});
+
+    for (size_t threads : {1, 2})
+    {
+        auto folding = make_shared<pass::ConstantFolding>();
+        folding->set_num_threads(threads);
+        folding->set_max_folded_bytes(1024);
+        folding->run_on_function(f);
+
+        // 4000 bytes of broadcast are left to the backend, the reshape is folded
+        ASSERT_EQ(count_ops_of_type<op::Broadcast>(f), 1);
+        ASSERT_EQ(count_ops_of_type<op::Reshape>(f), 0);
+    }
+
+    auto folding = make_shared<pass::ConstantFolding>();
+    folding->set_max_folded_bytes(4000);
+    folding->run_on_function(f);
+    ASSERT_EQ(count_ops_of_type<op::Broadcast>(f), 0);
+}
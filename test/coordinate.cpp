@@ -15,11 +15,16 @@
 //*****************************************************************************
 
 #include <memory>
+#include <numeric>
 #include <string>
 
 #include "gtest/gtest.h"
 
 #include "ngraph/ngraph.hpp"
+#include "ngraph/runtime/reference/broadcast.hpp"
+#include "ngraph/runtime/reference/reverse.hpp"
+#include "ngraph/runtime/reference/sum.hpp"
+#include "ngraph/strided_walk.hpp"
 #include "util/ndarray.hpp"
 #include "util/test_tools.hpp"
 
@@ -335,3 +340,179 @@ TEST(benchmark, coordinate)
     timer.stop();
     cout << "time: " << timer.get_milliseconds() << endl;
 }
+
+TEST(coordinate, strided_walk_collapses_dense_axes)
+{
+    Shape shape{2, 1, 3, 4};
+    StridedWalk walk(shape, {StridedWalk::dense_strides(shape)});
+    EXPECT_EQ(walk.get_collapsed_shape(), Shape{24});
+    EXPECT_EQ(walk.get_run_count(), 1);
+    EXPECT_TRUE(walk.is_contiguous_run(0));
+
+    size_t runs = 0;
+    walk.for_each_run([&](const ptrdiff_t* offsets) {
+        EXPECT_EQ(offsets[0], 0);
+        runs++;
+    });
+    EXPECT_EQ(runs, 1);
+}
+
+TEST(coordinate, strided_walk_matches_coordinate_transform)
+{
+    // Read a [2,3,4] tensor reversed along axis 0 and broadcast along a new middle axis of
+    // length 2; compare every visited offset with the coordinate-based computation.
+    Shape in_shape{2, 3, 4};
+    Shape out_shape{2, 2, 3, 4};
+    vector<ptrdiff_t> in_strides{-12, 0, 4, 1};
+    StridedWalk walk(
+        out_shape, {in_strides, StridedWalk::dense_strides(out_shape)}, {12, 0});
+    EXPECT_EQ(walk.get_collapsed_shape(), (Shape{2, 2, 12}));
+    EXPECT_EQ(walk.get_run_length(), 12);
+
+    CoordinateTransform in_transform(in_shape);
+    CoordinateTransform out_transform(out_shape);
+    auto out_it = out_transform.begin();
+    walk.for_each_run([&](const ptrdiff_t* offsets) {
+        for (size_t i = 0; i < walk.get_run_length(); i++)
+        {
+            const Coordinate& out_coord = *out_it;
+            Coordinate in_coord{1 - out_coord[0], out_coord[2], out_coord[3]};
+            EXPECT_EQ(offsets[0] + i * walk.get_run_stride(0), in_transform.index(in_coord));
+            EXPECT_EQ(offsets[1] + i * walk.get_run_stride(1), out_transform.index(out_coord));
+            ++out_it;
+        }
+    });
+    EXPECT_TRUE(out_it == out_transform.end());
+}
+
+TEST(coordinate, strided_walk_empty)
+{
+    StridedWalk walk(Shape{3, 0, 2}, {{2, 2, 1}});
+    EXPECT_EQ(walk.get_run_count(), 0);
+    EXPECT_EQ(walk.get_run_length(), 0);
+    walk.for_each_run([](const ptrdiff_t*) { FAIL(); });
+}
+
+// The coordinate of `coord` without the axes in `axes`
+static Coordinate remove_axes(const Coordinate& coord, const AxisSet& axes)
+{
+    Coordinate result;
+    for (size_t axis = 0; axis < coord.size(); ++axis)
+    {
+        if (axes.count(axis) == 0)
+        {
+            result.push_back(coord[axis]);
+        }
+    }
+    return result;
+}
+
+TEST(coordinate, strided_walk_reverse)
+{
+    Shape shape{2, 3, 1, 4};
+    vector<int> arg(shape_size(shape));
+    iota(arg.begin(), arg.end(), 0);
+    for (const AxisSet& axes : {AxisSet{}, AxisSet{3}, AxisSet{0, 2}, AxisSet{0, 1, 2, 3}})
+    {
+        vector<int> out(arg.size());
+        runtime::reference::reverse(arg.data(), out.data(), shape, shape, axes);
+
+        CoordinateTransform transform(shape);
+        for (const Coordinate& coord : transform)
+        {
+            Coordinate arg_coord(coord);
+            for (size_t axis : axes)
+            {
+                arg_coord[axis] = shape[axis] - 1 - coord[axis];
+            }
+            EXPECT_EQ(out[transform.index(coord)], arg[transform.index(arg_coord)]);
+        }
+    }
+}
+
+TEST(coordinate, strided_walk_broadcast)
+{
+    struct Case
+    {
+        Shape in_shape;
+        Shape out_shape;
+        AxisSet axes;
+    };
+    // Leading, middle and trailing broadcast axes, input axes of length 1 and a scalar
+    for (const Case& c : {Case{{3, 4}, {2, 3, 5, 4}, {0, 2}},
+                          Case{{3}, {3, 2}, {1}},
+                          Case{{1, 4}, {3, 1, 4}, {0}},
+                          Case{{}, {2, 3}, {0, 1}}})
+    {
+        vector<int> arg(shape_size(c.in_shape));
+        iota(arg.begin(), arg.end(), 1);
+        vector<int> out(shape_size(c.out_shape));
+        runtime::reference::broadcast(arg.data(), out.data(), c.in_shape, c.out_shape, c.axes);
+
+        // The unit axes of the output are among those the input does not have
+        AxisSet removed(c.axes);
+        for (size_t axis = 0; axis < c.out_shape.size(); ++axis)
+        {
+            if (c.out_shape[axis] == 1)
+            {
+                removed.insert(axis);
+            }
+        }
+        Shape in_dense_shape;
+        for (size_t length : c.in_shape)
+        {
+            if (length != 1)
+            {
+                in_dense_shape.push_back(length);
+            }
+        }
+        CoordinateTransform out_transform(c.out_shape);
+        CoordinateTransform in_transform(in_dense_shape);
+        for (const Coordinate& coord : out_transform)
+        {
+            EXPECT_EQ(out[out_transform.index(coord)],
+                      arg[in_transform.index(remove_axes(coord, removed))]);
+        }
+    }
+
+    // An axis that is not broadcast must keep its length
+    vector<int> arg(4);
+    vector<int> out(6);
+    EXPECT_THROW(runtime::reference::broadcast(
+                     arg.data(), out.data(), Shape{4}, Shape{2, 3}, AxisSet{0}),
+                 CheckFailure);
+}
+
+TEST(coordinate, strided_walk_sum)
+{
+    Shape shape{3, 1, 4, 5};
+    vector<int64_t> arg(shape_size(shape));
+    for (size_t i = 0; i < arg.size(); ++i)
+    {
+        arg[i] = static_cast<int64_t>(i * i % 17) - 8;
+    }
+    for (const AxisSet& axes :
+         {AxisSet{}, AxisSet{1}, AxisSet{2}, AxisSet{0, 3}, AxisSet{0, 1, 2, 3}})
+    {
+        Shape out_shape;
+        for (size_t axis = 0; axis < shape.size(); ++axis)
+        {
+            if (axes.count(axis) == 0)
+            {
+                out_shape.push_back(shape[axis]);
+            }
+        }
+        vector<int64_t> out(shape_size(out_shape));
+        runtime::reference::sum(arg.data(), out.data(), shape, out_shape, axes);
+
+        vector<int64_t> expected(out.size(), 0);
+        CoordinateTransform in_transform(shape);
+        CoordinateTransform out_transform(out_shape);
+        for (const Coordinate& coord : in_transform)
+        {
+            expected[out_transform.index(remove_axes(coord, axes))] +=
+                arg[in_transform.index(coord)];
+        }
+        EXPECT_EQ(out, expected);
+    }
+}
@@ -15,7 +15,9 @@
 //*****************************************************************************
 
 #include <algorithm>
+#include <atomic>
 #include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <list>
 #include <memory>
@@ -38,8 +40,12 @@
 #include "ngraph/pass/constant_folding.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/visualize_tree.hpp"
+#include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/cpu/cpu_backend.hpp"
 #include "ngraph/runtime/cpu/cpu_builder.hpp"
+#include "ngraph/runtime/cpu/cpu_call_frame.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+#include "ngraph/runtime/cpu/cpu_numa.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
 #include "ngraph/runtime/cpu/op/convert_layout.hpp"
@@ -1052,6 +1058,211 @@ TEST(cpu_test, thread_safe_calls_convolution_2d_2items)
     unset_environment("NGRAPH_CPU_CONCURRENCY");
 }
 
+TEST(cpu_test, thread_safe_calls_pinned_context)
+{
+    if (is_codegen_mode())
+    {
+        // TODO change to skip when there is a new release of gtest
+        NGRAPH_WARN << "This test is skipped for CODEGEN mode.";
+        return;
+    }
+    if (std::thread::hardware_concurrency() < 2)
+    {
+        NGRAPH_WARN << "This test needs at least two hardware threads.";
+        return;
+    }
+
+    set_environment("NGRAPH_CPU_CONCURRENCY", "2", 1);
+
+    Shape shape{4};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto function = make_shared<Function>(make_shared<op::Add>(A, B), ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("CPU");
+    auto handle = backend->compile(function);
+    auto call_frame = dynamic_pointer_cast<runtime::cpu::CPU_Executable>(handle)->get_call_frame();
+
+    auto make_calls = [&](float offset) {
+        auto a = backend->create_tensor(element::f32, shape);
+        auto b = backend->create_tensor(element::f32, shape);
+        auto result = backend->create_tensor(element::f32, shape);
+        for (int i = 0; i < 50; i++)
+        {
+            copy_data(a, vector<float>{offset, offset + 1, offset + 2, float(i)});
+            copy_data(b, vector<float>{1, 2, 3, 4});
+            handle->call_with_validate({result}, {a, b});
+            EXPECT_EQ((vector<float>{offset + 1, offset + 3, offset + 5, float(i + 4)}),
+                      read_vector<float>(result));
+        }
+    };
+
+    // One of the two contexts is always left to threads that have not pinned one
+    ASSERT_TRUE(call_frame->pin_context());
+    ASSERT_TRUE(call_frame->pin_context());
+    std::thread unpinned([&]() {
+        EXPECT_FALSE(call_frame->pin_context());
+        make_calls(10);
+    });
+    make_calls(20);
+    unpinned.join();
+    call_frame->unpin_context();
+
+    vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&, t]() {
+            bool pinned = call_frame->pin_context();
+            make_calls(100 * t);
+            if (pinned)
+            {
+                call_frame->unpin_context();
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    unset_environment("NGRAPH_CPU_CONCURRENCY");
+}
+
+// Runs independent branches with the inter-op scheduler on concurrent contexts, and exits with 0
+// if every result is right
+static void run_inter_op_scheduler()
+{
+    set_environment("NGRAPH_INTER_OP_PARALLELISM", "3", 1);
+    set_environment("NGRAPH_CPU_CONCURRENCY", "3", 1);
+    if (runtime::cpu::executor::GetCPUExecutor().get_num_thread_pools() != 3)
+    {
+        exit(2);
+    }
+
+    Shape shape{64};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    NodeVector branches;
+    for (size_t i = 0; i < 6; i++)
+    {
+        auto c = op::Constant::create(element::f32, shape, vector<float>(shape_size(shape), i));
+        auto sum = make_shared<op::Add>(A, c);
+        branches.push_back(make_shared<op::Negative>(make_shared<op::Multiply>(sum, c)));
+    }
+    auto f = make_shared<Function>(make_shared<op::Concat>(branches, 0), ParameterVector{A});
+
+    auto backend = runtime::Backend::create("CPU");
+    auto handle = backend->compile(f);
+    atomic<bool> correct{true};
+    auto make_calls = [&](float offset) {
+        vector<float> a_data(shape_size(shape));
+        vector<float> expected;
+        for (size_t i = 0; i < branches.size(); i++)
+        {
+            for (size_t j = 0; j < a_data.size(); j++)
+            {
+                a_data[j] = offset + j;
+                expected.push_back(-(a_data[j] + i) * i);
+            }
+        }
+        auto a = backend->create_tensor(element::f32, shape);
+        copy_data(a, a_data);
+        auto result = backend->create_tensor(element::f32, Shape{shape_size(shape) * 6});
+        for (size_t call = 0; call < 50; call++)
+        {
+            handle->call_with_validate({result}, {a});
+            if (read_vector<float>(result) != expected)
+            {
+                correct = false;
+            }
+        }
+    };
+    std::thread call1(make_calls, 0.f);
+    std::thread call2(make_calls, 100.f);
+    std::thread call3(make_calls, 200.f);
+    call1.join();
+    call2.join();
+    call3.join();
+    exit(correct ? 0 : 1);
+}
+
+TEST(cpu_test, inter_op_scheduler)
+{
+    if (is_codegen_mode())
+    {
+        // TODO change to skip when there is a new release of gtest
+        NGRAPH_WARN << "This test is skipped for CODEGEN mode.";
+        return;
+    }
+
+    // The executor's thread pools are created on first use, so the scheduler runs in a fresh
+    // process that asks for more pools first
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    EXPECT_EXIT(run_inter_op_scheduler(), ::testing::ExitedWithCode(0), "");
+}
+
+TEST(cpu_test, numa_parse_cpu_list)
+{
+    using runtime::cpu::numa::parse_cpu_list;
+    EXPECT_EQ(parse_cpu_list("0-3,8-11"), (vector<int>{0, 1, 2, 3, 8, 9, 10, 11}));
+    EXPECT_EQ(parse_cpu_list("5"), (vector<int>{5}));
+    EXPECT_EQ(parse_cpu_list("0,2-3,7\n"), (vector<int>{0, 2, 3, 7}));
+    EXPECT_EQ(parse_cpu_list("4-4"), (vector<int>{4}));
+    EXPECT_EQ(parse_cpu_list(""), (vector<int>{}));
+    EXPECT_EQ(parse_cpu_list("\n"), (vector<int>{}));
+
+    for (string list : {"a", "1-", "-1", "3-1", "1,,x", "0-3 8", "1-2-3", "99999999999"})
+    {
+        EXPECT_THROW(parse_cpu_list(list), ngraph_error) << list;
+    }
+}
+
+TEST(cpu_test, numa_read_nodes)
+{
+    string directory = file_util::tmp_filename();
+    file_util::remove_file(directory);
+    file_util::make_directory(directory);
+    auto add_node = [&directory](int node, const string& cpulist) {
+        string node_directory = file_util::path_join(directory, "node" + to_string(node));
+        file_util::make_directory(node_directory);
+        ofstream(file_util::path_join(node_directory, "cpulist")) << cpulist << "\n";
+    };
+
+    // Without nodes, a single node holds every CPU
+    auto nodes = runtime::cpu::numa::read_nodes(directory);
+    ASSERT_EQ(nodes.size(), 1);
+    EXPECT_EQ(nodes[0].m_id, 0);
+    EXPECT_EQ(nodes[0].m_cpus.size(), max(thread::hardware_concurrency(), 1u));
+
+    // Node 1 only has memory, and node 2 is missing; node 3 keeps its number
+    add_node(0, "0-1,4");
+    add_node(1, "");
+    add_node(3, "2-3");
+    nodes = runtime::cpu::numa::read_nodes(directory);
+    ASSERT_EQ(nodes.size(), 2);
+    EXPECT_EQ(nodes[0].m_id, 0);
+    EXPECT_EQ(nodes[0].m_cpus, (vector<int>{0, 1, 4}));
+    EXPECT_EQ(nodes[1].m_id, 3);
+    EXPECT_EQ(nodes[1].m_cpus, (vector<int>{2, 3}));
+
+    file_util::remove_directory(directory);
+}
+
+TEST(cpu_test, numa_first_touch)
+{
+    // A range that starts and ends within a page touches the first byte of every page it
+    // overlaps, the partial ones included, and nothing outside it
+    size_t page_size = runtime::cpu::numa::get_page_size();
+    runtime::AlignedBuffer buffer(4 * page_size, page_size);
+    char* bytes = buffer.get_ptr<char>();
+    std::fill(bytes, bytes + buffer.size(), 1);
+    runtime::cpu::numa::first_touch(bytes + 10, 2 * page_size + 10);
+    for (size_t i = 0; i < buffer.size(); i++)
+    {
+        bool touched = i == 10 || i == page_size || i == 2 * page_size;
+        EXPECT_EQ(bytes[i], touched ? 0 : 1) << i;
+    }
+}
+
 TEST(cpu_test, constant_convertlayout)
 {
     Shape data_shape{1, 64, 56, 56};
@@ -15,6 +15,7 @@
 //*****************************************************************************
 
 #include <memory>
+#include <numeric>
 
 #include "gtest/gtest.h"
 #include "ngraph/file_util.hpp"
@@ -23,6 +24,7 @@
 #include "ngraph/ngraph.hpp"
 #include "ngraph/op/abs.hpp"
 #include "ngraph/op/add.hpp"
+#include "ngraph/op/concat.hpp"
 #include "ngraph/op/constant.hpp"
 #include "ngraph/op/divide.hpp"
 #include "ngraph/op/multiply.hpp"
@@ -307,6 +309,59 @@ TEST(CSE, constant)
     ASSERT_NE(abs111->get_argument(0), abs112->get_argument(0));
 }
 
+TEST(CSE, constant_weights)
+{
+    // Same element type, shape and bytes
+    Shape shape{64};
+    vector<float> values(shape_size(shape));
+    iota(values.begin(), values.end(), 0.0f);
+    auto A = std::make_shared<op::Parameter>(element::f32, shape);
+    auto w1 = op::Constant::create(element::f32, shape, values);
+    auto w2 = op::Constant::create(element::f32, shape, values);
+    values.back() = 0;
+    auto w3 = op::Constant::create(element::f32, shape, values);
+    auto w4 = op::Constant::create(element::i32, shape, vector<int32_t>(shape_size(shape), 0));
+
+    // Attribute-equal subgraphs on top of them are merged in the same pass.
+    auto concat1 = std::make_shared<op::Concat>(NodeVector{A, w1}, 0);
+    auto concat2 = std::make_shared<op::Concat>(NodeVector{A, w2}, 0);
+    auto concat3 = std::make_shared<op::Concat>(NodeVector{A, w3}, 0);
+    auto f = std::make_shared<Function>(NodeVector{concat1, concat2, concat3, w4},
+                                        ParameterVector{A});
+    pass::Manager pass_manager;
+    pass_manager.register_pass<ngraph::pass::CommonSubexpressionElimination>();
+    pass_manager.run_passes(f);
+
+    auto results = f->get_results();
+    EXPECT_EQ(results.at(0)->get_argument(0), results.at(1)->get_argument(0));
+    EXPECT_NE(results.at(0)->get_argument(0), results.at(2)->get_argument(0));
+    EXPECT_EQ(count_ops_of_type<op::Constant>(f), 3);
+    EXPECT_EQ(count_ops_of_type<op::Concat>(f), 2);
+}
+
+TEST(CSE, attributes)
+{
+    Shape shape{2, 3};
+    auto A = std::make_shared<op::Parameter>(element::f32, shape);
+    auto B = std::make_shared<op::Parameter>(element::f32, shape);
+    auto concat_0 = std::make_shared<op::Concat>(NodeVector{A, B}, 0);
+    auto concat_0_1 = std::make_shared<op::Concat>(NodeVector{A, B}, 0);
+    auto concat_1 = std::make_shared<op::Concat>(NodeVector{A, B}, 1);
+    auto add = std::make_shared<op::Add>(A, B);
+    auto add_numpy = std::make_shared<op::Add>(A, B, op::AutoBroadcastType::NUMPY);
+    auto f = std::make_shared<Function>(
+        NodeVector{concat_0, concat_0_1, concat_1, add, add_numpy}, ParameterVector{A, B});
+    pass::Manager pass_manager;
+    pass_manager.register_pass<ngraph::pass::CommonSubexpressionElimination>();
+    pass_manager.run_passes(f);
+
+    auto results = f->get_results();
+    EXPECT_EQ(results.at(0)->get_argument(0), results.at(1)->get_argument(0));
+    EXPECT_EQ(results.at(2)->get_argument(0), concat_1);
+    EXPECT_EQ(results.at(3)->get_argument(0), add);
+    EXPECT_EQ(results.at(4)->get_argument(0), add_numpy);
+}
+
 TEST(CSE, one_hot)
 {
     pass::Manager pass_manager;
@@ -0,0 +1,220 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <chrono>
+#include <cstdint>
+#include <fcntl.h>
+#include <functional>
+#include <memory>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/distributed/shared_memory.hpp"
+#include "ngraph/except.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+// Runs `body` on `size` threads, each a rank with its own interface to one segment
+static void run_ranks(int size,
+                      size_t slot_bytes,
+                      const function<void(distributed::SharedMemoryDistributedInterface&)>& body)
+{
+    string name = "ngraph-test-" + to_string(getpid());
+    vector<thread> threads;
+    for (int rank = 0; rank < size; ++rank)
+    {
+        threads.emplace_back([&, rank]() {
+            distributed::SharedMemoryDistributedInterface distributed(
+                name, rank, size, slot_bytes);
+            body(distributed);
+        });
+    }
+    for (thread& t : threads)
+    {
+        t.join();
+    }
+}
+
+TEST(distributed_shared_memory, all_reduce)
+{
+    const int size = 4;
+    // Slots of 64 bytes make a tensor of 37 floats take three uneven chunks
+    const size_t count = 37;
+    vector<vector<float>> sums(size);
+    vector<vector<float>> maxima(size);
+    run_ranks(size, 64, [&](distributed::SharedMemoryDistributedInterface& distributed) {
+        int rank = distributed.get_rank();
+        EXPECT_EQ(distributed.get_size(), size);
+        vector<float> in(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            in[i] = static_cast<float>(i * (rank + 1));
+        }
+        sums[rank].resize(count);
+        distributed.all_reduce(
+            in.data(), sums[rank].data(), element::f32, reduction::Type::SUM, count);
+        // In place, as the kernels may do
+        distributed.all_reduce(in.data(), in.data(), element::f32, reduction::Type::MAX, count);
+        maxima[rank] = in;
+    });
+    for (int rank = 0; rank < size; ++rank)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            EXPECT_EQ(sums[rank][i], static_cast<float>(i * 10));
+            EXPECT_EQ(maxima[rank][i], static_cast<float>(i * size));
+        }
+    }
+}
+
+TEST(distributed_shared_memory, all_reduce_start)
+{
+    const int size = 3;
+    const size_t count = 21;
+    vector<vector<double>> first(size);
+    vector<vector<double>> second(size);
+    vector<vector<double>> blocking(size);
+    run_ranks(size, 64, [&](distributed::SharedMemoryDistributedInterface& distributed) {
+        int rank = distributed.get_rank();
+        first[rank].assign(count, rank + 1);
+        second[rank].assign(count, rank * 2);
+        blocking[rank].assign(count, 1);
+        auto first_request = distributed.all_reduce_start(
+            first[rank].data(), first[rank].data(), element::f64, reduction::Type::SUM, count);
+        auto second_request = distributed.all_reduce_start(
+            second[rank].data(), second[rank].data(), element::f64, reduction::Type::MAX, count);
+        // A blocking collective runs after the queued ones
+        distributed.all_reduce(blocking[rank].data(),
+                               blocking[rank].data(),
+                               element::f64,
+                               reduction::Type::SUM,
+                               count);
+        second_request->wait();
+        first_request->wait();
+    });
+    for (int rank = 0; rank < size; ++rank)
+    {
+        EXPECT_EQ(first[rank], vector<double>(count, 6));
+        EXPECT_EQ(second[rank], vector<double>(count, 4));
+        EXPECT_EQ(blocking[rank], vector<double>(count, size));
+    }
+}
+
+TEST(distributed_shared_memory, broadcast)
+{
+    const int size = 3;
+    const size_t count = 50;
+    vector<vector<int64_t>> values(size);
+    run_ranks(size, 128, [&](distributed::SharedMemoryDistributedInterface& distributed) {
+        int rank = distributed.get_rank();
+        values[rank].assign(count, rank);
+        distributed.broadcast(values[rank].data(), element::i64, count, 1);
+    });
+    for (int rank = 0; rank < size; ++rank)
+    {
+        EXPECT_EQ(values[rank], vector<int64_t>(count, 1));
+    }
+}
+
+TEST(distributed_shared_memory, send_recv)
+{
+    // Every rank passes its values to the next one around a ring
+    const int size = 4;
+    const size_t count = 100;
+    vector<vector<int32_t>> received(size);
+    run_ranks(size, 64, [&](distributed::SharedMemoryDistributedInterface& distributed) {
+        int rank = distributed.get_rank();
+        vector<int32_t> values(count, rank);
+        received[rank].resize(count);
+        int next = (rank + 1) % size;
+        int previous = (rank + size - 1) % size;
+        if (rank % 2 == 0)
+        {
+            distributed.send(values.data(), element::i32, count, next);
+            distributed.recv(received[rank].data(), element::i32, count, previous);
+        }
+        else
+        {
+            distributed.recv(received[rank].data(), element::i32, count, previous);
+            distributed.send(values.data(), element::i32, count, next);
+        }
+    });
+    for (int rank = 0; rank < size; ++rank)
+    {
+        EXPECT_EQ(received[rank], vector<int32_t>(count, (rank + size - 1) % size));
+    }
+}
+
+TEST(distributed_shared_memory, stale_segment)
+{
+    const int size = 2;
+    const size_t slot_bytes = 64;
+    string name = "/ngraph-test-stale-" + to_string(getpid());
+
+    // What an earlier job leaves behind when it stops between initializing the segment and
+    // starting it: a segment of the same size whose header, a cache line that begins with
+    // the ready flag, says it is initialized. Each rank state is another cache line.
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(ftruncate(fd, 64 + size * (64 + slot_bytes)), 0);
+    uint32_t ready = 1;
+    ASSERT_EQ(pwrite(fd, &ready, sizeof(ready), 0), static_cast<ssize_t>(sizeof(ready)));
+    close(fd);
+
+    // Rank 1 attaches to the stale segment before rank 0 replaces it
+    vector<float> sums(size);
+    vector<thread> threads;
+    for (int rank = size - 1; rank >= 0; --rank)
+    {
+        threads.emplace_back([&, rank]() {
+            distributed::SharedMemoryDistributedInterface distributed(
+                name, rank, size, slot_bytes);
+            float value = rank + 1;
+            distributed.all_reduce(&value, &sums[rank], element::f32, reduction::Type::SUM, 1);
+        });
+        this_thread::sleep_for(chrono::milliseconds(20));
+    }
+    for (thread& t : threads)
+    {
+        t.join();
+    }
+    EXPECT_EQ(sums, vector<float>(size, 3));
+}
+
+TEST(distributed_shared_memory, attach_timeout)
+{
+    string name = "/ngraph-test-timeout-" + to_string(getpid());
+    // Rank 0 never comes
+    EXPECT_THROW(
+        {
+            distributed::SharedMemoryDistributedInterface distributed(
+                name, 1, 2, 64, chrono::milliseconds(20));
+        },
+        ngraph_error);
+    // Rank 1 never comes, and rank 0 removes the segment it created
+    EXPECT_THROW(
+        {
+            distributed::SharedMemoryDistributedInterface distributed(
+                name, 0, 2, 64, chrono::milliseconds(20));
+        },
+        ngraph_error);
+    EXPECT_LT(shm_open(name.c_str(), O_RDWR, 0600), 0);
+}
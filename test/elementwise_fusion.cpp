@@ -0,0 +1,172 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <memory>
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/op/experimental/compiled_kernel.hpp"
+#include "ngraph/pass/elementwise_fusion.hpp"
+#include "ngraph/pass/manager.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/serializer.hpp"
+#include "util/all_close_f.hpp"
+#include "util/test_tools.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+TEST(elementwise_fusion, chain)
+{
+    Shape shape{2, 3};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto sum = make_shared<op::Add>(A, B);
+    auto product = make_shared<op::Multiply>(sum, A);
+    auto f = make_shared<Function>(make_shared<op::Relu>(product), ParameterVector{A, B});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ElementwiseFusion>();
+    pass_manager.run_passes(f);
+
+    ASSERT_EQ(count_ops_of_type<op::CompiledKernel>(f), 1);
+    EXPECT_EQ(count_ops_of_type<op::Add>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::Multiply>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::Relu>(f), 0);
+    auto kernel = as_type_ptr<op::CompiledKernel>(f->get_results().at(0)->get_argument(0));
+    ASSERT_NE(kernel, nullptr);
+    EXPECT_EQ(kernel->get_node_list().size(), 3);
+    EXPECT_EQ(kernel->get_input_size(), 2);
+}
+
+TEST(elementwise_fusion, shared_value_is_materialized)
+{
+    Shape shape{2, 3};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto sum = make_shared<op::Add>(A, B);
+    auto exp = make_shared<op::Abs>(make_shared<op::Exp>(sum));
+    auto negative = make_shared<op::Negative>(sum);
+    auto f = make_shared<Function>(NodeVector{exp, negative}, ParameterVector{A, B});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ElementwiseFusion>();
+    pass_manager.run_passes(f);
+
+    // The Add has two users so it stays a kernel argument, the lone Negative is not fused
+    EXPECT_EQ(count_ops_of_type<op::CompiledKernel>(f), 1);
+    EXPECT_EQ(count_ops_of_type<op::Add>(f), 1);
+    EXPECT_EQ(count_ops_of_type<op::Negative>(f), 1);
+    EXPECT_EQ(count_ops_of_type<op::Exp>(f), 0);
+}
+
+TEST(elementwise_fusion, implicit_broadcast_is_not_fused)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3});
+    auto B = make_shared<op::Parameter>(element::f32, Shape{3});
+    auto sum = make_shared<op::Add>(A, B, op::AutoBroadcastType::NUMPY);
+    auto f = make_shared<Function>(make_shared<op::Exp>(sum), ParameterVector{A, B});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ElementwiseFusion>();
+    pass_manager.run_passes(f);
+
+    EXPECT_EQ(count_ops_of_type<op::CompiledKernel>(f), 0);
+}
+
+#ifdef NGRAPH_INTERPRETER_ENABLE
+static shared_ptr<Function> make_broadcast_chain(const Shape& shape)
+{
+    // Spans several blocks and ends in a partial one
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, Shape{shape.at(1)});
+    auto C = make_shared<op::Parameter>(element::f32, shape);
+    auto sum = make_shared<op::Add>(A, make_shared<op::Broadcast>(B, shape, AxisSet{0}));
+    auto product = make_shared<op::Multiply>(sum, A);
+    auto greater = make_shared<op::Greater>(product, C);
+    auto select =
+        make_shared<op::Select>(greater, product, make_shared<op::Negative>(product));
+    return make_shared<Function>(select, ParameterVector{A, B, C});
+}
+
+TEST(elementwise_fusion, interpreter_blocks)
+{
+    Shape shape{3, 5000};
+    auto f = make_broadcast_chain(shape);
+    auto backend = runtime::Backend::create("INTERPRETER");
+
+    vector<float> a(shape_size(shape));
+    vector<float> b(shape[1]);
+    vector<float> c(shape_size(shape));
+    vector<float> expected(shape_size(shape));
+    for (size_t i = 0; i < b.size(); ++i)
+    {
+        b[i] = static_cast<float>(i % 7) - 3;
+    }
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = static_cast<float>(i % 11) / 4 - 1;
+        c[i] = static_cast<float>(i % 5) - 2;
+        float product = (a[i] + b[i % shape[1]]) * a[i];
+        expected[i] = product > c[i] ? product : -product;
+    }
+    auto ta = backend->create_tensor(element::f32, shape);
+    auto tb = backend->create_tensor(element::f32, Shape{shape[1]});
+    auto tc = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    copy_data(ta, a);
+    copy_data(tb, b);
+    copy_data(tc, c);
+
+    auto handle = backend->compile(f, true);
+    handle->call_with_validate({result}, {ta, tb, tc});
+    EXPECT_TRUE(test::all_close_f(read_vector<float>(result), expected));
+
+    size_t kernel_count = 0;
+    for (const runtime::PerformanceCounter& counter : handle->get_performance_data())
+    {
+        kernel_count += counter.get_node()->description() == "CompiledKernel" ? 1 : 0;
+    }
+    EXPECT_EQ(kernel_count, 2);
+}
+
+TEST(elementwise_fusion, save_load)
+{
+    Shape shape{2, 3};
+    auto f = make_broadcast_chain(shape);
+    auto backend = runtime::Backend::create("INTERPRETER");
+
+    auto ta = backend->create_tensor(element::f32, shape);
+    auto tb = backend->create_tensor(element::f32, Shape{shape[1]});
+    auto tc = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    copy_data<float>(ta, {1, 2, 3, 4, 5, 6});
+    copy_data<float>(tb, {-1, 0, 1});
+    copy_data<float>(tc, {0, 100, 0, 100, 0, 100});
+
+    stringstream file;
+    {
+        auto handle = backend->compile(f);
+        handle->save(file);
+    }
+    auto handle = backend->load(file);
+    ASSERT_NE(handle, nullptr);
+    handle->call_with_validate({result}, {ta, tb, tc});
+    EXPECT_TRUE(test::all_close_f(read_vector<float>(result), {0, -4, 12, -12, 25, -42}));
+}
+#endif
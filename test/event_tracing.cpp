@@ -14,9 +14,11 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <mutex>
+#include <set>
 #include <stdlib.h>
 #include <vector>
 #include "nlohmann/json.hpp"
@@ -24,6 +26,7 @@
 #include "gtest/gtest.h"
 #include "ngraph/event_tracing.hpp"
 #include "ngraph/file_util.hpp"
+#include "ngraph/runtime/chrome_trace.hpp"
 
 using namespace std;
 
@@ -111,3 +114,85 @@ TEST(event_tracing, event_writer_callback)
         EXPECT_EQ(expected_event_key->second->get_stop(), next_event.get_stop());
     }
 }
+
+TEST(event_tracing, recorder_ring_buffer)
+{
+    using ngraph::runtime::event::Recorder;
+    Recorder::enable(4);
+    uint32_t id = Recorder::register_name("op", "test");
+    EXPECT_EQ(Recorder::register_name("op", "test"), id);
+
+    auto record = [id]() {
+        for (int i = 0; i < 10; i++)
+        {
+            Recorder::Scope scope(id);
+        }
+    };
+    // Both threads stay alive until both have recorded, so they do not share a buffer
+    atomic<int> finished{0};
+    auto worker = [&]() {
+        record();
+        finished++;
+        while (finished < 2)
+        {
+            this_thread::yield();
+        }
+    };
+    thread first(worker);
+    thread second(worker);
+    first.join();
+    second.join();
+    Recorder::disable();
+    // Not recorded while disabled
+    record();
+
+    stringstream trace;
+    Recorder::dump(trace);
+    nlohmann::json events = nlohmann::json::parse(trace.str());
+    size_t durations = 0;
+    set<size_t> threads;
+    for (const nlohmann::json& event : events)
+    {
+        if (event["ph"] == "X")
+        {
+            durations++;
+            threads.insert(event["tid"].get<size_t>());
+            EXPECT_EQ(event["name"], "op");
+            EXPECT_EQ(event["cat"], "test");
+            EXPECT_GE(event["dur"].get<double>(), 0);
+        }
+    }
+    // At least the last 4 events of each thread are kept, but not all of them
+    EXPECT_GE(durations, 8);
+    EXPECT_LT(durations, 20);
+    EXPECT_EQ(threads.size(), 2);
+}
+
+TEST(event_tracing, recorder_name_registered_when_recorded)
+{
+    using ngraph::runtime::event::Recorder;
+    // Like an op of a function compiled before recording starts
+    Recorder::disable();
+    Recorder::Name name("compiled before enable", "test");
+    {
+        Recorder::Scope scope(name);
+    }
+
+    Recorder::enable(4);
+    {
+        Recorder::Scope scope(name);
+    }
+    stringstream trace;
+    Recorder::dump(trace);
+    Recorder::disable();
+    size_t durations = 0;
+    for (const nlohmann::json& event : nlohmann::json::parse(trace.str()))
+    {
+        if (event["ph"] == "X")
+        {
+            durations++;
+            EXPECT_EQ(event["name"], "compiled before enable");
+        }
+    }
+    EXPECT_EQ(durations, 1);
+}
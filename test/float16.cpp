@@ -15,13 +15,20 @@
 //*****************************************************************************
 
 #include <climits>
+#include <cmath>
 #include <random>
 
 #include "gtest/gtest.h"
 
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/convert_fp32_to_fp16.hpp"
+#include "ngraph/pass/manager.hpp"
 #include "ngraph/runtime/aligned_buffer.hpp"
+#include "ngraph/runtime/backend.hpp"
 #include "ngraph/type/float16.hpp"
+#include "util/all_close.hpp"
 #include "util/float_util.hpp"
+#include "util/test_tools.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -110,3 +117,161 @@ TEST(float16, values)
         EXPECT_EQ(intvals.at(i), fp16val.to_bits());
     }
 }
+
+TEST(float16, bulk_conversions)
+{
+    // Every value widens like the scalar conversion and narrows back to itself
+    vector<float16> values;
+    for (uint32_t bits = 0; bits <= 0xFFFF; ++bits)
+    {
+        values.push_back(float16::from_bits(static_cast<uint16_t>(bits)));
+    }
+    vector<float> widened(values.size());
+    float16::to_float(values.data(), widened.data(), values.size());
+    vector<float16> narrowed(values.size());
+    float16::from_float(widened.data(), narrowed.data(), values.size());
+    size_t mismatches = 0;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        float expected = static_cast<float>(values[i]);
+        if (std::isnan(expected))
+        {
+            mismatches += !std::isnan(widened[i]) || !std::isnan(float(narrowed[i]));
+        }
+        else
+        {
+            mismatches += widened[i] != expected || narrowed[i].to_bits() != values[i].to_bits();
+        }
+    }
+    EXPECT_EQ(mismatches, 0);
+
+    // Halfway cases round to even, in the vectorized loop and in the scalar one after it
+    vector<float> halfway{1.0f + 1.0f / 2048,
+                          1.0f + 3.0f / 2048,
+                          65519.0f,
+                          65520.0f,
+                          powf(2, -25),
+                          3 * powf(2, -25),
+                          -1.0f - 1.0f / 2048,
+                          1e-10f};
+    vector<uint16_t> expected{0x3C00, 0x3C02, 0x7BFF, 0x7C00, 0x0000, 0x0002, 0xBC00, 0x0000};
+    halfway.insert(halfway.end(), halfway.begin(), halfway.end());
+    halfway.push_back(halfway[0]);
+    vector<float16> rounded(halfway.size());
+    float16::from_float(halfway.data(), rounded.data(), halfway.size());
+    for (size_t i = 0; i < halfway.size(); ++i)
+    {
+        EXPECT_EQ(rounded[i].to_bits(), expected[i % expected.size()]) << halfway[i];
+    }
+}
+
+#ifdef NGRAPH_INTERPRETER_ENABLE
+TEST(float16, interpreter_accumulates_in_f32)
+{
+    // Adding ones in f16 stops at 2048, where the spacing of f16 becomes 2
+    Shape shape{4096};
+    auto A = make_shared<op::Parameter>(element::f16, shape);
+    auto B = make_shared<op::Parameter>(element::f16, shape);
+    auto sum = make_shared<op::Sum>(A, AxisSet{0});
+    auto dot = make_shared<op::Dot>(A, B);
+    auto f = make_shared<Function>(NodeVector{sum, dot}, ParameterVector{A, B});
+    auto backend = runtime::Backend::create("INTERPRETER");
+
+    auto a = backend->create_tensor(element::f16, shape);
+    auto b = backend->create_tensor(element::f16, shape);
+    copy_data(a, vector<float16>(shape_size(shape), 1));
+    copy_data(b, vector<float16>(shape_size(shape), 1));
+    auto sum_result = backend->create_tensor(element::f16, Shape{});
+    auto dot_result = backend->create_tensor(element::f16, Shape{});
+
+    auto handle = backend->compile(f);
+    handle->call_with_validate({sum_result, dot_result}, {a, b});
+    EXPECT_EQ(read_vector<float16>(sum_result), vector<float16>{4096});
+    EXPECT_EQ(read_vector<float16>(dot_result), vector<float16>{4096});
+}
+
+TEST(float16, interpreter_data_movement)
+{
+    Shape shape{2, 3};
+    auto A = make_shared<op::Parameter>(element::f16, shape);
+    auto B = make_shared<op::Parameter>(element::f16, shape);
+    auto concat = make_shared<op::Concat>(NodeVector{A, B}, 0);
+    auto slice = make_shared<op::Slice>(concat, Coordinate{1, 1}, Coordinate{3, 3});
+    auto reshape = make_shared<op::Reshape>(slice, AxisVector{1, 0}, Shape{2, 2});
+    auto reverse = make_shared<op::Reverse>(reshape, AxisSet{1});
+    auto greater = make_shared<op::Greater>(A, B);
+    auto f = make_shared<Function>(NodeVector{reverse, greater}, ParameterVector{A, B});
+    auto backend = runtime::Backend::create("INTERPRETER");
+
+    // NaN and signed zero have to come through the moves unchanged
+    vector<float16> a_data{1.5, -2, 0.25, 7, numeric_limits<float>::quiet_NaN(), -0.f};
+    vector<float16> b_data{-1, 3, 0.5, 6, 65504, -0.5};
+    auto a = backend->create_tensor(element::f16, shape);
+    auto b = backend->create_tensor(element::f16, shape);
+    copy_data(a, a_data);
+    copy_data(b, b_data);
+    auto moved = backend->create_tensor(element::f16, Shape{2, 2});
+    auto compared = backend->create_tensor(element::boolean, shape);
+
+    auto handle = backend->compile(f);
+    handle->call_with_validate({moved, compared}, {a, b});
+    vector<uint16_t> expected{b_data[1].to_bits(),
+                              a_data[4].to_bits(),
+                              b_data[2].to_bits(),
+                              a_data[5].to_bits()};
+    vector<uint16_t> actual;
+    for (float16 value : read_vector<float16>(moved))
+    {
+        actual.push_back(value.to_bits());
+    }
+    EXPECT_EQ(actual, expected);
+    EXPECT_EQ(read_vector<char>(compared), (vector<char>{1, 0, 0, 1, 0, 1}));
+}
+
+TEST(float16, interpreter_converted_function)
+{
+    Shape shape{4, 16};
+    auto make_function = [&]() {
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        vector<float> weights(16 * 8);
+        for (size_t i = 0; i < weights.size(); ++i)
+        {
+            weights[i] = static_cast<float>(i % 9) / 8 - 0.5f;
+        }
+        auto W = op::Constant::create(element::f32, Shape{16, 8}, weights);
+        auto bias = op::Constant::create(element::f32, Shape{4, 8}, vector<float>(32, 0.25f));
+        auto dot = make_shared<op::Dot>(A, W);
+        auto relu = make_shared<op::Relu>(make_shared<op::Add>(dot, bias));
+        return make_shared<Function>(make_shared<op::Tanh>(relu), ParameterVector{A});
+    };
+    vector<float> a_data(shape_size(shape));
+    for (size_t i = 0; i < a_data.size(); ++i)
+    {
+        a_data[i] = static_cast<float>(i % 13) / 6 - 1;
+    }
+    auto backend = runtime::Backend::create("INTERPRETER");
+
+    auto a = backend->create_tensor(element::f32, shape);
+    copy_data(a, a_data);
+    auto result = backend->create_tensor(element::f32, Shape{4, 8});
+    backend->compile(make_function())->call_with_validate({result}, {a});
+    vector<float> expected = read_vector<float>(result);
+
+    auto f16_function = make_function();
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConvertFP32ToFP16>();
+    pass_manager.run_passes(f16_function);
+    ASSERT_EQ(f16_function->get_output_element_type(0), element::f16);
+
+    auto a16 = backend->create_tensor(element::f16, shape);
+    copy_data(a16, vector<float16>(a_data.begin(), a_data.end()));
+    auto result16 = backend->create_tensor(element::f16, Shape{4, 8});
+    backend->compile(f16_function)->call_with_validate({result16}, {a16});
+    vector<float> actual;
+    for (float16 value : read_vector<float16>(result16))
+    {
+        actual.push_back(value);
+    }
+    EXPECT_TRUE(test::all_close(actual, expected, 1e-2f, 1e-2f));
+}
+#endif
@@ -295,6 +295,157 @@ TEST(pattern, graph_rewrite)
     }
 }
 
+TEST(pattern, graph_rewrite_dispatch_by_type)
+{
+    Shape shape{2};
+    auto a = make_shared<op::Parameter>(element::f32, shape);
+    auto abs = make_shared<op::Abs>(make_shared<op::Negative>(a));
+    auto f = make_shared<Function>(abs, ParameterVector{a});
+
+    vector<string> calls;
+    auto record = [&calls](pattern::Matcher& m) {
+        calls.push_back(m.get_name() + " " + m.get_match_root()->description());
+        return false;
+    };
+    pass::GraphRewrite rewrite;
+    auto x = make_shared<pattern::op::Label>(element::f32, shape);
+    rewrite.add_matcher(make_shared<pattern::Matcher>(make_shared<op::Abs>(x), "Abs"), record);
+    auto any = make_shared<pattern::op::Label>(element::f32, shape);
+    rewrite.add_matcher(make_shared<pattern::Matcher>(any, "Any"), record);
+    rewrite.run_on_function(f);
+
+    EXPECT_EQ(calls,
+              (vector<string>{
+                  "Any Parameter", "Any Negative", "Abs Abs", "Any Abs", "Any Result"}));
+}
+
+class NegationRewrite : public ngraph::pass::GraphRewrite
+{
+public:
+    NegationRewrite(bool fold_negations_first)
+        : GraphRewrite()
+    {
+        construct_expand_subtract();
+        if (fold_negations_first)
+        {
+            construct_fold_negations();
+        }
+    }
+
+    // a - b => a + -b, then requests another pass that folds the double negations it creates
+    void construct_expand_subtract()
+    {
+        auto a = make_shared<pattern::op::Label>(element::i32, Shape{});
+        auto b = make_shared<pattern::op::Label>(element::i32, Shape{});
+        auto callback = [this, a, b](pattern::Matcher& m) {
+            auto pattern_map = m.get_pattern_map();
+            auto negative = make_shared<op::Negative>(pattern_map[b]);
+            replace_node(m.get_match_root(), make_shared<op::Add>(pattern_map[a], negative));
+            construct_fold_negations();
+            return true;
+        };
+        auto m = make_shared<pattern::Matcher>(make_shared<op::Subtract>(a, b), "ExpandSubtract");
+        this->add_matcher(m, callback);
+    }
+
+    // --a => a
+    void construct_fold_negations()
+    {
+        auto a = make_shared<pattern::op::Label>(element::i32, Shape{});
+        auto callback = [a](pattern::Matcher& m) {
+            replace_node(m.get_match_root(), m.get_pattern_map()[a]);
+            return true;
+        };
+        auto m = make_shared<pattern::Matcher>(
+            make_shared<op::Negative>(make_shared<op::Negative>(a)), "FoldNegations");
+        this->add_matcher(m, callback);
+    }
+};
+
+TEST(pattern, graph_rewrite_another_pass)
+{
+    // The matcher registered by the callback runs on the nodes created by the rewrite, and on
+    // the rest of the graph unless it already did so.
+    for (bool fold_negations_first : {false, true})
+    {
+        Shape shape{};
+        auto a = make_shared<op::Parameter>(element::i32, shape);
+        auto b = make_shared<op::Parameter>(element::i32, shape);
+        auto c = make_shared<op::Parameter>(element::i32, shape);
+        auto sub = make_shared<op::Subtract>(a, make_shared<op::Negative>(b));
+        auto neg = make_shared<op::Negative>(make_shared<op::Negative>(c));
+        auto f = make_shared<Function>(NodeVector{sub, neg}, ParameterVector{a, b, c});
+
+        pass::Manager pass_manager;
+        pass_manager.register_pass<NegationRewrite>(fold_negations_first);
+        pass_manager.run_passes(f);
+
+        EXPECT_EQ(count_ops_of_type<op::Negative>(f), 0);
+        auto add = as_type_ptr<op::Add>(f->get_results().at(0)->get_argument(0));
+        ASSERT_TRUE(add);
+        EXPECT_EQ(add->get_argument(0), a);
+        EXPECT_EQ(add->get_argument(1), b);
+        EXPECT_EQ(f->get_results().at(1)->get_argument(0), c);
+    }
+}
+
+// Requests another pass with its own matchers, whose patterns reach two uses downstream
+class ResignRewrite : public ngraph::pass::GraphRewrite
+{
+public:
+    ResignRewrite()
+        : GraphRewrite()
+    {
+        auto x = make_shared<pattern::op::Label>(element::f32, Shape{});
+        auto y = make_shared<pattern::op::Label>(element::f32, Shape{});
+        m_sign = make_shared<pattern::Matcher>(make_shared<op::Sign>(x), "Sign");
+        m_abs = make_shared<pattern::Matcher>(
+            make_shared<op::Abs>(make_shared<op::Negative>(make_shared<op::Negative>(y))),
+            "AbsOfDoubleNegation");
+        // The first match replaces the Sign with a copy, the second one with a Negative.
+        m_sign_callback = [this, x](pattern::Matcher& m) {
+            auto arg = m.get_pattern_map()[x];
+            shared_ptr<Node> replacement = m_sign_count++ == 0
+                                               ? shared_ptr<Node>(make_shared<op::Sign>(arg))
+                                               : shared_ptr<Node>(make_shared<op::Negative>(arg));
+            replace_node(m.get_match_root(), replacement);
+            add_matcher(m_sign, m_sign_callback);
+            add_matcher(m_abs, m_abs_callback);
+            return true;
+        };
+        m_abs_callback = [y](pattern::Matcher& m) {
+            replace_node(m.get_match_root(), make_shared<op::Relu>(m.get_pattern_map()[y]));
+            return true;
+        };
+        add_matcher(m_sign, m_sign_callback);
+        add_matcher(m_abs, m_abs_callback);
+    }
+
+private:
+    shared_ptr<pattern::Matcher> m_sign;
+    shared_ptr<pattern::Matcher> m_abs;
+    graph_rewrite_callback m_sign_callback;
+    graph_rewrite_callback m_abs_callback;
+    size_t m_sign_count = 0;
+};
+
+TEST(pattern, graph_rewrite_revisits_pattern_depth)
+{
+    // The third pass only revisits nodes near the second pass's rewrite, which include the Abs
+    // two uses downstream of it.
+    auto a = make_shared<op::Parameter>(element::f32, Shape{});
+    auto abs = make_shared<op::Abs>(make_shared<op::Negative>(make_shared<op::Sign>(a)));
+    auto f = make_shared<Function>(abs, ParameterVector{a});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<ResignRewrite>();
+    pass_manager.run_passes(f);
+
+    auto relu = as_type_ptr<op::Relu>(f->get_results().at(0)->get_argument(0));
+    ASSERT_TRUE(relu);
+    EXPECT_EQ(relu->get_argument(0), a);
+}
+
 TEST(pattern, matcher)
 {
     Shape shape{};
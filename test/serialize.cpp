@@ -194,6 +194,51 @@ TEST(serialize, constant)
     EXPECT_TRUE(found);
 }
 
+TEST(serialize, binary_constant)
+{
+    const string tmp_file = "serialize_binary_constant.ngb";
+    auto A = make_shared<op::Parameter>(element::f32, Shape{2, 3});
+    auto B = op::Constant::create(element::f32, Shape{2, 3}, {1, 2, 3, 4, 5, 6});
+    auto C = op::Constant::create(element::i64, Shape{3}, {7, 8, 9});
+    auto f = make_shared<Function>(NodeVector{make_shared<op::Add>(A, B), C}, ParameterVector{A});
+
+    serialize_binary(tmp_file, f);
+    for (auto g : {deserialize_binary(tmp_file), deserialize(tmp_file)})
+    {
+        ASSERT_NE(g, nullptr);
+        size_t found = 0;
+        for (shared_ptr<Node> node : g->get_ops())
+        {
+            auto c = as_type_ptr<op::Constant>(node);
+            if (!c)
+            {
+                continue;
+            }
+            found++;
+            // Constant data is used in place and keeps the 64-byte alignment of the file.
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(c->get_data_ptr()) % 64, 0);
+            if (c->get_element_type() == element::f32)
+            {
+                EXPECT_EQ((vector<float>{1, 2, 3, 4, 5, 6}), c->get_vector<float>());
+            }
+            else
+            {
+                EXPECT_EQ((vector<int64_t>{7, 8, 9}), c->get_vector<int64_t>());
+            }
+        }
+        EXPECT_EQ(found, 2);
+        EXPECT_EQ(g->get_results().size(), 2);
+        EXPECT_EQ(g->get_parameters().size(), 1);
+    }
+
+    ifstream in(tmp_file, ios::binary);
+    auto h = deserialize(in);
+    ASSERT_NE(h, nullptr);
+    EXPECT_EQ(count_ops_of_type<op::Constant>(h), 2);
+    in.close();
+    file_util::remove_file(tmp_file);
+}
+
 TEST(benchmark, serialize)
 {
     stopwatch timer;
@@ -0,0 +1,241 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <memory>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/lstm_sequence_to_tensor_iterator.hpp"
+#include "ngraph/pass/manager.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "util/all_close_f.hpp"
+#include "util/test_tools.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+// Running sum over the slices of X along `axis`, returning every partial sum and the total
+static shared_ptr<Function> make_cumulative_sum(const Shape& shape,
+                                                int64_t axis,
+                                                int64_t start,
+                                                int64_t stride,
+                                                int64_t end)
+{
+    auto X = make_shared<op::Parameter>(element::f32, shape);
+    auto S = make_shared<op::Parameter>(element::f32, Shape{});
+
+    Shape part_shape = shape;
+    part_shape[axis] = 1;
+    auto X_i = make_shared<op::Parameter>(element::f32, part_shape);
+    auto S_i = make_shared<op::Parameter>(element::f32, part_shape);
+    auto S_o = make_shared<op::Add>(X_i, S_i);
+    auto body = make_shared<op::TensorIterator::BodyLambda>(OutputVector{S_o},
+                                                            ParameterVector{X_i, S_i});
+
+    auto tensor_iterator = make_shared<op::TensorIterator>();
+    tensor_iterator->set_body(body);
+    tensor_iterator->set_sliced_input(X_i, X, start, stride, 1, end, axis);
+    tensor_iterator->set_merged_input(
+        S_i, make_shared<op::Broadcast>(S, part_shape, AxisSet{0, 1, 2}), S_o);
+    auto sums = tensor_iterator->get_concatenated_slices(S_o, start, stride, 1, end, axis);
+    auto total = tensor_iterator->get_iter_value(S_o, -1);
+    return make_shared<Function>(OutputVector{sums, total}, ParameterVector{X, S});
+}
+
+TEST(tensor_iterator, cumulative_sum_inner_axis)
+{
+    Shape shape{2, 3, 2};
+    auto f = make_cumulative_sum(shape, 1, 0, 1, -1);
+    auto backend = runtime::Backend::create("INTERPRETER");
+
+    auto x = backend->create_tensor(element::f32, shape);
+    auto s = backend->create_tensor(element::f32, Shape{});
+    copy_data(x, vector<float>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+    copy_data(s, vector<float>{100});
+    auto sums = backend->create_tensor(element::f32, shape);
+    auto total = backend->create_tensor(element::f32, Shape{2, 1, 2});
+
+    auto handle = backend->compile(f);
+    handle->call_with_validate({sums, total}, {x, s});
+    EXPECT_TRUE(test::all_close_f(
+        read_vector<float>(sums),
+        vector<float>{101, 102, 104, 106, 109, 112, 107, 108, 116, 118, 127, 130}));
+    EXPECT_TRUE(test::all_close_f(read_vector<float>(total), vector<float>{109, 112, 127, 130}));
+}
+
+TEST(tensor_iterator, cumulative_sum_reverse)
+{
+    // A negative stride walks the outermost axis backwards, the slices are views of X
+    Shape shape{3, 1, 2};
+    auto f = make_cumulative_sum(shape, 0, -1, -1, 0);
+    auto backend = runtime::Backend::create("INTERPRETER");
+
+    auto x = backend->create_tensor(element::f32, shape);
+    auto s = backend->create_tensor(element::f32, Shape{});
+    copy_data(x, vector<float>{1, 2, 3, 4, 5, 6});
+    copy_data(s, vector<float>{0});
+    auto sums = backend->create_tensor(element::f32, shape);
+    auto total = backend->create_tensor(element::f32, Shape{1, 1, 2});
+
+    auto handle = backend->compile(f);
+    for (size_t i = 0; i < 2; ++i)
+    {
+        handle->call_with_validate({sums, total}, {x, s});
+        EXPECT_TRUE(
+            test::all_close_f(read_vector<float>(sums), vector<float>{9, 12, 8, 10, 5, 6}));
+        EXPECT_TRUE(test::all_close_f(read_vector<float>(total), vector<float>{9, 12}));
+    }
+}
+
+#ifdef NGRAPH_GENERIC_CPU_ENABLE
+TEST(tensor_iterator, cumulative_sum_gcpu)
+{
+    // GCPU compiles the body into its own executable, so it runs on the GCPU kernels
+    Shape shape{2, 3, 2};
+    auto f = make_cumulative_sum(shape, 1, 0, 1, -1);
+    auto backend = runtime::Backend::create("GCPU");
+
+    auto x = backend->create_tensor(element::f32, shape);
+    auto s = backend->create_tensor(element::f32, Shape{});
+    copy_data(x, vector<float>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+    copy_data(s, vector<float>{100});
+    auto sums = backend->create_tensor(element::f32, shape);
+    auto total = backend->create_tensor(element::f32, Shape{2, 1, 2});
+
+    auto handle = backend->compile(f);
+    for (size_t i = 0; i < 2; ++i)
+    {
+        handle->call_with_validate({sums, total}, {x, s});
+        EXPECT_TRUE(test::all_close_f(
+            read_vector<float>(sums),
+            vector<float>{101, 102, 104, 106, 109, 112, 107, 108, 116, 118, 127, 130}));
+        EXPECT_TRUE(
+            test::all_close_f(read_vector<float>(total), vector<float>{109, 112, 127, 130}));
+    }
+}
+#endif
+
+static shared_ptr<op::LSTMSequence> make_lstm_sequence(op::LSTMSequence::direction direction,
+                                                       ParameterVector& parameters)
+{
+    const size_t seq_length = 4;
+    const size_t batch_size = 3;
+    const size_t input_size = 2;
+    const size_t hidden_size = 3;
+    const size_t num_directions = direction == op::LSTMSequence::direction::BIDIRECTIONAL ? 2 : 1;
+
+    auto X = make_shared<op::Parameter>(element::f32, Shape{seq_length, batch_size, input_size});
+    auto H = make_shared<op::Parameter>(element::f32,
+                                        Shape{num_directions, batch_size, hidden_size});
+    auto C = make_shared<op::Parameter>(element::f32,
+                                        Shape{num_directions, batch_size, hidden_size});
+    auto lengths = make_shared<op::Parameter>(element::i32, Shape{batch_size});
+    auto W = make_shared<op::Parameter>(element::f32,
+                                        Shape{num_directions, 4 * hidden_size, input_size});
+    auto R = make_shared<op::Parameter>(element::f32,
+                                        Shape{num_directions, 4 * hidden_size, hidden_size});
+    auto B = make_shared<op::Parameter>(element::f32, Shape{num_directions, 4 * hidden_size});
+    auto P = make_shared<op::Parameter>(element::f32, Shape{num_directions, 3 * hidden_size});
+    parameters = ParameterVector{X, H, C, lengths, W, R, B, P};
+    return make_shared<op::LSTMSequence>(X, H, C, lengths, W, R, B, P, hidden_size, direction);
+}
+
+static void check_lstm_sequence(op::LSTMSequence::direction direction)
+{
+    ParameterVector parameters;
+    auto sequence = make_lstm_sequence(direction, parameters);
+    auto f = make_shared<Function>(sequence->outputs(), parameters);
+    // The unrolled decomposition that other backends run
+    auto unrolled = sequence->decompose_op();
+    auto f_unrolled =
+        make_shared<Function>(OutputVector{unrolled.at(0), unrolled.at(1), unrolled.at(2)},
+                              parameters);
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    vector<shared_ptr<runtime::Tensor>> args;
+    mt19937 engine(0);
+    uniform_real_distribution<float> distribution(-1.f, 1.f);
+    for (auto& parameter : parameters)
+    {
+        auto tensor = backend->create_tensor(parameter->get_element_type(), parameter->get_shape());
+        size_t size = shape_size(parameter->get_shape());
+        if (parameter->get_element_type() == element::i32)
+        {
+            // Sequences of different lengths, including an empty one
+            copy_data(tensor, vector<int32_t>{4, 2, 0});
+        }
+        else
+        {
+            vector<float> values(size);
+            for (float& value : values)
+            {
+                value = distribution(engine);
+            }
+            copy_data(tensor, values);
+        }
+        args.push_back(tensor);
+    }
+
+    vector<shared_ptr<runtime::Tensor>> results;
+    vector<shared_ptr<runtime::Tensor>> expected;
+    for (size_t i = 0; i < f->get_output_size(); ++i)
+    {
+        results.push_back(
+            backend->create_tensor(f->get_output_element_type(i), f->get_output_shape(i)));
+        expected.push_back(
+            backend->create_tensor(f->get_output_element_type(i), f->get_output_shape(i)));
+    }
+    backend->compile(f)->call_with_validate(results, args);
+    backend->compile(f_unrolled)->call_with_validate(expected, args);
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        EXPECT_TRUE(
+            test::all_close_f(read_vector<float>(expected[i]), read_vector<float>(results[i])))
+            << "output " << i;
+    }
+}
+
+TEST(tensor_iterator, lstm_sequence_pass)
+{
+    ParameterVector parameters;
+    auto sequence = make_lstm_sequence(op::LSTMSequence::direction::BIDIRECTIONAL, parameters);
+    auto f = make_shared<Function>(sequence->outputs(), parameters);
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::LSTMSequenceToTensorIterator>();
+    pass_manager.run_passes(f);
+
+    EXPECT_EQ(count_ops_of_type<op::LSTMSequence>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::TensorIterator>(f), 2);
+    EXPECT_EQ(count_ops_of_type<op::LSTMCell>(f), 0);
+}
+
+TEST(tensor_iterator, lstm_sequence_forward)
+{
+    check_lstm_sequence(op::LSTMSequence::direction::FORWARD);
+}
+
+TEST(tensor_iterator, lstm_sequence_reverse)
+{
+    check_lstm_sequence(op::LSTMSequence::direction::REVERSE);
+}
+
+TEST(tensor_iterator, lstm_sequence_bidirectional)
+{
+    check_lstm_sequence(op::LSTMSequence::direction::BIDIRECTIONAL);
+}
@@ -712,3 +712,46 @@ TEST(util, topological_sort_replace)
 
     EXPECT_TRUE(custom_sorter_used);
 }
+
+TEST(util, topological_sort_cached)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = make_shared<op::Parameter>(element::f32, shape);
+    auto sum = A + B;
+    auto f = make_shared<Function>(sum, ParameterVector{A, B, C});
+    size_t sort_count = 0;
+    f->set_topological_sort([&sort_count](const std::vector<std::shared_ptr<Node>>& root_nodes,
+                                          bool include_control_deps) {
+        sort_count++;
+        return topological_sort(root_nodes, include_control_deps);
+    });
+
+    auto ops = f->get_ordered_ops();
+    size_t version = f->get_graph_version();
+    EXPECT_EQ(f->get_ordered_ops(), ops);
+    EXPECT_EQ(f->get_graph_version(), version);
+    EXPECT_EQ(sort_count, 1);
+
+    // Building nodes, even on outputs of the function, leaves its order alone
+    make_shared<op::Subtract>(A, B);
+    EXPECT_EQ(f->get_graph_version(), version);
+    f->get_ordered_ops();
+    EXPECT_EQ(sort_count, 1);
+
+    auto product = make_shared<op::Multiply>(A, C);
+    replace_node(sum, product);
+    EXPECT_NE(f->get_graph_version(), version);
+    ops = f->get_ordered_ops();
+    EXPECT_EQ(sort_count, 2);
+    EXPECT_EQ(ops.size(), 5);
+    EXPECT_EQ(find(ops.begin(), ops.end(), sum), ops.end());
+    EXPECT_NE(find(ops.begin(), ops.end(), product), ops.end());
+
+    version = f->get_graph_version();
+    C->add_control_dependency(A);
+    EXPECT_NE(f->get_graph_version(), version);
+    f->get_ordered_ops();
+    EXPECT_EQ(sort_count, 3);
+}